@@ -0,0 +1,41 @@
+'use strict';
+
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  n: [3],
+  files: [500],
+  size: [4 * 1024, 64 * 1024],
+  concurrency: [1, 4, 16],
+  preserveTimestamps: ['true', 'false'],
+});
+
+async function main({ n, files, size, concurrency, preserveTimestamps }) {
+  tmpdir.refresh();
+  const src = path.join(tmpdir.path, 'src');
+  const data = Buffer.alloc(size, 'x');
+  // Spread the files over a few directories, as in a typical source tree.
+  for (let i = 0; i < files; i++) {
+    const dir = path.join(src, `dir-${i % 10}`);
+    if (i < 10)
+      fs.mkdirSync(dir, { recursive: true });
+    fs.writeFileSync(path.join(dir, `file-${i}`), data);
+  }
+
+  const options = {
+    recursive: true,
+    preserveTimestamps: preserveTimestamps === 'true',
+    concurrency,
+  };
+  // Throughput is reported in MiB copied per second.
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    const dest = path.join(tmpdir.path, `dest-${i}`);
+    await fs.promises.cp(src, dest, options);
+  }
+  bench.end(n * files * size / (1024 * 1024));
+  tmpdir.refresh();
+}
@@ -7,7 +7,7 @@ const path = require('path');
 const bench = common.createBenchmark(main, {
   n: [100],
   dir: [ 'lib', 'test/parallel'],
-  mode: [ 'async', 'sync', 'callback' ],
+  mode: [ 'async', 'sync', 'callback', 'packed' ],
   bufferSize: [ 4, 32, 1024 ]
 });
 
@@ -41,6 +41,12 @@ async function main({ n, dir, mode, bufferSize }) {
 
         read();
       });
+    } else if (mode === 'packed') {
+      const dir = await fs.promises.opendir(fullPath, { bufferSize });
+      let entries;
+      while ((entries = await dir.readPacked()) !== null)
+        counter += entries.types.length;
+      await dir.close();
     } else {
       const dir = fs.opendirSync(fullPath, { bufferSize });
       while (dir.readSync() !== null)
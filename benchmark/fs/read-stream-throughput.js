@@ -15,11 +15,12 @@ const bench = common.createBenchmark(main, {
   encodingType: ['buf', 'asc', 'utf'],
   filesize: [1000 * 1024],
   highWaterMark: [1024, 4096, 65535, 1024 * 1024],
+  readAhead: [0, 4],
   n: 1024
 });
 
 function main(conf) {
-  const { encodingType, highWaterMark, filesize } = conf;
+  const { encodingType, highWaterMark, readAhead, filesize } = conf;
   let { n } = conf;
 
   let encoding = '';
@@ -56,7 +57,8 @@ function main(conf) {
     // Continue regardless of error.
   }
   const ws = fs.createWriteStream(filename);
-  ws.on('close', runTest.bind(null, filesize, highWaterMark, encoding, n));
+  ws.on('close',
+        runTest.bind(null, filesize, highWaterMark, readAhead, encoding, n));
   ws.on('drain', write);
   write();
   function write() {
@@ -68,10 +70,11 @@ function main(conf) {
   }
 }
 
-function runTest(filesize, highWaterMark, encoding, n) {
+function runTest(filesize, highWaterMark, readAhead, encoding, n) {
   assert(fs.statSync(filename).size === filesize * n);
   const rs = fs.createReadStream(filename, {
     highWaterMark,
+    readAhead,
     encoding
   });
 
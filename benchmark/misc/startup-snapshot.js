@@ -0,0 +1,68 @@
+'use strict';
+
+// Measures the startup time and the memory footprint of processes that are
+// started from a user-land snapshot built with --build-snapshot. `size` is
+// the number of megabytes of data that the snapshot keeps in the heap.
+
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  n: [30],
+  size: [0, 32],
+  metric: ['time', 'rss'],
+});
+
+function buildSnapshot(size) {
+  tmpdir.refresh();
+  const entry = path.join(tmpdir.path, 'entry.js');
+  const blob = path.join(tmpdir.path, 'snapshot.blob');
+  fs.writeFileSync(entry, `
+    const { setDeserializeMainFunction } = require('v8').startupSnapshot;
+    const data = globalThis.snapshotData = [];
+    for (let i = 0; i < ${size}; i++) {
+      data.push(new Array(1024 * 1024 / 8).fill(i + 0.5));
+    }
+    setDeserializeMainFunction(() => {
+      process.stdout.write(String(process.memoryUsage.rss()));
+    });
+  `);
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', blob, '--build-snapshot', entry,
+  ], { cwd: tmpdir.path });
+  if (child.status !== 0) {
+    throw new Error(`Failed to build the snapshot: ${child.stderr}`);
+  }
+  return blob;
+}
+
+function run(blob) {
+  const child = spawnSync(process.execPath, ['--snapshot-blob', blob]);
+  if (child.status !== 0) {
+    throw new Error(`Failed to start from the snapshot: ${child.stderr}`);
+  }
+  return Number(child.stdout);
+}
+
+function main({ n, size, metric }) {
+  const blob = buildSnapshot(size);
+
+  if (metric === 'time') {
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      run(blob);
+    }
+    bench.end(n);
+    return;
+  }
+
+  let rss = 0;
+  for (let i = 0; i < n; i++) {
+    rss += run(blob);
+  }
+  // The rate column reports the average RSS in megabytes.
+  bench.report(rss / n / (1024 * 1024), 0n);
+}
@@ -0,0 +1,38 @@
+'use strict';
+
+// Measures how quickly short-lived Workers can be started one after another,
+// with and without a WorkerIsolatePool.
+
+const common = require('../common.js');
+const { Worker, WorkerIsolatePool } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  pool: ['true', 'false'],
+  n: [50],
+});
+
+const source = 'require("worker_threads").parentPort.postMessage(0)';
+
+function main({ n, pool }) {
+  const workerPool = pool === 'true' ? new WorkerIsolatePool(2) : undefined;
+  let started = 0;
+
+  function startWorker() {
+    const worker = new Worker(source, { eval: true, pool: workerPool });
+    worker.once('message', () => worker.terminate());
+    worker.once('exit', () => {
+      if (++started < n) {
+        startWorker();
+      } else {
+        bench.end(n);
+        workerPool?.close();
+      }
+    });
+  }
+
+  // Give the pool some time to create its isolates.
+  setTimeout(() => {
+    bench.start();
+    startWorker();
+  }, 500);
+}
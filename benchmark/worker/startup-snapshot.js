@@ -0,0 +1,73 @@
+'use strict';
+
+// Measures how quickly short-lived Workers can be started one after another
+// by an application that was started from a user-land snapshot, compared to
+// the same application started from a script.
+
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  snapshot: ['true', 'false'],
+  n: [50],
+});
+
+function writeEntry(n) {
+  tmpdir.refresh();
+  const entry = path.join(tmpdir.path, 'entry.js');
+  fs.writeFileSync(entry, `
+    const { Worker } = require('worker_threads');
+    const { startupSnapshot } = require('v8');
+
+    function run() {
+      const source = 'require("worker_threads").parentPort.postMessage(0)';
+      const start = process.hrtime.bigint();
+      let started = 0;
+      function startWorker() {
+        const worker = new Worker(source, { eval: true });
+        worker.once('message', () => worker.terminate());
+        worker.once('exit', () => {
+          if (++started < ${n}) {
+            startWorker();
+          } else {
+            process.stdout.write(String(process.hrtime.bigint() - start));
+          }
+        });
+      }
+      startWorker();
+    }
+
+    if (startupSnapshot.isBuildingSnapshot()) {
+      startupSnapshot.setDeserializeMainFunction(run);
+    } else {
+      run();
+    }
+  `);
+  return entry;
+}
+
+function spawn(args) {
+  const child = spawnSync(process.execPath, args, { cwd: tmpdir.path });
+  if (child.status !== 0) {
+    throw new Error(`Failed to run ${args.join(' ')}: ${child.stderr}`);
+  }
+  return child.stdout.toString();
+}
+
+function main({ n, snapshot }) {
+  const entry = writeEntry(n);
+  let elapsed;
+  if (snapshot === 'true') {
+    const blob = path.join(tmpdir.path, 'snapshot.blob');
+    spawn(['--snapshot-blob', blob, '--build-snapshot', entry]);
+    elapsed = BigInt(spawn(['--snapshot-blob', blob]));
+  } else {
+    elapsed = BigInt(spawn([entry]));
+  }
+  // Only the time spent starting the Workers is reported, not the startup of
+  // the process itself.
+  bench.report(n / (Number(elapsed) / 1e9), elapsed);
+}
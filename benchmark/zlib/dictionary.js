@@ -0,0 +1,44 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  dictionary: ['none', 'buffer', 'shared'],
+  method: ['deflate', 'deflateRaw'],
+  n: [5e4]
+});
+
+// Small, repetitive JSON documents, like typical API responses.
+function makeDocument(i) {
+  return JSON.stringify({
+    id: i,
+    type: 'user',
+    attributes: {
+      name: `user ${i}`,
+      email: `user${i}@example.com`,
+      created_at: new Date(i * 1e9).toISOString(),
+      roles: ['reader', i % 3 ? 'writer' : 'admin'],
+      active: i % 2 === 0,
+    },
+    links: { self: `https://example.com/api/users/${i}` },
+  });
+}
+
+function main({ n, dictionary, method }) {
+  const inputs = [];
+  for (let i = 0; i < 100; i++)
+    inputs.push(Buffer.from(makeDocument(i)));
+  const dictionaryData = Buffer.from(makeDocument(1000));
+
+  const opts = {};
+  if (dictionary === 'buffer')
+    opts.dictionary = dictionaryData;
+  else if (dictionary === 'shared')
+    opts.dictionary = zlib.createDictionary(dictionaryData);
+
+  const fn = zlib[`${method}Sync`];
+  bench.start();
+  for (let i = 0; i < n; ++i)
+    fn(inputs[i % inputs.length], opts);
+  bench.end(n);
+}
@@ -36,9 +36,11 @@
 
 #include <net/if.h>
 #include <sys/epoll.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/prctl.h>
 #include <sys/sysinfo.h>
+#include <sys/utsname.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <time.h>
@@ -82,8 +84,116 @@ static int read_times(FILE* statfile_fp,
 static void read_speeds(unsigned int numcpus, uv_cpu_info_t* ci);
 static uint64_t read_cpufreq(unsigned int cpunum);
 
+#define UV__IORING_SETUP_CQSIZE 8u
+
+#define UV__IORING_FEAT_SINGLE_MMAP 1u
+#define UV__IORING_FEAT_NODROP 2u
+
+#define UV__IORING_FSYNC_DATASYNC 1u
+
+#define UV__IORING_OFF_SQ_RING 0x00000000ull
+#define UV__IORING_OFF_SQES 0x10000000ull
+
+#define UV__AT_EMPTY_PATH 0x1000
+
+enum {
+  UV__IORING_OP_READV = 1,
+  UV__IORING_OP_WRITEV = 2,
+  UV__IORING_OP_FSYNC = 3,
+  UV__IORING_OP_OPENAT = 18,
+  UV__IORING_OP_CLOSE = 19,
+  UV__IORING_OP_STATX = 21,
+  UV__IORING_OP_READ = 22,
+  UV__IORING_OP_WRITE = 23
+};
+
+/* Subset of the kernel's struct io_uring_sqe. The unions of the kernel
+ * definition are flattened into the member that libuv uses.
+ */
+struct uv__io_uring_sqe {
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t ioprio;
+  int32_t fd;
+  uint64_t off;        /* also addr2 */
+  uint64_t addr;
+  uint32_t len;
+  uint32_t op_flags;   /* rw_flags, fsync_flags, open_flags, statx_flags */
+  uint64_t user_data;
+  uint64_t pad[3];
+};
+
+STATIC_ASSERT(64 == sizeof(struct uv__io_uring_sqe));
+STATIC_ASSERT(0 == offsetof(struct uv__io_uring_sqe, opcode));
+STATIC_ASSERT(4 == offsetof(struct uv__io_uring_sqe, fd));
+STATIC_ASSERT(8 == offsetof(struct uv__io_uring_sqe, off));
+STATIC_ASSERT(16 == offsetof(struct uv__io_uring_sqe, addr));
+STATIC_ASSERT(24 == offsetof(struct uv__io_uring_sqe, len));
+STATIC_ASSERT(28 == offsetof(struct uv__io_uring_sqe, op_flags));
+STATIC_ASSERT(32 == offsetof(struct uv__io_uring_sqe, user_data));
+
+struct uv__io_uring_cqe {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+STATIC_ASSERT(16 == sizeof(struct uv__io_uring_cqe));
+
+struct uv__io_sqring_offsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t reserved0;
+  uint64_t reserved1;
+};
+
+STATIC_ASSERT(40 == sizeof(struct uv__io_sqring_offsets));
+
+struct uv__io_cqring_offsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint64_t reserved0;
+  uint64_t reserved1;
+};
+
+STATIC_ASSERT(40 == sizeof(struct uv__io_cqring_offsets));
+
+struct uv__io_uring_params {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t features;
+  uint32_t reserved[4];
+  struct uv__io_sqring_offsets sq_off;
+  struct uv__io_cqring_offsets cq_off;
+};
+
+STATIC_ASSERT(40 + 40 + 40 == sizeof(struct uv__io_uring_params));
+
+static void uv__iou_io(uv_loop_t* loop, uv__io_t* w, unsigned int events);
+
+
 int uv__platform_loop_init(uv_loop_t* loop) {
-  
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+  iou->ringfd = -1;
+  iou->state = 0;
+  iou->in_flight = 0;
+  iou->use_close = 0;
+  QUEUE_INIT(&iou->write_queue);
+
   loop->inotify_fd = -1;
   loop->inotify_watchers = NULL;
 
@@ -109,7 +219,21 @@ int uv__io_fork(uv_loop_t* loop) {
 }
 
 
+static void uv__iou_delete(uv_loop_t* loop, struct uv__iou* iou) {
+  if (iou->ringfd == -1)
+    return;
+
+  uv__io_stop(loop, &iou->watcher, POLLIN);
+  munmap(iou->sq, iou->maxlen);
+  munmap(iou->sqe, iou->sqelen);
+  uv__close(iou->ringfd);
+  iou->ringfd = -1;
+}
+
+
 void uv__platform_loop_delete(uv_loop_t* loop) {
+  uv__iou_delete(loop, &uv__get_internal_fields(loop)->iou);
+
   if (loop->inotify_fd == -1) return;
   uv__io_stop(loop, &loop->inotify_read_watcher, POLLIN);
   uv__close(loop->inotify_fd);
@@ -117,6 +241,616 @@ void uv__platform_loop_delete(uv_loop_t* loop) {
 }
 
 
+static unsigned uv__kernel_version(void) {
+  struct utsname u;
+  unsigned major;
+  unsigned minor;
+  unsigned patch;
+
+  if (uname(&u))
+    return 0;
+
+  if (3 != sscanf(u.release, "%u.%u.%u", &major, &minor, &patch))
+    return 0;
+
+  if (patch > 255)
+    patch = 255;
+
+  return major * 65536 + minor * 256 + patch;
+}
+
+
+static int uv__use_io_uring(void) {
+  const char* val;
+
+#if defined(__ANDROID__)
+  /* Android's seccomp filter kills the process instead of failing the
+   * io_uring system calls with ENOSYS.
+   */
+  return 0;
+#endif
+
+  val = getenv("UV_USE_IO_URING");
+  if (val != NULL)
+    return atoi(val) != 0;
+
+  /* Every operation used below is available from 5.6 onwards but the 5.10
+   * stable branch is the oldest one with the io_uring fixes that make it
+   * dependable for file operations.
+   */
+  return uv__kernel_version() >= /* 5.10.186 */ 0x050ABA;
+}
+
+
+/* Closing a file through the ring makes a later execve() of that file fail
+ * with ETXTBSY on some kernels, apparently because the ring still holds a
+ * reference to it for a while. This was fixed somewhere between 5.15.85 and
+ * 5.15.90, and the non-longterm releases from 5.16 up to 6.1 are affected
+ * too.
+ */
+static int uv__iou_close_is_safe(void) {
+  unsigned kv;
+
+  kv = uv__kernel_version();
+  if (kv < /* 5.15.90 */ 0x050F5A)
+    return 0;
+
+  if (kv >= /* 5.16.0 */ 0x051000 && kv < /* 6.1.0 */ 0x060100)
+    return 0;
+
+  return 1;
+}
+
+
+/* Sets up the ring of the loop. On failure, file operations keep using the
+ * threadpool.
+ */
+static void uv__iou_init(struct uv__iou* iou) {
+  struct uv__io_uring_params params;
+  uint32_t sqlen;
+  uint32_t cqlen;
+  size_t maxlen;
+  size_t sqelen;
+  uint32_t i;
+  char* sq;
+  char* sqe;
+  int ringfd;
+
+  iou->state = -1;
+  sq = MAP_FAILED;
+  sqe = MAP_FAILED;
+
+  if (!uv__use_io_uring())
+    return;
+
+  /* Twice as many completion entries as submission entries, the kernel's
+   * default, limits how many operations can be in flight at once.
+   */
+  memset(&params, 0, sizeof(params));
+  params.flags = UV__IORING_SETUP_CQSIZE;
+  params.cq_entries = 256;
+
+  ringfd = uv__io_uring_setup(64, &params);
+  if (ringfd == -1)
+    return;
+
+  /* IORING_FEAT_SINGLE_MMAP lets us map the submission and completion rings
+   * with a single mmap() call. IORING_FEAT_NODROP guarantees that completions
+   * are never dropped, even when the completion ring overflows.
+   */
+  if (!(params.features & UV__IORING_FEAT_SINGLE_MMAP))
+    goto fail;
+
+  if (!(params.features & UV__IORING_FEAT_NODROP))
+    goto fail;
+
+  sqlen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqlen =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct uv__io_uring_cqe);
+  maxlen = sqlen < cqlen ? cqlen : sqlen;
+  sqelen = params.sq_entries * sizeof(struct uv__io_uring_sqe);
+
+  sq = mmap(0,
+            maxlen,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            ringfd,
+            UV__IORING_OFF_SQ_RING);
+
+  sqe = mmap(0,
+             sqelen,
+             PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE,
+             ringfd,
+             UV__IORING_OFF_SQES);
+
+  if (sq == MAP_FAILED || sqe == MAP_FAILED)
+    goto fail;
+
+  if (uv__cloexec(ringfd, 1))
+    goto fail;
+
+  iou->sqhead = (uint32_t*) (sq + params.sq_off.head);
+  iou->sqtail = (uint32_t*) (sq + params.sq_off.tail);
+  iou->sqmask = *(uint32_t*) (sq + params.sq_off.ring_mask);
+  iou->sqarray = (uint32_t*) (sq + params.sq_off.array);
+  iou->cqhead = (uint32_t*) (sq + params.cq_off.head);
+  iou->cqtail = (uint32_t*) (sq + params.cq_off.tail);
+  iou->cqmask = *(uint32_t*) (sq + params.cq_off.ring_mask);
+  iou->cqentries = params.cq_entries;
+  iou->sq = sq;
+  iou->cqe = sq + params.cq_off.cqes;
+  iou->sqe = sqe;
+  iou->maxlen = maxlen;
+  iou->sqelen = sqelen;
+  iou->ringfd = ringfd;
+  iou->in_flight = 0;
+  iou->euid = geteuid();
+  iou->egid = getegid();
+  iou->use_close = uv__iou_close_is_safe();
+  iou->state = 1;
+
+  /* Submission entries are always used in ring order. */
+  for (i = 0; i <= iou->sqmask; i++)
+    iou->sqarray[i] = i;
+
+  uv__io_init(&iou->watcher, uv__iou_io, ringfd);
+  return;
+
+fail:
+  if (sq != MAP_FAILED)
+    munmap(sq, maxlen);
+
+  if (sqe != MAP_FAILED)
+    munmap(sqe, sqelen);
+
+  uv__close(ringfd);
+}
+
+
+/* Returns the next free submission entry, zeroed, or NULL when the
+ * submission ring is full.
+ */
+static struct uv__io_uring_sqe* uv__iou_next_sqe(struct uv__iou* iou,
+                                                 uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  uint32_t head;
+  uint32_t tail;
+
+  head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+  tail = *iou->sqtail;
+  if (tail - head > iou->sqmask)
+    return NULL;
+
+  sqe = iou->sqe;
+  sqe = &sqe[tail & iou->sqmask];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = (uintptr_t) req;
+
+  return sqe;
+}
+
+
+/* Returns a submission entry for |req|, or NULL when the operation should go
+ * to the threadpool instead.
+ */
+static struct uv__io_uring_sqe* uv__iou_get_sqe(struct uv__iou* iou,
+                                                uv_loop_t* loop,
+                                                uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+
+  if (iou->state == 0)
+    uv__iou_init(iou);
+
+  if (iou->state != 1)
+    return NULL;
+
+  /* Operations run with the credentials of the thread that set up the ring.
+   * Stop using it when the process changed its effective user or group, e.g.
+   * through setuid(), so that the change applies to later file operations.
+   * The ring itself is released when the loop is closed.
+   */
+  if (iou->euid != (unsigned long) geteuid() ||
+      iou->egid != (unsigned long) getegid()) {
+    iou->state = -1;
+    return NULL;
+  }
+
+  /* Never have more operations in flight than the completion ring holds. */
+  if (iou->in_flight >= iou->cqentries)
+    return NULL;
+
+  sqe = uv__iou_next_sqe(iou, req);
+  if (sqe == NULL)
+    return NULL;
+
+  /* Pacify uv_cancel(). */
+  req->work_req.loop = loop;
+  req->work_req.work = NULL;
+  req->work_req.done = NULL;
+  QUEUE_INIT(&req->work_req.wq);
+
+  uv__req_register(loop, req);
+  if (iou->in_flight++ == 0)
+    uv__io_start(loop, &iou->watcher, POLLIN);
+
+  return sqe;
+}
+
+
+/* Hands all queued submission entries to the kernel. Entries that the kernel
+ * does not accept right away stay queued and are retried once completions
+ * have been processed.
+ */
+static void uv__iou_flush(struct uv__iou* iou) {
+  uint32_t pending;
+  int rc;
+
+  for (;;) {
+    pending = *iou->sqtail - __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+    if (pending == 0)
+      return;
+
+    do
+      rc = uv__io_uring_enter(iou->ringfd, pending, 0, 0);
+    while (rc == -1 && errno == EINTR);
+
+    if (rc == -1) {
+      if (errno == EAGAIN || errno == EBUSY)
+        return;
+      abort();
+    }
+  }
+}
+
+
+static void uv__iou_submit(struct uv__iou* iou) {
+  __atomic_store_n(iou->sqtail, *iou->sqtail + 1, __ATOMIC_RELEASE);
+  uv__iou_flush(iou);
+}
+
+
+static void uv__iou_prep_rw(struct uv__io_uring_sqe* sqe,
+                            uv_fs_t* req,
+                            int is_read) {
+  /* The non-vectored opcodes take a 32 bits length. */
+  if (req->nbufs == 1 && req->bufs[0].len <= UINT32_MAX) {
+    sqe->addr = (uintptr_t) req->bufs[0].base;
+    sqe->len = req->bufs[0].len;
+    sqe->opcode = is_read ? UV__IORING_OP_READ : UV__IORING_OP_WRITE;
+  } else {
+    sqe->addr = (uintptr_t) req->bufs;
+    sqe->len = req->nbufs;
+    sqe->opcode = is_read ? UV__IORING_OP_READV : UV__IORING_OP_WRITEV;
+  }
+
+  sqe->fd = req->file;
+  /* -1 reads or writes at the current file position, like read(2). */
+  sqe->off = req->off < 0 ? (uint64_t) -1 : (uint64_t) req->off;
+}
+
+
+int uv__iou_fs_close(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  if (iou->state == 0)
+    uv__iou_init(iou);
+
+  /* See uv__iou_close_is_safe(). */
+  if (!iou->use_close)
+    return 0;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->opcode = UV__IORING_OP_CLOSE;
+
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+static int uv__iou_fs_fsync_or_fdatasync(uv_loop_t* loop,
+                                         uv_fs_t* req,
+                                         uint32_t fsync_flags) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->op_flags = fsync_flags;
+  sqe->opcode = UV__IORING_OP_FSYNC;
+
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_fsync(uv_loop_t* loop, uv_fs_t* req) {
+  return uv__iou_fs_fsync_or_fdatasync(loop, req, 0);
+}
+
+
+int uv__iou_fs_fdatasync(uv_loop_t* loop, uv_fs_t* req) {
+  return uv__iou_fs_fsync_or_fdatasync(loop, req, UV__IORING_FSYNC_DATASYNC);
+}
+
+
+int uv__iou_fs_open(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->fd = AT_FDCWD;
+  sqe->len = req->mode;
+  sqe->opcode = UV__IORING_OP_OPENAT;
+  sqe->op_flags = req->flags | O_CLOEXEC;
+
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_read_or_write(uv_loop_t* loop, uv_fs_t* req, int is_read) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  /* Leave large vectors to the threadpool, which splits them up. */
+  if (req->nbufs > IOV_MAX)
+    return 0;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  uv__iou_prep_rw(sqe, req, is_read);
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_statx(uv_loop_t* loop,
+                     uv_fs_t* req,
+                     int is_fstat,
+                     int is_lstat) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__statx* statxbuf;
+  struct uv__iou* iou;
+
+  statxbuf = uv__malloc(sizeof(*statxbuf));
+  if (statxbuf == NULL)
+    return 0;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL) {
+    uv__free(statxbuf);
+    return 0;
+  }
+
+  req->ptr = statxbuf;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->off = (uintptr_t) statxbuf;  /* addr2 */
+  sqe->fd = AT_FDCWD;
+  sqe->len = 0xFFF; /* STATX_BASIC_STATS + STATX_BTIME */
+  sqe->opcode = UV__IORING_OP_STATX;
+
+  if (is_fstat) {
+    sqe->addr = (uintptr_t) "";
+    sqe->fd = req->file;
+    sqe->op_flags |= UV__AT_EMPTY_PATH;
+  }
+
+  if (is_lstat)
+    sqe->op_flags |= AT_SYMLINK_NOFOLLOW;
+
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+/* Continues a write that the kernel completed only partially, like
+ * uv__fs_write_all() does for the threadpool. Returns 1 if the rest of the
+ * buffers has been submitted or queued, 0 if the request is complete.
+ */
+static int uv__iou_fs_write_more(struct uv__iou* iou,
+                                 uv_fs_t* req,
+                                 int32_t res) {
+  struct uv__io_uring_sqe* sqe;
+  unsigned int done;
+  size_t size;
+
+  req->result += res;
+
+  if (req->off >= 0)
+    req->off += res;
+
+  size = res;
+  for (done = 0; done < req->nbufs && req->bufs[done].len <= size; done++)
+    size -= req->bufs[done].len;
+
+  if (done == req->nbufs)
+    return 0;
+
+  req->bufs[done].base += size;
+  req->bufs[done].len -= size;
+
+  /* Move the remaining buffers to the front so that req->bufs keeps pointing
+   * to the start of the allocation.
+   */
+  req->nbufs -= done;
+  memmove(req->bufs, req->bufs + done, req->nbufs * sizeof(*req->bufs));
+
+  /* The request stays in flight and keeps its completion ring slot. When the
+   * submission ring is full, wait for the kernel to make room for it.
+   * work_req.wq is free to use because the request is not on the threadpool.
+   */
+  sqe = NULL;
+  if (QUEUE_EMPTY(&iou->write_queue))
+    sqe = uv__iou_next_sqe(iou, req);
+
+  if (sqe == NULL) {
+    QUEUE_INSERT_TAIL(&iou->write_queue, &req->work_req.wq);
+    return 1;
+  }
+
+  uv__iou_prep_rw(sqe, req, /* is_read */ 0);
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+/* Submits the partial writes that found the submission ring full. Other
+ * operations in flight keep the ring watcher armed until this succeeds.
+ */
+static void uv__iou_submit_write_queue(struct uv__iou* iou) {
+  struct uv__io_uring_sqe* sqe;
+  uv_fs_t* req;
+  QUEUE* q;
+
+  while (!QUEUE_EMPTY(&iou->write_queue)) {
+    q = QUEUE_HEAD(&iou->write_queue);
+    req = container_of(q, uv_fs_t, work_req.wq);
+
+    sqe = uv__iou_next_sqe(iou, req);
+    if (sqe == NULL)
+      return;
+
+    QUEUE_REMOVE(q);
+    QUEUE_INIT(q);
+    uv__iou_prep_rw(sqe, req, /* is_read */ 0);
+    uv__iou_submit(iou);
+  }
+}
+
+
+static void uv__iou_fs_done(uv_loop_t* loop,
+                            struct uv__iou* iou,
+                            uv_fs_t* req,
+                            int32_t res) {
+  if (req->fs_type == UV_FS_WRITE && res > 0)
+    if (uv__iou_fs_write_more(iou, req, res))
+      return;
+
+  switch (req->fs_type) {
+  case UV_FS_CLOSE:
+    /* The close is in progress, not an error. */
+    if (res == UV__ERR(EINTR) || res == UV__ERR(EINPROGRESS))
+      res = 0;
+    req->result = res;
+    break;
+
+  case UV_FS_READ:
+    if (req->bufs != req->bufsml)
+      uv__free(req->bufs);
+
+    req->bufs = NULL;
+    req->nbufs = 0;
+    req->result = res;
+    break;
+
+  case UV_FS_WRITE:
+    if (req->bufs != req->bufsml)
+      uv__free(req->bufs);
+
+    req->bufs = NULL;
+    req->nbufs = 0;
+
+    /* req->result holds the number of bytes written so far, which is what a
+     * write that fails after making progress reports.
+     */
+    if (res < 0 && req->result == 0)
+      req->result = res;
+    break;
+
+  case UV_FS_STAT:
+  case UV_FS_LSTAT:
+  case UV_FS_FSTAT:
+    if (res == 0)
+      uv__statx_to_stat(req->ptr, &req->statbuf);
+
+    uv__free(req->ptr);
+    req->ptr = res == 0 ? &req->statbuf : NULL;
+    req->result = res;
+    break;
+
+  default:
+    req->result = res;
+    break;
+  }
+
+  iou->in_flight--;
+  uv__req_unregister(loop, req);
+  req->cb(req);
+}
+
+
+static void uv__iou_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
+  struct uv__io_uring_cqe* cqe;
+  struct uv__io_uring_cqe* e;
+  struct uv__iou* iou;
+  uv_fs_t* req;
+  uint32_t head;
+  uint32_t tail;
+  int32_t res;
+
+  iou = container_of(w, struct uv__iou, watcher);
+  cqe = iou->cqe;
+
+  head = *iou->cqhead;
+  tail = __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE);
+
+  while (head != tail) {
+    e = &cqe[head & iou->cqmask];
+    req = (uv_fs_t*) (uintptr_t) e->user_data;
+    res = e->res;
+    assert(req->type == UV_FS);
+
+    /* Release the entry before the callback runs, it may start new operations
+     * that complete into the same slot.
+     */
+    __atomic_store_n(iou->cqhead, ++head, __ATOMIC_RELEASE);
+
+    uv__iou_fs_done(loop, iou, req, res);
+
+    tail = __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE);
+  }
+
+  /* Retry submissions that the kernel turned away because it was busy. */
+  uv__iou_flush(iou);
+  uv__iou_submit_write_queue(iou);
+
+  if (iou->in_flight == 0)
+    uv__io_stop(loop, &iou->watcher, POLLIN);
+}
+
+
 
 uint64_t uv__hrtime(uv_clocktype_t type) {
   static clock_t fast_clock_id = -1;
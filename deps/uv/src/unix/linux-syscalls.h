@@ -74,5 +74,10 @@ int uv__statx(int dirfd,
               unsigned int mask,
               struct uv__statx* statxbuf);
 ssize_t uv__getrandom(void* buf, size_t buflen, unsigned flags);
+int uv__io_uring_setup(int entries, void* params);
+int uv__io_uring_enter(int fd,
+                       unsigned to_submit,
+                       unsigned min_complete,
+                       unsigned flags);
 
 #endif /* UV_LINUX_SYSCALL_H_ */
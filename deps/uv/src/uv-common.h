@@ -365,9 +365,41 @@ struct uv__loop_metrics_s {
 void uv__metrics_update_idle_time(uv_loop_t* loop);
 void uv__metrics_set_provider_entry_time(uv_loop_t* loop);
 
+#if defined(__linux__)
+/* io_uring instance of a loop, used for file operations. The ring is only set
+ * up when the first asynchronous file operation is started.
+ */
+struct uv__iou {
+  uint32_t* sqhead;
+  uint32_t* sqtail;
+  uint32_t* sqarray;
+  uint32_t sqmask;
+  uint32_t* cqhead;
+  uint32_t* cqtail;
+  uint32_t cqmask;
+  uint32_t cqentries;
+  void* sq;   /* pointer to munmap() on event loop teardown */
+  void* cqe;  /* pointer to array of struct uv__io_uring_cqe */
+  void* sqe;  /* pointer to array of struct uv__io_uring_sqe */
+  size_t maxlen;
+  size_t sqelen;
+  uint32_t in_flight;
+  QUEUE write_queue;  /* partial writes waiting for a submission slot */
+  int ringfd;
+  int state;  /* 0 = not set up yet, 1 = ready, -1 = unavailable */
+  int use_close;  /* whether closing files through the ring is safe */
+  unsigned long euid;
+  unsigned long egid;
+  uv__io_t watcher;
+};
+#endif  /* __linux__ */
+
 struct uv__loop_internal_fields_s {
   unsigned int flags;
   uv__loop_metrics_t loop_metrics;
+#if defined(__linux__)
+  struct uv__iou iou;
+#endif  /* __linux__ */
 };
 
 #endif /* UV_COMMON_H_ */
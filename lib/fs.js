@@ -25,6 +25,7 @@
 'use strict';
 
 const {
+  ArrayPrototypeMap,
   ArrayPrototypePush,
   BigIntPrototypeToString,
   MathMax,
@@ -80,6 +81,7 @@ const { toPathIfFileURL } = require('internal/url');
 const {
   customPromisifyArgs: kCustomPromisifyArgsSymbol,
   kEmptyObject,
+  normalizeEncoding,
   promisify: {
     custom: kCustomPromisifiedSymbol,
   },
@@ -97,12 +99,14 @@ const {
   getOptions,
   getValidatedFd,
   getValidatedPath,
+  getValidatedPaths,
   getValidMode,
   handleErrorFromBinding,
   nullCheck,
   preprocessSymlinkDestination,
   Stats,
   getStatsFromBinding,
+  getStatsManyFromBinding,
   realpathCacheKey,
   stringToFlags,
   stringToSymlinkType,
@@ -149,6 +153,8 @@ let fs;
 // Lazy loaded
 let cpFn;
 let cpSyncFn;
+let mmapFn;
+let mmapAsBlobFn;
 let promises = null;
 let ReadStream;
 let WriteStream;
@@ -162,6 +168,7 @@ let FileWriteStream;
 
 const isWindows = process.platform === 'win32';
 const isOSX = process.platform === 'darwin';
+const isLinux = process.platform === 'linux';
 
 
 function showTruncateDeprecation() {
@@ -358,6 +365,25 @@ function checkAborted(signal, callback) {
   return false;
 }
 
+function readFileAfterReadFile(err, data) {
+  const { callback, encoding } = this.context;
+  if (err)
+    return callback(err);
+
+  // The binding reports the size of files that are too large instead.
+  if (typeof data === 'number')
+    return callback(new ERR_FS_FILE_TOO_LARGE(data));
+
+  if (encoding && typeof data !== 'string') {
+    try {
+      data = data.toString(encoding);
+    } catch (err) {
+      return callback(err);
+    }
+  }
+  callback(null, data);
+}
+
 /**
  * Asynchronously reads the entire contents of a file.
  * @param {string | Buffer | URL | number} path
@@ -375,6 +401,26 @@ function checkAborted(signal, callback) {
 function readFile(path, options, callback) {
   callback = maybeCallback(callback || options);
   options = getOptions(options, { flag: 'r' });
+
+  if (!options.signal) {
+    // Without a signal to check between reads, the whole file is read by a
+    // single request.
+    const isUserFd = isFd(path);
+    let flagsNumber = 0;
+    if (!isUserFd) {
+      flagsNumber = stringToFlags(options.flag, 'options.flag');
+      path = pathModule.toNamespacedPath(getValidatedPath(path));
+    }
+    const req = new FSReqCallback();
+    req.context = { callback, encoding: options.encoding };
+    req.oncomplete = readFileAfterReadFile;
+    if (normalizeEncoding(options.encoding) === 'utf8')
+      binding.readFileUtf8(path, flagsNumber, req);
+    else
+      binding.readFileBuffer(path, flagsNumber, req);
+    return;
+  }
+
   const context = new ReadFileContext(callback, options.encoding);
   context.isUserFd = isFd(path); // File descriptor ownership
 
@@ -1134,6 +1180,15 @@ function lazyLoadCp() {
   }
 }
 
+function lazyLoadMmap() {
+  if (mmapFn === undefined) {
+    ({
+      mmap: mmapFn,
+      mmapAsBlob: mmapAsBlobFn,
+    } = require('internal/fs/mmap'));
+  }
+}
+
 function lazyLoadRimraf() {
   if (rimraf === undefined)
     ({ rimraf, rimrafSync } = require('internal/fs/rimraf'));
@@ -1512,6 +1567,44 @@ function stat(path, options = { bigint: false }, callback) {
   binding.stat(pathModule.toNamespacedPath(path), options.bigint, req);
 }
 
+/**
+ * Asynchronously gets the stats of many files at once.
+ * @param {Array<string | Buffer | URL>} paths
+ * @param {{
+ *   bigint?: boolean;
+ *   throwIfNoEntry?: boolean;
+ *   }} [options]
+ * @param {(
+ *   err?: Error,
+ *   stats?: Array<Stats | undefined>
+ *   ) => any} callback
+ * @returns {void}
+ */
+function statMany(paths, options = kEmptyObject, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = kEmptyObject;
+  }
+  callback = maybeCallback(callback);
+  paths = getValidatedPaths(paths);
+  const throwIfNoEntry = options.throwIfNoEntry !== false;
+
+  const req = new FSReqCallback(options.bigint);
+  req.oncomplete = (err, result) => {
+    if (err)
+      return callback(err);
+    let stats;
+    try {
+      stats = getStatsManyFromBinding(paths, result, throwIfNoEntry);
+    } catch (err) {
+      return callback(err);
+    }
+    callback(null, stats);
+  };
+  binding.statMany(ArrayPrototypeMap(paths, pathModule.toNamespacedPath),
+                   options.bigint, req);
+}
+
 function hasNoEntryError(ctx) {
   if (ctx.errno) {
     const uvErr = uvErrmapGet(ctx.errno);
@@ -2292,9 +2385,9 @@ function watch(filename, options, listener) {
 
   if (options.persistent === undefined) options.persistent = true;
   if (options.recursive === undefined) options.recursive = false;
-  if (options.recursive && !(isOSX || isWindows))
+  if (options.recursive && !(isOSX || isWindows || isLinux))
     throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM('watch recursively');
-  const watcher = new watchers.FSWatcher();
+  const watcher = new watchers.FSWatcher(options.recursive);
   watcher[watchers.kFSWatchStart](filename,
                                   options.persistent,
                                   options.recursive,
@@ -2887,6 +2980,39 @@ function cpSync(src, dest, options) {
   cpSyncFn(src, dest, options);
 }
 
+/**
+ * Maps a range of the file referred to by `fd` into memory and returns it
+ * as a `Buffer`. The mapping is released once the `Buffer` is garbage
+ * collected.
+ * @param {number} fd
+ * @param {number} [offset]
+ * @param {number} [length]
+ * @param {{
+ *   prot?: 'r' | 'rw';
+ *   shared?: boolean;
+ *   advice?: 'normal' | 'sequential' | 'random' | 'willneed';
+ *   }} [options]
+ * @returns {Buffer}
+ */
+function mmap(fd, offset, length, options) {
+  lazyLoadMmap();
+  return mmapFn(fd, offset, length, options);
+}
+
+/**
+ * Maps a range of the file referred to by `fd` into memory and returns it
+ * as a `Blob` that reads from the mapping without copying it.
+ * @param {number} fd
+ * @param {number} [offset]
+ * @param {number} [length]
+ * @param {{ type?: string; }} [options]
+ * @returns {Blob}
+ */
+function mmapAsBlob(fd, offset, length, options) {
+  lazyLoadMmap();
+  return mmapAsBlobFn(fd, offset, length, options);
+}
+
 function lazyLoadStreams() {
   if (!ReadStream) {
     ({ ReadStream, WriteStream } = require('internal/fs/streams'));
@@ -2985,6 +3111,8 @@ module.exports = fs = {
   mkdirSync,
   mkdtemp,
   mkdtempSync,
+  mmap,
+  mmapAsBlob,
   open,
   openSync,
   opendir,
@@ -3008,6 +3136,7 @@ module.exports = fs = {
   rmdir,
   rmdirSync,
   stat,
+  statMany,
   statSync,
   symlink,
   symlinkSync,
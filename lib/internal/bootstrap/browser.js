@@ -8,6 +8,7 @@ const {
 const {
   defineOperation,
   exposeInterface,
+  exposeLazyInterfaces,
   lazyDOMExceptionClass,
 } = require('internal/util');
 const config = internalBinding('config');
@@ -73,10 +74,10 @@ defineOperation(globalThis, 'btoa', buffer.btoa);
 exposeInterface(globalThis, 'Blob', buffer.Blob);
 
 // https://www.w3.org/TR/hr-time-2/#the-performance-attribute
-const perf_hooks = require('perf_hooks');
-exposeInterface(globalThis, 'Performance', perf_hooks.Performance);
+const perf = require('internal/perf/performance');
+exposeInterface(globalThis, 'Performance', perf.Performance);
 defineReplacableAttribute(globalThis, 'performance',
-                          perf_hooks.performance);
+                          perf.performance);
 
 function createGlobalConsole() {
   const consoleFromNode =
@@ -126,55 +127,36 @@ function defineReplacableAttribute(target, name, value) {
 }
 
 // Web Streams API
-const {
-  TransformStream,
-  TransformStreamDefaultController,
-} = require('internal/webstreams/transformstream');
-
-const {
-  WritableStream,
-  WritableStreamDefaultController,
-  WritableStreamDefaultWriter,
-} = require('internal/webstreams/writablestream');
+exposeLazyInterfaces(
+  globalThis,
+  'internal/webstreams/transformstream',
+  ['TransformStream', 'TransformStreamDefaultController']);
 
-const {
-  ReadableStream,
-  ReadableStreamDefaultReader,
-  ReadableStreamBYOBReader,
-  ReadableStreamBYOBRequest,
-  ReadableByteStreamController,
-  ReadableStreamDefaultController,
-} = require('internal/webstreams/readablestream');
+exposeLazyInterfaces(
+  globalThis,
+  'internal/webstreams/writablestream',
+  ['WritableStream', 'WritableStreamDefaultController', 'WritableStreamDefaultWriter']);
 
-const {
-  ByteLengthQueuingStrategy,
-  CountQueuingStrategy,
-} = require('internal/webstreams/queuingstrategies');
+exposeLazyInterfaces(
+  globalThis,
+  'internal/webstreams/readablestream',
+  [
+    'ReadableStream', 'ReadableStreamDefaultReader',
+    'ReadableStreamBYOBReader', 'ReadableStreamBYOBRequest',
+    'ReadableByteStreamController', 'ReadableStreamDefaultController',
+  ]);
+
+exposeLazyInterfaces(
+  globalThis,
+  'internal/webstreams/queuingstrategies',
+  ['ByteLengthQueuingStrategy', 'CountQueuingStrategy']);
 
-const {
-  TextEncoderStream,
-  TextDecoderStream,
-} = require('internal/webstreams/encoding');
+exposeLazyInterfaces(
+  globalThis,
+  'internal/webstreams/encoding',
+  ['TextEncoderStream', 'TextDecoderStream']);
 
-const {
-  CompressionStream,
-  DecompressionStream,
-} = require('internal/webstreams/compression');
-
-exposeInterface(globalThis, 'ReadableStream', ReadableStream);
-exposeInterface(globalThis, 'ReadableStreamDefaultReader', ReadableStreamDefaultReader);
-exposeInterface(globalThis, 'ReadableStreamBYOBReader', ReadableStreamBYOBReader);
-exposeInterface(globalThis, 'ReadableStreamBYOBRequest', ReadableStreamBYOBRequest);
-exposeInterface(globalThis, 'ReadableByteStreamController', ReadableByteStreamController);
-exposeInterface(globalThis, 'ReadableStreamDefaultController', ReadableStreamDefaultController);
-exposeInterface(globalThis, 'TransformStream', TransformStream);
-exposeInterface(globalThis, 'TransformStreamDefaultController', TransformStreamDefaultController);
-exposeInterface(globalThis, 'WritableStream', WritableStream);
-exposeInterface(globalThis, 'WritableStreamDefaultWriter', WritableStreamDefaultWriter);
-exposeInterface(globalThis, 'WritableStreamDefaultController', WritableStreamDefaultController);
-exposeInterface(globalThis, 'ByteLengthQueuingStrategy', ByteLengthQueuingStrategy);
-exposeInterface(globalThis, 'CountQueuingStrategy', CountQueuingStrategy);
-exposeInterface(globalThis, 'TextEncoderStream', TextEncoderStream);
-exposeInterface(globalThis, 'TextDecoderStream', TextDecoderStream);
-exposeInterface(globalThis, 'CompressionStream', CompressionStream);
-exposeInterface(globalThis, 'DecompressionStream', DecompressionStream);
+exposeLazyInterfaces(
+  globalThis,
+  'internal/webstreams/compression',
+  ['CompressionStream', 'DecompressionStream']);
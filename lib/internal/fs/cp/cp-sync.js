@@ -4,6 +4,8 @@
 
 const { areIdentical, isSrcSubdir } = require('internal/fs/cp/cp');
 const { codes } = require('internal/errors');
+const { handleErrorFromBinding } = require('internal/fs/utils');
+const binding = internalBinding('fs');
 const {
   os: {
     errno: {
@@ -28,7 +30,6 @@ const {
 } = codes;
 const {
   chmodSync,
-  copyFileSync,
   existsSync,
   lstatSync,
   mkdirSync,
@@ -37,7 +38,6 @@ const {
   statSync,
   symlinkSync,
   unlinkSync,
-  utimesSync,
 } = require('fs');
 const {
   dirname,
@@ -45,6 +45,7 @@ const {
   join,
   parse,
   resolve,
+  toNamespacedPath,
 } = require('path');
 const { isPromise } = require('util/types');
 
@@ -230,39 +231,18 @@ function mayCopyFile(srcStat, src, dest, opts) {
 }
 
 function copyFile(srcStat, src, dest, opts) {
-  copyFileSync(src, dest);
-  if (opts.preserveTimestamps) handleTimestamps(srcStat.mode, src, dest);
-  return setDestMode(dest, srcStat.mode);
-}
-
-function handleTimestamps(srcMode, src, dest) {
-  // Make sure the file is writable before setting the timestamp
-  // otherwise open fails with EPERM when invoked with 'r+'
-  // (through utimes call)
-  if (fileIsNotWritable(srcMode)) makeFileWritable(dest, srcMode);
-  return setDestTimestamps(src, dest);
-}
-
-function fileIsNotWritable(srcMode) {
-  return (srcMode & 0o200) === 0;
-}
-
-function makeFileWritable(dest, srcMode) {
-  return setDestMode(dest, srcMode | 0o200);
+  // Copies the file, preferring a reflink, and applies the mode and
+  // timestamps of src in a single call.
+  const ctx = { path: src, dest };
+  binding.cpFile(toNamespacedPath(src), toNamespacedPath(dest), srcStat.mode,
+                 opts.preserveTimestamps, undefined, ctx);
+  handleErrorFromBinding(ctx);
 }
 
 function setDestMode(dest, srcMode) {
   return chmodSync(dest, srcMode);
 }
 
-function setDestTimestamps(src, dest) {
-  // The initial srcStat.atime cannot be trusted
-  // because it is modified by the read(2) system call
-  // (See https://nodejs.org/api/fs.html#fs_stat_time_values)
-  const updatedSrcStat = statSync(src);
-  return utimesSync(dest, updatedSrcStat.atime, updatedSrcStat.mtime);
-}
-
 function onDir(srcStat, destStat, src, dest, opts) {
   if (!destStat) return mkDirAndCopy(srcStat.mode, src, dest, opts);
   return copyDir(src, dest, opts);
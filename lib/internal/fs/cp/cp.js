@@ -5,9 +5,14 @@
 const {
   ArrayPrototypeEvery,
   ArrayPrototypeFilter,
+  ArrayPrototypeIndexOf,
+  ArrayPrototypePush,
+  ArrayPrototypeSplice,
   Boolean,
+  Promise,
   PromisePrototypeThen,
   PromiseReject,
+  PromiseResolve,
   SafePromiseAll,
   StringPrototypeSplit,
 } = primordials;
@@ -34,9 +39,10 @@ const {
     }
   }
 } = internalBinding('constants');
+const binding = internalBinding('fs');
+const { kUsePromises } = binding;
 const {
   chmod,
-  copyFile,
   lstat,
   mkdir,
   opendir,
@@ -44,7 +50,6 @@ const {
   stat,
   symlink,
   unlink,
-  utimes,
 } = require('fs/promises');
 const {
   dirname,
@@ -53,7 +58,37 @@ const {
   parse,
   resolve,
   sep,
+  toNamespacedPath,
 } = require('path');
+const FixedQueue = require('internal/fixed_queue');
+
+// Limits the number of entries that are copied at the same time across the
+// whole tree, so that the concurrency option does not multiply with the
+// depth of the tree. A directory hands its slot back while its own entries
+// are copied, so that nested directories never wait for each other.
+class CopyLimiter {
+  #available;
+  #waiting = new FixedQueue();
+
+  constructor(concurrency) {
+    this.#available = concurrency;
+  }
+
+  acquire() {
+    if (this.#available > 0) {
+      this.#available--;
+      return PromiseResolve();
+    }
+    return new Promise((resolve) => this.#waiting.push(resolve));
+  }
+
+  release() {
+    if (this.#waiting.isEmpty())
+      this.#available++;
+    else
+      this.#waiting.shift()();
+  }
+}
 
 async function cpFn(src, dest, opts) {
   // Warn about using preserveTimestamps on 32-bit node
@@ -65,6 +100,11 @@ async function cpFn(src, dest, opts) {
   const stats = await checkPaths(src, dest, opts);
   const { srcStat, destStat } = stats;
   await checkParentPaths(src, srcStat, dest);
+  if (opts.concurrency > 1) {
+    // The source itself takes the first slot, like any other entry.
+    const limiter = new CopyLimiter(opts.concurrency - 1);
+    opts = { ...opts, limiter };
+  }
   if (opts.filter) {
     return handleFilter(checkParentDir, destStat, src, dest, opts);
   }
@@ -267,50 +307,17 @@ async function mayCopyFile(srcStat, src, dest, opts) {
   }
 }
 
-async function _copyFile(srcStat, src, dest, opts) {
-  await copyFile(src, dest);
-  if (opts.preserveTimestamps) {
-    return handleTimestampsAndMode(srcStat.mode, src, dest);
-  }
-  return setDestMode(dest, srcStat.mode);
-}
-
-async function handleTimestampsAndMode(srcMode, src, dest) {
-  // Make sure the file is writable before setting the timestamp
-  // otherwise open fails with EPERM when invoked with 'r+'
-  // (through utimes call)
-  if (fileIsNotWritable(srcMode)) {
-    await makeFileWritable(dest, srcMode);
-    return setDestTimestampsAndMode(srcMode, src, dest);
-  }
-  return setDestTimestampsAndMode(srcMode, src, dest);
-}
-
-function fileIsNotWritable(srcMode) {
-  return (srcMode & 0o200) === 0;
-}
-
-function makeFileWritable(dest, srcMode) {
-  return setDestMode(dest, srcMode | 0o200);
-}
-
-async function setDestTimestampsAndMode(srcMode, src, dest) {
-  await setDestTimestamps(src, dest);
-  return setDestMode(dest, srcMode);
+function _copyFile(srcStat, src, dest, opts) {
+  // Copies the file, preferring a reflink, and applies the mode and
+  // timestamps of src in a single thread pool request.
+  return binding.cpFile(toNamespacedPath(src), toNamespacedPath(dest),
+                        srcStat.mode, opts.preserveTimestamps, kUsePromises);
 }
 
 function setDestMode(dest, srcMode) {
   return chmod(dest, srcMode);
 }
 
-async function setDestTimestamps(src, dest) {
-  // The initial srcStat.atime cannot be trusted
-  // because it is modified by the read(2) system call
-  // (See https://nodejs.org/api/fs.html#fs_stat_time_values)
-  const updatedSrcStat = await stat(src);
-  return utimes(dest, updatedSrcStat.atime, updatedSrcStat.mtime);
-}
-
 function onDir(srcStat, destStat, src, dest, opts) {
   if (!destStat) return mkDirAndCopy(srcStat.mode, src, dest, opts);
   return copyDir(src, dest, opts);
@@ -322,15 +329,54 @@ async function mkDirAndCopy(srcMode, src, dest, opts) {
   return setDestMode(dest, srcMode);
 }
 
+async function copyItem(src, dest, name, opts) {
+  const srcItem = join(src, name);
+  const destItem = join(dest, name);
+  const { destStat } = await checkPaths(srcItem, destItem, opts);
+  await startCopy(destStat, srcItem, destItem, opts);
+}
+
 async function copyDir(src, dest, opts) {
   const dir = await opendir(src);
 
-  for await (const { name } of dir) {
-    const srcItem = join(src, name);
-    const destItem = join(dest, name);
-    const { destStat } = await checkPaths(srcItem, destItem, opts);
-    await startCopy(destStat, srcItem, destItem, opts);
+  const { limiter } = opts;
+  if (limiter === undefined) {
+    for await (const { name } of dir)
+      await copyItem(src, dest, name, opts);
+    return;
+  }
+
+  // Copy the entries as slots of the shared limiter become available. On
+  // failure, wait for the copies in progress before reporting the first
+  // error, so that nothing is written after the returned promise settles.
+  // The slot of this directory is taken back before returning.
+  limiter.release();
+  const pending = [];
+  let error;
+  try {
+    for await (const { name } of dir) {
+      await limiter.acquire();
+      if (error !== undefined) {
+        limiter.release();
+        break;
+      }
+      const copy = PromisePrototypeThen(
+        copyItem(src, dest, name, opts),
+        () => limiter.release(),
+        (err) => {
+          error ??= { err };
+          limiter.release();
+        });
+      ArrayPrototypePush(pending, copy);
+      PromisePrototypeThen(copy, () => {
+        ArrayPrototypeSplice(pending, ArrayPrototypeIndexOf(pending, copy), 1);
+      });
+    }
+  } finally {
+    await SafePromiseAll(pending);
+    await limiter.acquire();
   }
+  if (error !== undefined) throw error.err;
 }
 
 async function onLink(destStat, src, dest, opts) {
@@ -1,14 +1,19 @@
 'use strict';
 
 const {
+  Array,
   ArrayPrototypePush,
   ArrayPrototypeSlice,
   ArrayPrototypeSplice,
   FunctionPrototypeBind,
   ObjectDefineProperty,
+  Promise,
+  PromisePrototypeThen,
   PromiseReject,
   Symbol,
   SymbolAsyncIterator,
+  Uint32Array,
+  Uint8Array,
 } = primordials;
 
 const pathModule = require('path');
@@ -22,16 +27,22 @@ const {
   }
 } = require('internal/errors');
 
-const { FSReqCallback } = binding;
+const { FSReqCallback, kUsePromises } = binding;
+const { DirWalker } = dirBinding;
 const internalUtil = require('internal/util');
+const { Buffer } = require('buffer');
 const {
+  Dirent,
   getDirent,
+  getDirents,
   getOptions,
   getValidatedPath,
   handleErrorFromBinding
 } = require('internal/fs/utils');
 const {
+  validateArray,
   validateFunction,
+  validateString,
   validateUint32
 } = require('internal/validators');
 
@@ -44,6 +55,28 @@ const kDirReadImpl = Symbol('kDirReadImpl');
 const kDirReadPromisified = Symbol('kDirReadPromisified');
 const kDirClosePromisified = Symbol('kDirClosePromisified');
 const kDirOperationQueue = Symbol('kDirOperationQueue');
+const kDirReadBatch = Symbol('kDirReadBatch');
+const kDirReadPackedPromisified = Symbol('kDirReadPackedPromisified');
+
+const getDirentsPromisified = internalUtil.promisify(getDirents);
+
+function noop() {}
+
+// Packs entries in the [name, type, ...] layout of kDirBufferedEntries the
+// same way as DirHandle::ReadPacked() does.
+function packEntries(entries) {
+  const count = entries.length / 2;
+  const names = new Array(count);
+  const offsets = new Uint32Array(count + 1);
+  const types = new Uint8Array(count);
+  for (let i = 0; i < count; i++) {
+    const name = entries[i * 2];
+    names[i] = typeof name === 'string' ? Buffer.from(name) : name;
+    offsets[i + 1] = offsets[i] + names[i].length;
+    types[i] = entries[i * 2 + 1];
+  }
+  return { names: Buffer.concat(names, offsets[count]), offsets, types };
+}
 
 class Dir {
   constructor(handle, path, options) {
@@ -70,6 +103,8 @@ class Dir {
       internalUtil.promisify(this[kDirReadImpl]), this, false);
     this[kDirClosePromisified] = FunctionPrototypeBind(
       internalUtil.promisify(this.close), this);
+    this[kDirReadPackedPromisified] = FunctionPrototypeBind(
+      internalUtil.promisify(this.readPacked), this);
   }
 
   get path() {
@@ -164,6 +199,126 @@ class Dir {
     return getDirent(this[kDirPath], result[0], result[1]);
   }
 
+  // Reads the next batch of entries as an array of Dirents, or null once all
+  // entries have been read. Other operations wait until the batch is read.
+  [kDirReadBatch]() {
+    if (this[kDirOperationQueue] !== null) {
+      return new Promise((resolve) => {
+        ArrayPrototypePush(this[kDirOperationQueue], () => {
+          resolve(this[kDirReadBatch]());
+        });
+      });
+    }
+    if (this[kDirClosed] === true) {
+      return PromiseReject(new ERR_DIR_CLOSED());
+    }
+
+    const done = () => {
+      process.nextTick(() => {
+        const queue = this[kDirOperationQueue];
+        this[kDirOperationQueue] = null;
+        for (const op of queue) op();
+      });
+    };
+
+    this[kDirOperationQueue] = [];
+    const promise = this[kDirHandle].read(
+      this[kDirOptions].encoding,
+      this[kDirOptions].bufferSize,
+      kUsePromises
+    );
+    return PromisePrototypeThen(promise, (result) => {
+      done();
+      if (result === null) {
+        return null;
+      }
+      const names = new Array(result.length / 2);
+      const types = new Array(result.length / 2);
+      for (let i = 0; i < result.length; i += 2) {
+        names[i / 2] = result[i];
+        types[i / 2] = result[i + 1];
+      }
+      return getDirentsPromisified(this[kDirPath], [names, types]);
+    }, (err) => {
+      done();
+      throw err;
+    });
+  }
+
+  readPacked(callback) {
+    if (this[kDirClosed] === true) {
+      throw new ERR_DIR_CLOSED();
+    }
+
+    if (callback === undefined) {
+      return this[kDirReadPackedPromisified]();
+    }
+
+    validateFunction(callback, 'callback');
+
+    if (this[kDirOperationQueue] !== null) {
+      ArrayPrototypePush(this[kDirOperationQueue], () => {
+        this.readPacked(callback);
+      });
+      return;
+    }
+
+    if (this[kDirBufferedEntries].length > 0) {
+      const packed = packEntries(this[kDirBufferedEntries]);
+      this[kDirBufferedEntries] = [];
+      process.nextTick(callback, null, packed);
+      return;
+    }
+
+    const req = new FSReqCallback();
+    req.oncomplete = (err, result) => {
+      process.nextTick(() => {
+        const queue = this[kDirOperationQueue];
+        this[kDirOperationQueue] = null;
+        for (const op of queue) op();
+      });
+
+      if (err || result === null) {
+        return callback(err, result);
+      }
+
+      callback(null, { names: result[0], offsets: result[1], types: result[2] });
+    };
+
+    this[kDirOperationQueue] = [];
+    this[kDirHandle].readPacked(this[kDirOptions].bufferSize, req);
+  }
+
+  readPackedSync() {
+    if (this[kDirClosed] === true) {
+      throw new ERR_DIR_CLOSED();
+    }
+
+    if (this[kDirOperationQueue] !== null) {
+      throw new ERR_DIR_CONCURRENT_OPERATION();
+    }
+
+    if (this[kDirBufferedEntries].length > 0) {
+      const packed = packEntries(this[kDirBufferedEntries]);
+      this[kDirBufferedEntries] = [];
+      return packed;
+    }
+
+    const ctx = { path: this[kDirPath] };
+    const result = this[kDirHandle].readPacked(
+      this[kDirOptions].bufferSize,
+      undefined,
+      ctx
+    );
+    handleErrorFromBinding(ctx);
+
+    if (result === null) {
+      return result;
+    }
+
+    return { names: result[0], offsets: result[1], types: result[2] };
+  }
+
   close(callback) {
     // Promise
     if (callback === undefined) {
@@ -212,12 +367,24 @@ class Dir {
 
   async* entries() {
     try {
+      // Entries buffered by an earlier read() come first.
+      while (this[kDirBufferedEntries].length > 0) {
+        yield await this[kDirReadPromisified]();
+      }
+      // The next batch is read on the thread pool while the current one is
+      // being consumed. close() waits for it through the operation queue.
+      let next = this[kDirReadBatch]();
       while (true) {
-        const result = await this[kDirReadPromisified]();
-        if (result === null) {
+        const dirents = await next;
+        if (dirents === null) {
           break;
         }
-        yield result;
+        next = this[kDirReadBatch]();
+        // Errors are reported once the batch is awaited, if it ever is.
+        PromisePrototypeThen(next, undefined, noop);
+        for (let i = 0; i < dirents.length; i++) {
+          yield dirents[i];
+        }
       }
     } finally {
       await this[kDirClosePromisified]();
@@ -278,8 +445,53 @@ function opendirSync(path, options) {
   return new Dir(handle, path, options);
 }
 
+function validateNames(names, name) {
+  validateArray(names, name);
+  for (let i = 0; i < names.length; i++)
+    validateString(names[i], `${name}[${i}]`);
+}
+
+/**
+ * Walks a directory tree breadth-first, yielding its entries in batches.
+ * The name of each entry is its path relative to `path`.
+ * @param {string | Buffer | URL} path
+ * @param {{
+ *   encoding?: string;
+ *   exclude?: string[];
+ *   suffixes?: string[];
+ *   }} [options]
+ * @yields {Dirent[]}
+ */
+async function* walk(path, options) {
+  path = getValidatedPath(path);
+  options = getOptions(options, {
+    encoding: 'utf8'
+  });
+  const { exclude = [], suffixes = [] } = options;
+  validateNames(exclude, 'options.exclude');
+  validateNames(suffixes, 'options.suffixes');
+
+  const walker = new DirWalker(pathModule.toNamespacedPath(path),
+                               exclude, suffixes);
+  try {
+    while (true) {
+      const result = await walker.read(options.encoding, kUsePromises);
+      if (result === null) {
+        break;
+      }
+      const dirents = new Array(result.length / 2);
+      for (let i = 0; i < result.length; i += 2)
+        dirents[i / 2] = new Dirent(result[i], result[i + 1]);
+      yield dirents;
+    }
+  } finally {
+    walker.close();
+  }
+}
+
 module.exports = {
   Dir,
   opendir,
-  opendirSync
+  opendirSync,
+  walk,
 };
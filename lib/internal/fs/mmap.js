@@ -0,0 +1,145 @@
+'use strict';
+
+const {
+  ObjectKeys,
+} = primordials;
+
+const {
+  codes: {
+    ERR_BUFFER_TOO_LARGE,
+    ERR_OUT_OF_RANGE,
+  },
+} = require('internal/errors');
+const {
+  validateBoolean,
+  validateInteger,
+  validateObject,
+  validateOneOf,
+  validateString,
+} = require('internal/validators');
+const {
+  getStatsFromBinding,
+  getValidatedFd,
+  handleErrorFromBinding,
+} = require('internal/fs/utils');
+const { createBlob } = require('internal/blob');
+const { FastBuffer } = require('internal/buffer');
+const { kMaxLength } = internalBinding('buffer');
+const { createBlob: createBlobHandle } = internalBinding('blob');
+const binding = internalBinding('fs');
+
+// Mirrors MmapAdvice in src/node_file.cc.
+const kMmapAdvice = {
+  __proto__: null,
+  normal: 0,
+  sequential: 1,
+  random: 2,
+  willneed: 3,
+};
+
+function isOptions(value) {
+  return value !== null && typeof value === 'object';
+}
+
+function getMmapOptions(options) {
+  if (options == null) options = {};
+  validateObject(options, 'options');
+  const { prot = 'r', shared = true, advice = 'normal' } = options;
+  validateOneOf(prot, 'options.prot', ['r', 'rw']);
+  validateBoolean(shared, 'options.shared');
+  validateOneOf(advice, 'options.advice', ObjectKeys(kMmapAdvice));
+  return { writable: prot === 'rw', shared, advice: kMmapAdvice[advice] };
+}
+
+function mapRange(fd, offset, length, options) {
+  fd = getValidatedFd(fd);
+  if (offset === undefined) offset = 0;
+  validateInteger(offset, 'offset', 0);
+
+  // Touching a page past the end of the file raises SIGBUS, so only ranges
+  // within the current size of the file can be mapped.
+  const statsCtx = { fd };
+  const stats = binding.fstat(fd, false, undefined, statsCtx);
+  handleErrorFromBinding(statsCtx);
+  const { size } = getStatsFromBinding(stats);
+  if (offset > size)
+    throw new ERR_OUT_OF_RANGE('offset', `<= ${size}`, offset);
+  if (length === undefined) {
+    length = size - offset;
+  } else {
+    validateInteger(length, 'length', 0);
+    if (offset + length > size)
+      throw new ERR_OUT_OF_RANGE('length', `<= ${size - offset}`, length);
+  }
+  if (length > kMaxLength)
+    throw new ERR_BUFFER_TOO_LARGE(kMaxLength);
+  if (length === 0)
+    return new FastBuffer();
+
+  const ctx = {};
+  const buffer = binding.mmap(fd, offset, length, options.writable,
+                              options.shared, options.advice, ctx);
+  handleErrorFromBinding(ctx);
+  return buffer;
+}
+
+/**
+ * Maps a range of an open file into memory.
+ * @param {number} fd
+ * @param {number} [offset]
+ * @param {number} [length]
+ * @param {{
+ *   prot?: 'r' | 'rw';
+ *   shared?: boolean;
+ *   advice?: 'normal' | 'sequential' | 'random' | 'willneed';
+ *   }} [options]
+ * @returns {Buffer}
+ */
+function mmap(fd, offset, length, options) {
+  if (isOptions(offset)) {
+    options = offset;
+    offset = length = undefined;
+  } else if (isOptions(length)) {
+    options = length;
+    length = undefined;
+  }
+  return mapRange(fd, offset, length, getMmapOptions(options));
+}
+
+/**
+ * Maps a range of an open file into memory as a `Blob`.
+ * @param {number} fd
+ * @param {number} [offset]
+ * @param {number} [length]
+ * @param {{ type?: string; }} [options]
+ * @returns {Blob}
+ */
+function mmapAsBlob(fd, offset, length, options) {
+  if (isOptions(offset)) {
+    options = offset;
+    offset = length = undefined;
+  } else if (isOptions(length)) {
+    options = length;
+    length = undefined;
+  }
+  if (options == null) options = {};
+  validateObject(options, 'options');
+  const { type = '' } = options;
+  validateString(type, 'options.type');
+
+  const buffer = mapRange(fd, offset, length, {
+    writable: false,
+    shared: true,
+    advice: kMmapAdvice.normal,
+  });
+  if (buffer.length > 0xFFFFFFFF)
+    throw new ERR_BUFFER_TOO_LARGE(0xFFFFFFFF);
+  // The Blob takes ownership of the mapping without copying it.
+  const handle = createBlobHandle([buffer], buffer.length);
+  return createBlob(handle, buffer.length, type);
+}
+
+module.exports = {
+  mmap,
+  mmapAsBlob,
+};
@@ -1,6 +1,7 @@
 'use strict';
 
 const {
+  ArrayPrototypeMap,
   ArrayPrototypePush,
   Error,
   MathMax,
@@ -53,7 +54,9 @@ const {
   getDirents,
   getOptions,
   getStatsFromBinding,
+  getStatsManyFromBinding,
   getValidatedPath,
+  getValidatedPaths,
   getValidMode,
   nullCheck,
   preprocessSymlinkDestination,
@@ -69,7 +72,7 @@ const {
   validateStringAfterArrayBufferView,
   warnOnNonPortableTemplate,
 } = require('internal/fs/utils');
-const { opendir } = require('internal/fs/dir');
+const { opendir, walk } = require('internal/fs/dir');
 const {
   parseFileMode,
   validateAbortSignal,
@@ -84,6 +87,7 @@ const pathModule = require('path');
 const {
   kEmptyObject,
   lazyDOMException,
+  normalizeEncoding,
   promisify,
 } = require('internal/util');
 const { EventEmitterMixin } = require('internal/event_target');
@@ -122,6 +126,11 @@ function lazyLoadCpPromises() {
   return cpPromises ??= require('internal/fs/cp/cp').cpFn;
 }
 
+let mmapFn;
+function lazyLoadMmap() {
+  return mmapFn ??= require('internal/fs/mmap').mmap;
+}
+
 // Lazy loaded to avoid circular dependency.
 let fsStreams;
 function lazyFsStreams() {
@@ -185,6 +194,10 @@ class FileHandle extends EventEmitterMixin(JSTransferable) {
     return fsCall(fstat, this, options);
   }
 
+  mmap(offset, length, options) {
+    return fsCall(mmap, this, offset, length, options);
+  }
+
   truncate(len = 0) {
     return fsCall(ftruncate, this, len);
   }
@@ -728,6 +741,10 @@ async function fstat(handle, options = { bigint: false }) {
   return getStatsFromBinding(result);
 }
 
+async function mmap(handle, offset, length, options) {
+  return lazyLoadMmap()(handle.fd, offset, length, options);
+}
+
 async function lstat(path, options = { bigint: false }) {
   path = getValidatedPath(path);
   const result = await binding.lstat(pathModule.toNamespacedPath(path),
@@ -742,6 +759,15 @@ async function stat(path, options = { bigint: false }) {
   return getStatsFromBinding(result);
 }
 
+async function statMany(paths, options = kEmptyObject) {
+  paths = getValidatedPaths(paths);
+  const result = await binding.statMany(
+    ArrayPrototypeMap(paths, pathModule.toNamespacedPath),
+    options.bigint, kUsePromises);
+  return getStatsManyFromBinding(paths, result,
+                                 options.throwIfNoEntry !== false);
+}
+
 async function link(existingPath, newPath) {
   existingPath = getValidatedPath(existingPath, 'existingPath');
   newPath = getValidatedPath(newPath, 'newPath');
@@ -873,6 +899,21 @@ async function readFile(path, options) {
 
   checkAborted(options.signal);
 
+  if (!options.signal) {
+    // Without a signal to check between reads, the whole file is read by a
+    // single request.
+    path = pathModule.toNamespacedPath(getValidatedPath(path));
+    const flagsNumber = stringToFlags(flag);
+    const utf8 = normalizeEncoding(options.encoding) === 'utf8';
+    const data = await (utf8 ?
+      binding.readFileUtf8(path, flagsNumber, kUsePromises) :
+      binding.readFileBuffer(path, flagsNumber, kUsePromises));
+    // The binding reports the size of files that are too large instead.
+    if (typeof data === 'number')
+      throw new ERR_FS_FILE_TOO_LARGE(data);
+    return options.encoding && !utf8 ? data.toString(options.encoding) : data;
+  }
+
   const fd = await open(path, flag, 0o666);
   return handleFdClose(readFileHandle(fd, options), fd.close);
 }
@@ -894,6 +935,7 @@ module.exports = {
     symlink,
     lstat,
     stat,
+    statMany,
     link,
     unlink,
     chmod,
@@ -907,6 +949,7 @@ module.exports = {
     writeFile,
     appendFile,
     readFile,
+    walk,
     watch,
     constants,
   },
@@ -2,6 +2,8 @@
 
 const {
   Array,
+  ArrayPrototypePush,
+  ArrayPrototypeShift,
   FunctionPrototypeBind,
   MathMin,
   ObjectDefineProperty,
@@ -12,9 +14,11 @@ const {
 } = primordials;
 
 const {
+  ERR_INCOMPATIBLE_OPTION_PAIR,
   ERR_INVALID_ARG_TYPE,
   ERR_OUT_OF_RANGE,
   ERR_METHOD_NOT_IMPLEMENTED,
+  ERR_STREAM_DESTROYED,
 } = require('internal/errors').codes;
 const {
   deprecate,
@@ -23,6 +27,7 @@ const {
 const {
   validateFunction,
   validateInteger,
+  validateUint32,
 } = require('internal/validators');
 const { errorOrDestroy } = require('internal/streams/destroy');
 const fs = require('fs');
@@ -32,15 +37,31 @@ const {
   copyObject,
   getOptions,
   getValidatedFd,
+  handleErrorFromBinding,
   validatePath,
 } = require('internal/fs/utils');
+const {
+  FileSink,
+  FSReqCallback,
+  adviseSequential,
+} = internalBinding('fs');
 const { Readable, Writable, finished } = require('stream');
 const { toPathIfFileURL } = require('internal/url');
+const { clearTimeout, setTimeout } = require('timers');
 const kIoDone = Symbol('kIoDone');
 const kIsPerformingIO = Symbol('kIsPerformingIO');
 
 const kFs = Symbol('kFs');
 const kHandle = Symbol('kHandle');
+const kBufferSize = Symbol('kBufferSize');
+const kFlushInterval = Symbol('kFlushInterval');
+const kFlushTimer = Symbol('kFlushTimer');
+const kFlushCallbacks = Symbol('kFlushCallbacks');
+const kSink = Symbol('kSink');
+const kReadAhead = Symbol('kReadAhead');
+const kReadAheadQueue = Symbol('kReadAheadQueue');
+const kReadAheadWaiting = Symbol('kReadAheadWaiting');
+const kReadAheadEnded = Symbol('kReadAheadEnded');
 
 function _construct(callback) {
   const stream = this;
@@ -100,6 +121,11 @@ const FileHandleOperations = (handle) => {
                            (r) => cb(null, r.bytesWritten, r.buffer),
                            (err) => cb(err, 0, buf));
     },
+    readv: (fd, buffers, pos, cb) => {
+      PromisePrototypeThen(handle.readv(buffers, pos),
+                           (r) => cb(null, r.bytesRead, r.buffers),
+                           (err) => cb(err, 0, buffers));
+    },
     writev: (fd, buffers, pos, cb) => {
       PromisePrototypeThen(handle.writev(buffers, pos),
                            (r) => cb(null, r.bytesWritten, r.buffers),
@@ -209,6 +235,19 @@ function ReadStream(path, options) {
     }
   }
 
+  this[kReadAhead] = 0;
+  if (options.readAhead !== undefined) {
+    validateUint32(options.readAhead, 'options.readAhead');
+    this[kReadAhead] = options.readAhead;
+  }
+  if (this[kReadAhead] > 0) {
+    if (options.fs)
+      throw new ERR_INCOMPATIBLE_OPTION_PAIR('readAhead', 'fs');
+    this[kReadAheadQueue] = [];
+    this[kReadAheadWaiting] = false;
+    this[kReadAheadEnded] = false;
+  }
+
   ReflectApply(Readable, this, [options]);
 }
 ObjectSetPrototypeOf(ReadStream.prototype, Readable.prototype);
@@ -231,7 +270,107 @@ ReadStream.prototype.open = openReadFs;
 
 ReadStream.prototype._construct = _construct;
 
+// With the readAhead option, up to that many chunks are read with a single
+// vectored read, and the next batch is requested once half of the previous
+// one has been consumed, so that reading the file overlaps with consuming it.
+function readAhead(stream, n) {
+  const queue = stream[kReadAheadQueue];
+  if (queue.length > 0) {
+    stream.push(ArrayPrototypeShift(queue));
+  } else {
+    stream[kReadAheadWaiting] = true;
+  }
+  if (!stream[kIsPerformingIO] && !stream[kReadAheadEnded] &&
+      queue.length <= stream[kReadAhead] / 2) {
+    fillReadAhead(stream, n);
+  }
+}
+
+function fillReadAhead(stream, n) {
+  let remaining = stream.pos !== undefined ?
+    stream.end - stream.pos + 1 :
+    stream.end - stream.bytesRead + 1;
+  const queue = stream[kReadAheadQueue];
+
+  if (remaining <= 0) {
+    endReadAhead(stream);
+    return;
+  }
+
+  if (stream.bytesRead === 0) {
+    adviseSequential(stream.fd, stream.pos ?? 0,
+                     remaining === Infinity ? 0 : remaining);
+  }
+
+  const buffers = [];
+  for (let i = 0; i < stream[kReadAhead] && remaining > 0; i++) {
+    const size = MathMin(n, remaining);
+    ArrayPrototypePush(buffers, Buffer.allocUnsafeSlow(size));
+    remaining -= size;
+  }
+
+  stream[kIsPerformingIO] = true;
+  stream[kFs].readv(stream.fd, buffers, stream.pos, (er, bytesRead) => {
+    stream[kIsPerformingIO] = false;
+
+    // Tell ._destroy() that it's safe to close the fd now.
+    if (stream.destroyed) {
+      stream.emit(kIoDone, er);
+      return;
+    }
+
+    if (er) {
+      errorOrDestroy(stream, er);
+      return;
+    }
+
+    if (bytesRead === 0) {
+      endReadAhead(stream);
+      return;
+    }
+
+    if (stream.pos !== undefined) {
+      stream.pos += bytesRead;
+    }
+    stream.bytesRead += bytesRead;
+
+    // A short read does not mean that the end of the file has been reached,
+    // as the file may be growing, so only a read of 0 bytes ends the stream.
+    for (let i = 0; i < buffers.length && bytesRead > 0; i++) {
+      let buf = buffers[i];
+      if (bytesRead < buf.length) {
+        // Copy instead of slice so that we don't retain
+        // large backing buffer for small reads.
+        const dst = Buffer.allocUnsafeSlow(bytesRead);
+        buf.copy(dst, 0, 0, bytesRead);
+        buf = dst;
+      }
+      ArrayPrototypePush(queue, buf);
+      bytesRead -= buf.length;
+    }
+
+    if (stream[kReadAheadWaiting]) {
+      stream[kReadAheadWaiting] = false;
+      readAhead(stream, n);
+    }
+  });
+}
+
+function endReadAhead(stream) {
+  stream[kReadAheadEnded] = true;
+  ArrayPrototypePush(stream[kReadAheadQueue], null);
+  if (stream[kReadAheadWaiting]) {
+    stream[kReadAheadWaiting] = false;
+    stream.push(ArrayPrototypeShift(stream[kReadAheadQueue]));
+  }
+}
+
 ReadStream.prototype._read = function(n) {
+  if (this[kReadAhead] > 0) {
+    readAhead(this, n);
+    return;
+  }
+
   n = this.pos !== undefined ?
     MathMin(this.end - this.pos + 1, n) :
     MathMin(this.end - this.bytesRead + 1, n);
@@ -367,6 +506,23 @@ function WriteStream(path, options) {
     this.pos = this.start;
   }
 
+  this[kBufferSize] = 0;
+  if (options.bufferSize !== undefined) {
+    validateUint32(options.bufferSize, 'options.bufferSize');
+    this[kBufferSize] = options.bufferSize;
+  }
+  if (this[kBufferSize] > 0) {
+    if (options.fs)
+      throw new ERR_INCOMPATIBLE_OPTION_PAIR('bufferSize', 'fs');
+    const { flushInterval = 100 } = options;
+    validateUint32(flushInterval, 'options.flushInterval');
+    this[kFlushInterval] = flushInterval;
+    this[kFlushTimer] = null;
+    this[kFlushCallbacks] = [];
+    this[kSink] = undefined;
+    options.final = finalBuffered;
+  }
+
   ReflectApply(Writable, this, [options]);
 
   if (options.encoding)
@@ -392,7 +548,96 @@ WriteStream.prototype.open = openWriteFs;
 
 WriteStream.prototype._construct = _construct;
 
+// With the bufferSize option, writes are copied into a native FileSink and
+// reach the file in batches, either once half of the buffer is in use or
+// after flushInterval milliseconds.
+function writeBuffered(stream, chunks, index, cb) {
+  stream[kSink] ??=
+    new FileSink(stream.fd, stream[kBufferSize], stream.pos ?? -1);
+  for (; index < chunks.length; index++) {
+    const chunk = chunks[index];
+    const copied = stream[kSink].write(chunk);
+    if (stream.pos !== undefined)
+      stream.pos += copied;
+    if (copied < chunk.length) {
+      // The buffer is full, so continue once a flush has made room.
+      chunks[index] = chunk.subarray(copied);
+      flushBuffered(stream, (er) => {
+        // The fd may be closed once a destroyed stream's flush is done.
+        if (er || stream.destroyed)
+          cb(er);
+        else
+          writeBuffered(stream, chunks, index, cb);
+      });
+      return;
+    }
+  }
+  maybeFlushBuffered(stream);
+  cb();
+}
+
+// Writes the buffered data on the thread pool, unless a flush is already in
+// progress. `cb` is called when the current or the new flush completes.
+function flushBuffered(stream, cb) {
+  if (cb !== undefined)
+    ArrayPrototypePush(stream[kFlushCallbacks], cb);
+  if (stream[kIsPerformingIO])
+    return;
+
+  clearTimeout(stream[kFlushTimer]);
+  stream[kFlushTimer] = null;
+  const req = new FSReqCallback();
+  req.oncomplete = (er, bytes) => {
+    stream[kIsPerformingIO] = false;
+    const callbacks = stream[kFlushCallbacks];
+    stream[kFlushCallbacks] = [];
+    if (!er)
+      stream.bytesWritten += bytes;
+    for (let i = 0; i < callbacks.length; i++)
+      callbacks[i](er);
+    if (er && callbacks.length === 0)
+      errorOrDestroy(stream, er);
+    if (stream.destroyed) {
+      // Tell ._destroy() that it's safe to close the fd now.
+      stream.emit(kIoDone, er);
+    } else if (!stream[kIsPerformingIO]) {
+      maybeFlushBuffered(stream);
+    }
+  };
+  stream[kIsPerformingIO] = true;
+  stream[kSink].flush(req);
+}
+
+function maybeFlushBuffered(stream) {
+  const buffered = stream[kSink].buffered();
+  if (buffered >= stream[kBufferSize] / 2) {
+    // Leave the other half of the buffer to new writes in the meantime.
+    flushBuffered(stream);
+  } else if (buffered > 0 && stream[kFlushTimer] === null) {
+    stream[kFlushTimer] =
+      setTimeout(flushBuffered, stream[kFlushInterval], stream);
+  }
+}
+
+function finalBuffered(cb) {
+  if (this[kSink] === undefined || this[kSink].buffered() === 0) {
+    cb();
+    return;
+  }
+  flushBuffered(this, (er) => {
+    if (er || this.destroyed)
+      cb(er);
+    else
+      ReflectApply(finalBuffered, this, [cb]);
+  });
+}
+
 WriteStream.prototype._write = function(data, encoding, cb) {
+  if (this[kBufferSize] > 0) {
+    writeBuffered(this, [data], 0, cb);
+    return;
+  }
+
   this[kIsPerformingIO] = true;
   this[kFs].write(this.fd, data, 0, data.length, this.pos, (er, bytes) => {
     this[kIsPerformingIO] = false;
@@ -426,6 +671,11 @@ WriteStream.prototype._writev = function(data, cb) {
     size += chunk.length;
   }
 
+  if (this[kBufferSize] > 0) {
+    writeBuffered(this, chunks, 0, cb);
+    return;
+  }
+
   this[kIsPerformingIO] = true;
   this[kFs].writev(this.fd, chunks, this.pos, (er, bytes) => {
     this[kIsPerformingIO] = false;
@@ -447,6 +697,18 @@ WriteStream.prototype._writev = function(data, cb) {
     this.pos += size;
 };
 
+// Writes that were accepted into the buffer still reach the file, so keep
+// flushing until the buffer is empty, or a flush fails, before closing the fd.
+function destroyBuffered(stream, err, cb) {
+  if (!err && stream[kSink]?.buffered() > 0) {
+    flushBuffered(stream, (er) => destroyBuffered(stream, er, cb));
+  } else if (stream[kIsPerformingIO]) {
+    stream.once(kIoDone, (er) => close(stream, err || er, cb));
+  } else {
+    close(stream, err, cb);
+  }
+}
+
 WriteStream.prototype._destroy = function(err, cb) {
   // Usually for async IO it is safe to close a file descriptor
   // even when there are pending operations. However, due to platform
@@ -454,7 +716,11 @@ WriteStream.prototype._destroy = function(err, cb) {
   // running in a thread pool. Therefore, file descriptors are not safe
   // to close while used in a pending read or write operation. Wait for
   // any pending IO (kIsPerformingIO) to complete (kIoDone).
-  if (this[kIsPerformingIO]) {
+  if (this[kBufferSize] > 0) {
+    clearTimeout(this[kFlushTimer]);
+    this[kFlushTimer] = null;
+    destroyBuffered(this, err, cb);
+  } else if (this[kIsPerformingIO]) {
     this.once(kIoDone, (er) => close(this, err || er, cb));
   } else {
     close(this, err, cb);
@@ -481,6 +747,26 @@ WriteStream.prototype.close = function(cb) {
   this.end();
 };
 
+/**
+ * Synchronously writes the data buffered because of the `bufferSize` option,
+ * for example before the process exits.
+ * @returns {void}
+ */
+WriteStream.prototype.flushSync = function() {
+  // The sink writes to its own copy of the fd, which may have been closed
+  // and reused by now.
+  if (this.destroyed)
+    throw new ERR_STREAM_DESTROYED('flushSync');
+  if (this[kSink] === undefined)
+    return;
+  clearTimeout(this[kFlushTimer]);
+  this[kFlushTimer] = null;
+  const ctx = {};
+  const bytes = this[kSink].flushSync(ctx);
+  handleErrorFromBinding(ctx);
+  this.bytesWritten += bytes;
+};
+
 // There is no shutdown() for files.
 WriteStream.prototype.destroySoon = WriteStream.prototype.end;
 
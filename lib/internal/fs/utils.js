@@ -1,6 +1,7 @@
 'use strict';
 
 const {
+  Array,
   ArrayIsArray,
   BigInt,
   Date,
@@ -50,6 +51,7 @@ const {
 const { toPathIfFileURL } = require('internal/url');
 const {
   validateAbortSignal,
+  validateArray,
   validateBoolean,
   validateFunction,
   validateInt32,
@@ -104,6 +106,8 @@ const {
     }
   }
 } = internalBinding('constants');
+const { kFsStatsFieldsNumber } = internalBinding('fs');
+const { UV_ENOENT } = internalBinding('uv');
 
 // The access modes can be any of F_OK, R_OK, W_OK or X_OK. Some might not be
 // available on specific systems. They can be used in combination as well
@@ -557,6 +561,40 @@ function getStatsFromBinding(stats, offset = 0) {
   );
 }
 
+/**
+ * @param {Array<string | Buffer | URL>} paths
+ * @returns {Array<string | Buffer>}
+ */
+const getValidatedPaths = hideStackFrames((paths) => {
+  validateArray(paths, 'paths');
+  const validated = new Array(paths.length);
+  for (let i = 0; i < paths.length; i++)
+    validated[i] = getValidatedPath(paths[i], `paths[${i}]`);
+  return validated;
+});
+
+/**
+ * Converts the result of binding.statMany() into one stats object per path.
+ * Missing paths are left undefined unless throwIfNoEntry is true.
+ * @param {Array<string | Buffer>} paths
+ * @param {[Float64Array | BigInt64Array, Int32Array]} result
+ * @param {boolean} throwIfNoEntry
+ * @returns {Array<BigIntStats | Stats | undefined>}
+ */
+function getStatsManyFromBinding(paths, result, throwIfNoEntry) {
+  const { 0: stats, 1: errors } = result;
+  const ret = new Array(paths.length);
+  for (let i = 0; i < paths.length; i++) {
+    const errno = errors[i];
+    if (errno === 0) {
+      ret[i] = getStatsFromBinding(stats, i * kFsStatsFieldsNumber);
+    } else if (throwIfNoEntry || errno !== UV_ENOENT) {
+      throw uvException({ errno, syscall: 'stat', path: paths[i] });
+    }
+  }
+  return ret;
+}
+
 function stringToFlags(flags, name = 'flags') {
   if (typeof flags === 'number') {
     validateInt32(flags, name);
@@ -723,6 +761,7 @@ function warnOnNonPortableTemplate(template) {
 }
 
 const defaultCpOptions = {
+  concurrency: 1,
   dereference: false,
   errorOnExist: false,
   filter: undefined,
@@ -756,6 +795,7 @@ const validateCpOptions = hideStackFrames((options) => {
   validateBoolean(options.preserveTimestamps, 'options.preserveTimestamps');
   validateBoolean(options.recursive, 'options.recursive');
   validateBoolean(options.verbatimSymlinks, 'options.verbatimSymlinks');
+  validateInteger(options.concurrency, 'options.concurrency', 1);
   if (options.dereference === true && options.verbatimSymlinks === true) {
     throw new ERR_INCOMPATIBLE_OPTION_PAIR('dereference', 'verbatimSymlinks');
   }
@@ -922,6 +962,8 @@ module.exports = {
   preprocessSymlinkDestination,
   realpathCacheKey: Symbol('realpathCacheKey'),
   getStatsFromBinding,
+  getStatsManyFromBinding,
+  getValidatedPaths,
   stringToFlags,
   stringToSymlinkType,
   Stats,
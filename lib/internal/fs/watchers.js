@@ -1,6 +1,8 @@
 'use strict';
 
 const {
+  ArrayPrototypePush,
+  ArrayPrototypeShift,
   FunctionPrototypeCall,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
@@ -21,7 +23,7 @@ const {
   StatWatcher: _StatWatcher
 } = internalBinding('fs');
 
-const { FSEvent } = internalBinding('fs_event_wrap');
+const { FSEvent, FSEventTree } = internalBinding('fs_event_wrap');
 const { UV_ENOSPC } = internalBinding('uv');
 const { EventEmitter } = require('events');
 
@@ -90,6 +92,13 @@ function onchange(newStatus, stats) {
             getStatsFromBinding(stats, kFsStatsFieldsNumber));
 }
 
+function newStatWatcherHandle(watcher, path) {
+  const handle = new _StatWatcher(watcher[kUseBigint], path);
+  handle[owner_symbol] = watcher;
+  handle.onchange = onchange;
+  return handle;
+}
+
 // At the moment if filename is undefined, we
 // 1. Throw an Error if it's the first
 //    time Symbol('kFSStatWatcherStart') is called
@@ -102,19 +111,27 @@ StatWatcher.prototype[kFSStatWatcherStart] = function(filename,
   if (this._handle !== null)
     return;
 
-  this._handle = new _StatWatcher(this[kUseBigint]);
-  this._handle[owner_symbol] = this;
-  this._handle.onchange = onchange;
-  if (!persistent)
-    this.unref();
+  filename = getValidatedPath(filename, 'filename');
+  validateUint32(interval, 'interval');
+  const path = toNamespacedPath(filename);
 
   // uv_fs_poll is a little more powerful than ev_stat but we curb it for
   // the sake of backwards compatibility.
   this[kOldStatus] = -1;
 
-  filename = getValidatedPath(filename, 'filename');
-  validateUint32(interval, 'interval');
-  const err = this._handle.start(toNamespacedPath(filename), interval);
+  // Where the platform and filesystem allow it, the handle waits for change
+  // notifications instead of polling. If they cannot be set up for this
+  // path, fall back to polling.
+  let handle = newStatWatcherHandle(this, path);
+  let err = handle.start(path, interval);
+  if (err) {
+    handle.close();
+    handle = newStatWatcherHandle(this);
+    err = handle.start(path, interval);
+  }
+  this._handle = handle;
+  if (!persistent)
+    this.unref();
   if (err) {
     const error = uvException({
       errno: err,
@@ -184,9 +201,14 @@ StatWatcher.prototype.unref = function() {
 };
 
 
-function FSWatcher() {
+function FSWatcher(recursive = false) {
   FunctionPrototypeCall(EventEmitter, this);
 
+  if (recursive && FSEventTree !== undefined) {
+    this._handle = newFSEventTree(this);
+    return;
+  }
+
   this._handle = new FSEvent();
   this._handle[owner_symbol] = this;
 
@@ -196,18 +218,7 @@ function FSWatcher() {
     // after the handle is closed, and to fire both UV_RENAME and UV_CHANGE
     // if they are set by libuv at the same time.
     if (status < 0) {
-      if (this._handle !== null) {
-        // We don't use this.close() here to avoid firing the close event.
-        this._handle.close();
-        this._handle = null;  // Make the handle garbage collectable.
-      }
-      const error = uvException({
-        errno: status,
-        syscall: 'watch',
-        path: filename
-      });
-      error.filename = filename;
-      this.emit('error', error);
+      onFSWatcherError(this, status, filename);
     } else {
       this.emit('change', eventType, filename);
     }
@@ -216,6 +227,45 @@ function FSWatcher() {
 ObjectSetPrototypeOf(FSWatcher.prototype, EventEmitter.prototype);
 ObjectSetPrototypeOf(FSWatcher, EventEmitter);
 
+function onFSWatcherError(watcher, status, filename) {
+  if (watcher._handle !== null) {
+    // We don't use this.close() here to avoid firing the close event.
+    watcher._handle.close();
+    watcher._handle = null;  // Make the handle garbage collectable.
+  }
+  const error = uvException({
+    errno: status,
+    syscall: 'watch',
+    path: filename
+  });
+  error.filename = filename;
+  watcher.emit('error', error);
+}
+
+function isFSEventHandle(handle) {
+  return handle instanceof FSEvent ||
+         (FSEventTree !== undefined && handle instanceof FSEventTree);
+}
+
+// FSEventTree watches a whole directory tree with one handle where
+// uv_fs_event_t cannot, and reports events in batches of
+// [eventType, filename, ...] pairs.
+function newFSEventTree(watcher) {
+  const handle = new FSEventTree();
+  handle[owner_symbol] = watcher;
+  handle.onchange = (status, events) => {
+    for (let i = 0; i < events.length; i += 2) {
+      // A listener may have closed the watcher.
+      if (watcher._handle !== handle)
+        return;
+      watcher.emit('change', events[i], events[i + 1]);
+    }
+    if (status < 0 && watcher._handle === handle)
+      onFSWatcherError(watcher, status, null);
+  };
+  return handle;
+}
+
 // At the moment if filename is undefined, we
 // 1. Throw an Error if it's the first time Symbol('kFSWatchStart') is called
 // 2. Return silently if Symbol('kFSWatchStart') has already been called
@@ -229,17 +279,22 @@ FSWatcher.prototype[kFSWatchStart] = function(filename,
   if (this._handle === null) {  // closed
     return;
   }
-  assert(this._handle instanceof FSEvent, 'handle must be a FSEvent');
+  assert(isFSEventHandle(this._handle), 'handle must be a FSEvent');
   if (this._handle.initialized) {  // already started
     return;
   }
 
   filename = getValidatedPath(filename, 'filename');
 
-  const err = this._handle.start(toNamespacedPath(filename),
-                                 persistent,
-                                 recursive,
-                                 encoding);
+  let err;
+  if (FSEventTree !== undefined && this._handle instanceof FSEventTree) {
+    err = this._handle.start(toNamespacedPath(filename), persistent, encoding);
+  } else {
+    err = this._handle.start(toNamespacedPath(filename),
+                             persistent,
+                             recursive,
+                             encoding);
+  }
   if (err) {
     const error = uvException({
       errno: err,
@@ -265,7 +320,7 @@ FSWatcher.prototype.close = function() {
   if (this._handle === null) {  // closed
     return;
   }
-  assert(this._handle instanceof FSEvent, 'handle must be a FSEvent');
+  assert(isFSEventHandle(this._handle), 'handle must be a FSEvent');
   if (!this._handle.initialized) {  // not started
     return;
   }
@@ -319,7 +374,11 @@ async function* watch(filename, options = {}) {
   if (signal?.aborted)
     throw new AbortError(undefined, { cause: signal?.reason });
 
-  const handle = new FSEvent();
+  const handle = recursive && FSEventTree !== undefined ?
+    new FSEventTree() : new FSEvent();
+  // Events that arrive while the consumer is busy are queued, as a tree
+  // watcher can deliver many of them at once.
+  const queue = [];
   let { promise, resolve, reject } = createDeferredPromise();
   const oncancel = () => {
     handle.close();
@@ -328,7 +387,7 @@ async function* watch(filename, options = {}) {
 
   try {
     signal?.addEventListener('abort', oncancel, { once: true });
-    handle.onchange = (status, eventType, filename) => {
+    const onchange = (status, eventType, filename) => {
       if (status < 0) {
         const error = uvException({
           errno: status,
@@ -341,10 +400,23 @@ async function* watch(filename, options = {}) {
         return;
       }
 
-      resolve({ eventType, filename });
+      ArrayPrototypePush(queue, { eventType, filename });
+      resolve();
     };
 
-    const err = handle.start(path, persistent, recursive, encoding);
+    let err;
+    if (handle instanceof FSEvent) {
+      handle.onchange = onchange;
+      err = handle.start(path, persistent, recursive, encoding);
+    } else {
+      handle.onchange = (status, events) => {
+        for (let i = 0; i < events.length; i += 2)
+          onchange(0, events[i], events[i + 1]);
+        if (status < 0)
+          onchange(status);
+      };
+      err = handle.start(path, persistent, encoding);
+    }
     if (err) {
       const error = uvException({
         errno: err,
@@ -359,8 +431,10 @@ async function* watch(filename, options = {}) {
     }
 
     while (!signal?.aborted) {
-      yield await promise;
+      await promise;
       ({ promise, resolve, reject } = createDeferredPromise());
+      while (queue.length > 0 && !signal?.aborted)
+        yield ArrayPrototypeShift(queue);
     }
     throw new AbortError(undefined, { cause: signal?.reason });
   } finally {
@@ -94,14 +94,14 @@ function supportedInUserSnapshot(id) {
   return supportedModules.has(id);
 }
 
+let requireForUserModules;
 function requireForUserSnapshot(id) {
   if (!BuiltinModule.canBeRequiredByUsers(id)) {
-    // eslint-disable-next-line no-restricted-syntax
-    const err = new Error(
-      `Cannot find module '${id}'. `
-    );
-    err.code = 'MODULE_NOT_FOUND';
-    throw err;
+    // User-land modules are loaded by the CommonJS loader, so that the whole
+    // module graph ends up in the snapshot together with the loader's
+    // caches. require() calls made after deserialization then find the
+    // modules in the cache.
+    return requireForUserModules(id);
   }
   if (!supportedInUserSnapshot(id)) {
     if (!warnedModules.has(id)) {
@@ -126,6 +126,8 @@ function main() {
   const filename = path.resolve(file);
   const dirname = path.dirname(filename);
   const source = readFileSync(file, 'utf-8');
+  const { Module } = require('internal/modules/cjs/loader');
+  requireForUserModules = Module.createRequire(filename);
   const serializeMainFunction = compileSerializeMain(filename, source);
 
   const {
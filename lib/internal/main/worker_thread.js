@@ -26,6 +26,8 @@ const {
   initializeDeprecations,
   initializeWASI,
   initializeCJSLoader,
+  initializeCompileCache,
+  initializeResolveCache,
   initializeESMLoader,
   initializeFrozenIntrinsics,
   initializeReport,
@@ -137,6 +139,8 @@ port.on('message', (message) => {
 
     require('internal/dns/utils').initializeDns();
 
+    initializeResolveCache();
+    initializeCompileCache();
     initializeCJSLoader();
     initializeESMLoader();
 
@@ -71,6 +71,7 @@ const cjsParseCache = new SafeWeakMap();
 // Set first due to cycle with ESM loader functions.
 module.exports = {
   wrapSafe, Module, toRealPath, readPackageScope, cjsParseCache,
+  initializeResolveCache,
   get hasLoadedAnyUserCJSModule() { return hasLoadedAnyUserCJSModule; }
 };
 
@@ -87,6 +88,7 @@ const {
   setOwnProperty,
 } = require('internal/util');
 const vm = require('vm');
+const { internalCompileFunction } = require('internal/vm');
 const assert = require('internal/assert');
 const fs = require('fs');
 const internalFS = require('internal/fs/utils');
@@ -147,6 +149,12 @@ const {
   packageImportsResolve
 } = require('internal/modules/esm/resolve');
 
+// The persistent resolution cache, loaded by initializeResolveCache() only
+// when NODE_RESOLVE_CACHE is set.
+let resolveCache = null;
+// Whether stat() and readPackage() report what they consult to resolveCache.
+let isRecordingResolution = false;
+
 const isWindows = process.platform === 'win32';
 
 const relativeResolveCache = ObjectCreate(null);
@@ -156,6 +164,8 @@ let statCache = null;
 let isPreloading = false;
 
 function stat(filename) {
+  if (isRecordingResolution)
+    resolveCache.addDependency(path.dirname(filename));
   filename = path.toNamespacedPath(filename);
   if (statCache !== null) {
     const result = statCache.get(filename);
@@ -325,32 +335,41 @@ const packageJsonCache = new SafeMap();
 
 function readPackage(requestPath) {
   const jsonPath = path.resolve(requestPath, 'package.json');
+  if (isRecordingResolution)
+    resolveCache.addDependency(jsonPath);
 
   const existing = packageJsonCache.get(jsonPath);
   if (existing !== undefined) return existing;
 
   const result = packageJsonReader.read(jsonPath);
-  const json = result.containsKeys === false ? '{}' : result.string;
-  if (json === undefined) {
+  if (!result.exists) {
     packageJsonCache.set(jsonPath, false);
     return false;
   }
 
-  try {
-    const filtered = filterOwnProperties(JSONParse(json), [
-      'name',
-      'main',
-      'exports',
-      'imports',
-      'type',
-    ]);
-    packageJsonCache.set(jsonPath, filtered);
-    return filtered;
-  } catch (e) {
-    e.path = jsonPath;
-    e.message = 'Error parsing ' + jsonPath + ': ' + e.message;
-    throw e;
+  let filtered = result.data;
+  if (filtered === undefined) {
+    // Files that do not mention any of the fields are not parsed.
+    if (!result.containsKeys) {
+      filtered = { __proto__: null };
+    } else {
+      try {
+        filtered = filterOwnProperties(JSONParse(result.source), [
+          'name',
+          'main',
+          'exports',
+          'imports',
+          'type',
+        ]);
+      } catch (e) {
+        e.path = jsonPath;
+        e.message = 'Error parsing ' + jsonPath + ': ' + e.message;
+        throw e;
+      }
+    }
   }
+  packageJsonCache.set(jsonPath, filtered);
+  return filtered;
 }
 
 let _readPackage = readPackage;
@@ -551,6 +570,39 @@ Module._findPath = function(request, paths, isMain) {
   if (entry)
     return entry;
 
+  // The persistent cache relies on seeing every stat() and package.json read
+  // of the resolution, so it is bypassed when these have been monkey-patched.
+  if (resolveCache === null || _stat !== stat ||
+      _readPackage !== readPackage) {
+    return findPath(request, paths, isMain, absoluteRequest, cacheKey);
+  }
+
+  const persistentKey = cacheKey + '\x00' +
+    ArrayPrototypeJoin(ObjectKeys(Module._extensions), '\x00');
+  const cached = resolveCache.get(persistentKey);
+  if (cached !== undefined) {
+    Module._pathCache[cacheKey] = cached;
+    return cached;
+  }
+
+  let filename = false;
+  resolveCache.startRecording();
+  isRecordingResolution = true;
+  try {
+    filename = findPath(request, paths, isMain, absoluteRequest, cacheKey);
+  } finally {
+    isRecordingResolution = false;
+    resolveCache.finishRecording(persistentKey, filename);
+  }
+  return filename;
+};
+
+function initializeResolveCache(file) {
+  resolveCache = require('internal/modules/cjs/resolve_cache');
+  resolveCache.initializeResolveCache(file);
+}
+
+function findPath(request, paths, isMain, absoluteRequest, cacheKey) {
   let exts;
   let trailingSlash = request.length > 0 &&
     StringPrototypeCharCodeAt(request, request.length - 1) ===
@@ -620,7 +672,7 @@ Module._findPath = function(request, paths, isMain) {
   }
 
   return false;
-};
+}
 
 // 'node_modules' character codes reversed
 const nmChars = [ 115, 101, 108, 117, 100, 111, 109, 95, 101, 100, 111, 110 ];
@@ -1085,7 +1137,7 @@ function wrapSafe(filename, content, cjsModuleInstance) {
     });
   }
   try {
-    return vm.compileFunction(content, [
+    return internalCompileFunction(content, [
       'exports',
       'require',
       'module',
@@ -1098,6 +1150,7 @@ function wrapSafe(filename, content, cjsModuleInstance) {
         return loader.import(specifier, normalizeReferrerURL(filename),
                              importAssertions);
       },
+      useCompileCache: true,
     });
   } catch (err) {
     if (process.mainModule === cjsModuleInstance)
@@ -0,0 +1,223 @@
+'use strict';
+
+// A cache of Module._findPath() results that is persisted across processes
+// when NODE_RESOLVE_CACHE is set. Every entry remembers the directories and
+// package.json files that were consulted while the request was resolved, and
+// is only used while none of them has been modified since, so that a warm
+// start only needs one stat() per directory instead of one per candidate
+// file name.
+
+const {
+  ArrayPrototypeJoin,
+  ArrayPrototypeMap,
+  ArrayPrototypePush,
+  JSONParse,
+  JSONStringify,
+  SafeMap,
+  SafeSet,
+  StringPrototypeIndexOf,
+  StringPrototypeSlice,
+} = primordials;
+
+const fs = require('fs');
+const path = require('path');
+const { getOptionValue } = require('internal/options');
+const { isMainThread } = internalBinding('worker');
+
+let debug = require('internal/util/debuglog').debuglog('module', (fn) => {
+  debug = fn;
+});
+
+const kFormatVersion = 1;
+
+let cacheFile;
+let header;
+// Lookup key -> { filename, deps }, where deps is an array of dependency
+// records { path, mtimeMs, ctimeMs, valid }.
+let entries = null;
+// Path -> dependency record describing the current state of the path,
+// computed at most once per process.
+const currentDeps = new SafeMap();
+let dirty = false;
+// Paths consulted by the resolution that is being recorded, if any.
+let recording = null;
+
+function getHeader() {
+  const { cjsConditions } = require('internal/modules/cjs/helpers');
+  return ArrayPrototypeJoin([
+    process.version,
+    process.platform,
+    getOptionValue('--preserve-symlinks'),
+    getOptionValue('--preserve-symlinks-main'),
+    ArrayPrototypeJoin([...cjsConditions], ','),
+  ], '\x00');
+}
+
+function getCurrentDep(filename) {
+  let dep = currentDeps.get(filename);
+  if (dep === undefined) {
+    const stats = fs.statSync(filename, { throwIfNoEntry: false });
+    dep = {
+      path: filename,
+      mtimeMs: stats?.mtimeMs ?? -1,
+      ctimeMs: stats?.ctimeMs ?? -1,
+      valid: true,
+    };
+    currentDeps.set(filename, dep);
+  }
+  return dep;
+}
+
+function isUnchanged(dep) {
+  if (dep.valid === undefined) {
+    const current = getCurrentDep(dep.path);
+    dep.valid = current.mtimeMs === dep.mtimeMs &&
+                current.ctimeMs === dep.ctimeMs;
+  }
+  return dep.valid;
+}
+
+function readCacheFile() {
+  let data;
+  try {
+    data = JSONParse(fs.readFileSync(cacheFile, 'utf8'));
+  } catch (err) {
+    if (err.code !== 'ENOENT')
+      debug('ignoring resolution cache %s: %s', cacheFile, err.message);
+    return;
+  }
+  if (data?.version !== kFormatVersion || data.header !== header) {
+    debug('ignoring outdated resolution cache %s', cacheFile);
+    dirty = true;
+    return;
+  }
+  const deps = ArrayPrototypeMap(data.deps, (dep) => {
+    return { path: dep[0], mtimeMs: dep[1], ctimeMs: dep[2], valid: undefined };
+  });
+  const { lookups } = data;
+  for (let i = 0; i < data.entries.length; i++) {
+    const { 0: request, 1: lookup, 2: filename, 3: depIndices } =
+      data.entries[i];
+    entries.set(request + '\x00' + lookups[lookup], {
+      filename,
+      deps: ArrayPrototypeMap(depIndices, (index) => deps[index]),
+    });
+  }
+  debug('loaded %d entries from resolution cache %s',
+        entries.size, cacheFile);
+}
+
+function writeCacheFile() {
+  if (!dirty) return;
+  const lookups = [];
+  const lookupIndices = new SafeMap();
+  const deps = [];
+  const depIndices = new SafeMap();
+  const serialized = [];
+  for (const { 0: key, 1: entry } of entries) {
+    // Keys are the request followed by the lookup paths, and requests never
+    // contain a NUL character.
+    const separator = StringPrototypeIndexOf(key, '\x00');
+    const request = StringPrototypeSlice(key, 0, separator);
+    const lookup = StringPrototypeSlice(key, separator + 1);
+    let lookupIndex = lookupIndices.get(lookup);
+    if (lookupIndex === undefined) {
+      lookupIndex = ArrayPrototypePush(lookups, lookup) - 1;
+      lookupIndices.set(lookup, lookupIndex);
+    }
+    ArrayPrototypePush(serialized, [
+      request,
+      lookupIndex,
+      entry.filename,
+      ArrayPrototypeMap(entry.deps, (dep) => {
+        const depKey = `${dep.path}\x00${dep.mtimeMs}\x00${dep.ctimeMs}`;
+        let index = depIndices.get(depKey);
+        if (index === undefined) {
+          index = ArrayPrototypePush(
+            deps, [dep.path, dep.mtimeMs, dep.ctimeMs]) - 1;
+          depIndices.set(depKey, index);
+        }
+        return index;
+      }),
+    ]);
+  }
+  const tmpFile = `${cacheFile}.${process.pid}.tmp`;
+  try {
+    fs.mkdirSync(path.dirname(cacheFile), { recursive: true });
+    fs.writeFileSync(tmpFile, JSONStringify({
+      version: kFormatVersion,
+      header,
+      lookups,
+      deps,
+      entries: serialized,
+    }));
+    fs.renameSync(tmpFile, cacheFile);
+    debug('wrote %d entries to resolution cache %s', entries.size, cacheFile);
+  } catch (err) {
+    debug('cannot write resolution cache %s: %s', cacheFile, err.message);
+    try {
+      fs.unlinkSync(tmpFile);
+    } catch {
+      // Ignore.
+    }
+  }
+}
+
+function initializeResolveCache(file) {
+  cacheFile = path.resolve(file);
+  header = getHeader();
+  entries = new SafeMap();
+  readCacheFile();
+  // Workers only read the cache, to avoid racing with the main thread.
+  if (isMainThread) {
+    process.on('exit', writeCacheFile);
+  }
+}
+
+// Returns the cached file name for `key`, or undefined when there is no
+// entry or any of the paths it depends on has changed.
+function get(key) {
+  const entry = entries.get(key);
+  if (entry === undefined) return undefined;
+  const { deps } = entry;
+  for (let i = 0; i < deps.length; i++) {
+    if (!isUnchanged(deps[i])) {
+      debug('resolution cache entry for %s is outdated', entry.filename);
+      entries.delete(key);
+      dirty = true;
+      return undefined;
+    }
+  }
+  return entry.filename;
+}
+
+function startRecording() {
+  recording = new SafeSet();
+}
+
+function addDependency(filename) {
+  recording.add(filename);
+}
+
+// Stops recording and, if `filename` was found, stores it for `key` together
+// with the current state of all the paths that were consulted.
+function finishRecording(key, filename) {
+  const consulted = recording;
+  recording = null;
+  if (typeof filename !== 'string') return;
+  consulted.add(path.dirname(filename));
+  const deps = [];
+  for (const consultedPath of consulted) {
+    ArrayPrototypePush(deps, getCurrentDep(consultedPath));
+  }
+  entries.set(key, { filename, deps });
+  dirty = true;
+}
+
+module.exports = {
+  addDependency,
+  finishRecording,
+  get,
+  initializeResolveCache,
+  startRecording,
+};
@@ -20,7 +20,6 @@ const experimentalNetworkImports =
 
 const { Buffer: { from: BufferFrom } } = require('buffer');
 
-const { readFile: readFileAsync } = require('internal/fs/promises').exports;
 const { URL } = require('internal/url');
 const {
   ERR_INVALID_URL,
@@ -34,6 +33,7 @@ async function getSource(url, context) {
   let responseURL = url;
   let source;
   if (parsed.protocol === 'file:') {
+    const { readFile: readFileAsync } = require('internal/fs/promises').exports;
     source = await readFileAsync(parsed);
   } else if (parsed.protocol === 'data:') {
     const match = RegExpPrototypeExec(DATA_URL_PATTERN, parsed.pathname);
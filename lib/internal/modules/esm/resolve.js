@@ -1,6 +1,7 @@
 'use strict';
 
 const {
+  ArrayFrom,
   ArrayIsArray,
   ArrayPrototypeConcat,
   ArrayPrototypeJoin,
@@ -62,6 +63,7 @@ const {
 const { Module: CJSModule } = require('internal/modules/cjs/loader');
 const packageJsonReader = require('internal/modules/package_json_reader');
 const { getPackageConfig, getPackageScopeConfig } = require('internal/modules/esm/package_config');
+const { resolve: nativeResolve } = internalBinding('module_wrap');
 
 /**
  * @typedef {import('internal/modules/esm/package_config.js').PackageConfig} PackageConfig
@@ -268,7 +270,7 @@ function resolveDirectoryEntry(search) {
   if (fileExists(pkgJsonPath)) {
     const pkgJson = packageJsonReader.read(pkgJsonPath);
     if (pkgJson.containsKeys) {
-      const { main } = JSONParse(pkgJson.string);
+      const { main } = pkgJson.data ?? JSONParse(pkgJson.source);
       if (main != null) {
         const mainUrl = pathToFileURL(resolve(dirPath, main));
         return resolveExtensionsWithTryExactName(mainUrl);
@@ -882,6 +884,52 @@ function shouldBeTreatedAsRelativeOrAbsolutePath(specifier) {
   return isRelativeSpecifier(specifier);
 }
 
+// The native resolver works on POSIX paths, and does not know about the
+// policy manifest or the extension searching of
+// --experimental-specifier-resolution=node.
+const useNativeResolve = process.platform !== 'win32' && policy === null &&
+  getOptionValue('--experimental-specifier-resolution') !== 'node';
+/** @type {Map<string, string | null>} */
+const parentPathCache = new SafeMap();
+
+/**
+ * Resolves `specifier` with the native resolver, which handles the common
+ * cases without creating URL objects. Returns undefined when the JS
+ * implementation has to resolve it, e.g. to throw an error or emit a
+ * deprecation warning.
+ * @param {string} specifier
+ * @param {string} base
+ * @param {Set<string>} conditions
+ * @param {boolean} preserveSymlinks
+ * @returns {URL | undefined}
+ */
+function tryNativeResolve(specifier, base, conditions, preserveSymlinks) {
+  if (!useNativeResolve || !StringPrototypeStartsWith(base, 'file:'))
+    return undefined;
+  if (BuiltinModule.canBeRequiredByUsers(specifier) &&
+      BuiltinModule.canBeRequiredWithoutScheme(specifier))
+    return undefined;
+
+  let parentPath = parentPathCache.get(base);
+  if (parentPath === undefined) {
+    try {
+      parentPath = fileURLToPath(base);
+    } catch {
+      parentPath = null;
+    }
+    parentPathCache.set(base, parentPath);
+  }
+  if (parentPath === null) return undefined;
+
+  const resolved = nativeResolve(
+    specifier,
+    parentPath,
+    conditions === DEFAULT_CONDITIONS_SET ?
+      DEFAULT_CONDITIONS : ArrayFrom(conditions),
+    preserveSymlinks);
+  return resolved === undefined ? undefined : pathToFileURL(resolved);
+}
+
 /**
  * @param {string} specifier
  * @param {string | URL | undefined} base
@@ -890,6 +938,22 @@ function shouldBeTreatedAsRelativeOrAbsolutePath(specifier) {
  * @returns {url: URL, format?: string}
  */
 function moduleResolve(specifier, base, conditions, preserveSymlinks) {
+  const nativeResolved =
+    tryNativeResolve(specifier, base, conditions, preserveSymlinks);
+  if (nativeResolved !== undefined) return nativeResolved;
+  return jsModuleResolve(specifier, base, conditions, preserveSymlinks);
+}
+
+/**
+ * The JS implementation of moduleResolve(), which the native resolver has to
+ * agree with.
+ * @param {string} specifier
+ * @param {string | URL | undefined} base
+ * @param {Set<string>} conditions
+ * @param {boolean} preserveSymlinks
+ * @returns {url: URL, format?: string}
+ */
+function jsModuleResolve(specifier, base, conditions, preserveSymlinks) {
   const isRemote = base.protocol === 'http:' ||
     base.protocol === 'https:';
   // Order swapped from spec for minor perf gain.
@@ -1164,6 +1228,7 @@ module.exports = {
   encodedSepRegEx,
   getPackageScopeConfig,
   getPackageType,
+  jsModuleResolve,
   packageExportsResolve,
   packageImportsResolve,
 };
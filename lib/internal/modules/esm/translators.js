@@ -49,7 +49,7 @@ const {
 } = require('internal/errors').codes;
 const { maybeCacheSourceMap } = require('internal/source_map/source_map_cache');
 const moduleWrap = internalBinding('module_wrap');
-const { ModuleWrap } = moduleWrap;
+const { ModuleWrap, ModuleCompileJob } = moduleWrap;
 const asyncESM = require('internal/process/esm_loader');
 const { emitWarningSync } = require('internal/process/warning');
 const { TextDecoder } = require('internal/encoding');
@@ -116,7 +116,12 @@ translators.set('module', async function moduleStrategy(url, source, isMain) {
   source = stringify(source);
   maybeCacheSourceMap(url, source);
   debug(`Translating StandardModule ${url}`);
-  const module = new ModuleWrap(url, undefined, source, 0, 0);
+  // Parse the source on the thread pool, so that the other modules of the
+  // graph can be fetched and parsed in the meantime.
+  const job = new ModuleCompileJob(url, source, true);
+  await job.run();
+  const module =
+    new ModuleWrap(url, undefined, source, 0, 0, undefined, true, job);
   moduleWrap.callbackMap.set(module, {
     initializeImportMeta: (meta, wrap) => this.importMetaInitialize(meta, { url }),
     importModuleDynamically,
@@ -1,37 +1,113 @@
 'use strict';
 
-const { SafeMap } = primordials;
-const { internalModuleReadJSON } = internalBinding('fs');
+const {
+  JSONParse,
+  ObjectCreate,
+  SafeMap,
+} = primordials;
+const { internalModuleReadPackageJSON } = internalBinding('fs');
 const { pathToFileURL } = require('url');
 const { toNamespacedPath } = require('path');
+const { filterOwnProperties } = require('internal/util');
+
+// Keep in sync with package_json::PackageJson::Flags in
+// src/node_package_json.h.
+const kContainsKeys = 1 << 0;
+const kNeedsParse = 1 << 1;
+const kRawName = 1 << 2;
+const kRawMain = 1 << 3;
+const kRawType = 1 << 4;
 
 const cache = new SafeMap();
 
 let manifest;
 
 /**
- *
+ * @typedef {{
+ *   exists: boolean,
+ *   containsKeys: boolean,
+ *   data?: {
+ *     name?: unknown,
+ *     main?: unknown,
+ *     exports?: unknown,
+ *     imports?: unknown,
+ *     type?: unknown,
+ *   },
+ *   source?: string,
+ * }} PackageJSONResult
+ * `data` holds the fields of the file that are used by the module resolvers.
+ * If the file cannot be parsed, `data` is undefined and `source` contains the
+ * file, so that callers can report the error in their own way.
+ */
+
+/**
  * @param {string} jsonPath
+ * @returns {PackageJSONResult}
  */
 function read(jsonPath) {
   if (cache.has(jsonPath)) {
     return cache.get(jsonPath);
   }
 
-  const { 0: string, 1: containsKeys } = internalModuleReadJSON(
-    toNamespacedPath(jsonPath)
-  );
-  const result = { string, containsKeys };
-  const { getOptionValue } = require('internal/options');
-  if (string !== undefined) {
-    if (manifest === undefined) {
-      manifest = getOptionValue('--experimental-policy') ?
-        require('internal/process/policy').manifest :
-        null;
-    }
+  if (manifest === undefined) {
+    const { getOptionValue } = require('internal/options');
+    manifest = getOptionValue('--experimental-policy') ?
+      require('internal/process/policy').manifest :
+      null;
+  }
+
+  // The file is parsed in C++, and only the fields that are needed are
+  // passed back. The source is only needed for policy integrity checks.
+  const raw = internalModuleReadPackageJSON(toNamespacedPath(jsonPath),
+                                            manifest !== null);
+  let result;
+  if (raw === undefined) {
+    result = { exists: false, containsKeys: false };
+  } else {
+    const {
+      0: flags,
+      1: name,
+      2: main,
+      3: type,
+      4: exports,
+      5: imports,
+      6: source,
+    } = raw;
     if (manifest !== null) {
       const jsonURL = pathToFileURL(jsonPath);
-      manifest.assertIntegrity(jsonURL, string);
+      manifest.assertIntegrity(jsonURL, source);
+    }
+    result = {
+      exists: true,
+      containsKeys: (flags & kContainsKeys) !== 0,
+      data: undefined,
+      source: undefined,
+    };
+    if (flags & kNeedsParse) {
+      try {
+        result.data = filterOwnProperties(JSONParse(source), [
+          'name',
+          'main',
+          'exports',
+          'imports',
+          'type',
+        ]);
+      } catch {
+        result.source = source;
+      }
+    } else {
+      const data = ObjectCreate(null);
+      if (name !== undefined)
+        data.name = flags & kRawName ? JSONParse(name) : name;
+      if (main !== undefined)
+        data.main = flags & kRawMain ? JSONParse(main) : main;
+      if (exports !== undefined)
+        data.exports = JSONParse(exports);
+      if (imports !== undefined)
+        data.imports = JSONParse(imports);
+      if (type !== undefined)
+        data.type = flags & kRawType ? JSONParse(type) : type;
+      result.data = data;
     }
   }
   cache.set(jsonPath, result);
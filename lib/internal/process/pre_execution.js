@@ -98,6 +98,8 @@ function prepareMainThreadExecution(expandArgv1 = false,
     return;
   }
 
+  initializeResolveCache();
+  initializeCompileCache();
   initializeCJSLoader();
   initializeESMLoader();
   const CJSLoader = require('internal/modules/cjs/loader');
@@ -539,6 +541,25 @@ function initializeWASI() {
     getOptionValue('--experimental-wasi-unstable-preview1');
 }
 
+function initializeCompileCache() {
+  const dir = process.env.NODE_COMPILE_CACHE;
+  if (!dir) return;
+  const { enableCompileCache } = internalBinding('contextify');
+  const err = enableCompileCache(require('path').resolve(dir));
+  if (err !== 0) {
+    const { uvErrmapGet } = require('internal/errors');
+    const { 0: code, 1: message } = uvErrmapGet(err) || ['UNKNOWN', 'unknown'];
+    process.emitWarning(
+      `Cannot enable the compile cache at ${dir}: ${code}: ${message}`);
+  }
+}
+
+function initializeResolveCache() {
+  const file = process.env.NODE_RESOLVE_CACHE;
+  if (!file) return;
+  require('internal/modules/cjs/loader').initializeResolveCache(file);
+}
+
 function initializeCJSLoader() {
   const CJSLoader = require('internal/modules/cjs/loader');
   if (!getEmbedderOptions().noGlobalSearchPaths) {
@@ -629,6 +650,8 @@ module.exports = {
   setupInspectorHooks,
   initializeReport,
   initializeCJSLoader,
+  initializeCompileCache,
+  initializeResolveCache,
   initializeWASI,
   markBootstrapComplete
 };
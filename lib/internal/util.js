@@ -498,6 +498,31 @@ function exposeInterface(target, name, interfaceObject) {
   });
 }
 
+// Defines interfaces `keys` on `target` that are only loaded from the
+// builtin module `id` when they are first accessed, so that bootstrap does not
+// need to compile modules that may never be used. Assigning to the property
+// replaces it without loading the module.
+function exposeLazyInterfaces(target, id, keys) {
+  let mod;
+  for (let i = 0; i < keys.length; i++) {
+    const key = keys[i];
+    ObjectDefineProperty(target, key, {
+      __proto__: null,
+      enumerable: false,
+      configurable: true,
+      get() {
+        mod ??= require(id);
+        const value = mod[key];
+        exposeInterface(target, key, value);
+        return value;
+      },
+      set(value) {
+        exposeInterface(target, key, value);
+      },
+    });
+  }
+}
+
 let _DOMException;
 const lazyDOMExceptionClass = () => {
   _DOMException ??= internalBinding('messaging').DOMException;
@@ -570,6 +595,7 @@ module.exports = {
   deprecate,
   emitExperimentalWarning,
   exposeInterface,
+  exposeLazyInterfaces,
   filterDuplicateStrings,
   filterOwnProperties,
   getConstructorOf,
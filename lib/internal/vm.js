@@ -0,0 +1,81 @@
+'use strict';
+
+const {
+  compileFunction: _compileFunction,
+} = internalBinding('contextify');
+const {
+  validateFunction,
+} = require('internal/validators');
+
+/**
+ * Compiles `code` as the body of a function. The arguments are expected to
+ * have been validated by the caller.
+ * @param {string} code
+ * @param {string[]} [params]
+ * @param {{
+ *   filename?: string;
+ *   columnOffset?: number;
+ *   lineOffset?: number;
+ *   cachedData?: ArrayBufferView;
+ *   produceCachedData?: boolean;
+ *   parsingContext?: object;
+ *   contextExtensions?: object[];
+ *   importModuleDynamically?: Function;
+ *   useCompileCache?: boolean;
+ *   }} options `useCompileCache` makes the function consult the on-disk
+ *   compile cache, if it is enabled.
+ * @returns {Function}
+ */
+function internalCompileFunction(code, params, options) {
+  const {
+    filename = '',
+    columnOffset = 0,
+    lineOffset = 0,
+    cachedData = undefined,
+    produceCachedData = false,
+    parsingContext = undefined,
+    contextExtensions = [],
+    importModuleDynamically,
+    useCompileCache = false,
+  } = options;
+
+  const result = _compileFunction(
+    code,
+    filename,
+    lineOffset,
+    columnOffset,
+    cachedData,
+    produceCachedData,
+    parsingContext,
+    contextExtensions,
+    params,
+    useCompileCache
+  );
+
+  if (produceCachedData) {
+    result.function.cachedDataProduced = result.cachedDataProduced;
+  }
+
+  if (result.cachedData) {
+    result.function.cachedData = result.cachedData;
+  }
+
+  if (importModuleDynamically !== undefined) {
+    validateFunction(importModuleDynamically,
+                     'options.importModuleDynamically');
+    const { importModuleDynamicallyWrap } =
+      require('internal/vm/module');
+    const { callbackMap } = internalBinding('module_wrap');
+    const wrapped = importModuleDynamicallyWrap(importModuleDynamically);
+    const func = result.function;
+    callbackMap.set(result.cacheKey, {
+      importModuleDynamically: (s, _k, i) => wrapped(s, func, i),
+    });
+  }
+
+  return result.function;
+}
+
+module.exports = {
+  internalCompileFunction,
+};
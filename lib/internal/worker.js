@@ -58,7 +58,7 @@ const {
 const { deserializeError } = require('internal/error_serdes');
 const { fileURLToPath, isURLInstance, pathToFileURL } = require('internal/url');
 const { kEmptyObject } = require('internal/util');
-const { validateArray } = require('internal/validators');
+const { validateArray, validateUint32 } = require('internal/validators');
 
 const {
   ownsProcessState,
@@ -66,6 +66,7 @@ const {
   resourceLimits: resourceLimitsRaw,
   threadId,
   Worker: WorkerImpl,
+  WorkerIsolatePool: WorkerIsolatePoolImpl,
   kMaxYoungGenerationSizeMb,
   kMaxOldGenerationSizeMb,
   kCodeRangeSizeMb,
@@ -103,6 +104,18 @@ if (isMainThread) {
     Atomics.add(cwdCounter, 0, 1);
     originalChdir(path);
   };
+
+  // The counter is shared with the workers, so it has to be backed by a new
+  // SharedArrayBuffer when the application is loaded from a snapshot.
+  const {
+    addDeserializeCallback,
+    isBuildingSnapshot,
+  } = require('internal/v8/startup_snapshot').namespace;
+  if (isBuildingSnapshot()) {
+    addDeserializeCallback(() => {
+      cwdCounter = new Uint32Array(new SharedArrayBuffer(4));
+    });
+  }
 }
 
 function setEnvironmentData(key, value) {
@@ -123,6 +136,28 @@ function assignEnvironmentData(data) {
   });
 }
 
+class WorkerIsolatePool {
+  constructor(size) {
+    validateUint32(size, 'size', true);
+    this[kHandle] = new WorkerIsolatePoolImpl(size);
+  }
+
+  close() {
+    this[kHandle].close();
+  }
+}
+
+// Only used in tests.
+function getWorkerIsolatePoolStats(pool) {
+  const {
+    0: idleThreads,
+    1: isolatesCreated,
+    2: workersRun,
+    3: isolatesReused,
+  } = pool[kHandle].getStats();
+  return { idleThreads, isolatesCreated, workersRun, isolatesReused };
+}
+
 class Worker extends EventEmitter {
   constructor(filename, options = kEmptyObject) {
     super();
@@ -130,6 +165,12 @@ class Worker extends EventEmitter {
     if (options.execArgv)
       validateArray(options.execArgv, 'options.execArgv');
 
+    if (options.pool !== undefined &&
+        !(options.pool instanceof WorkerIsolatePool)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        'options.pool', 'WorkerIsolatePool', options.pool);
+    }
+
     let argv;
     if (options.argv) {
       validateArray(options.argv, 'options.argv');
@@ -262,7 +303,7 @@ class Worker extends EventEmitter {
       eventLoopUtilization: FunctionPrototypeBind(eventLoopUtilization, this),
     };
     // Actually start the new thread now that everything is in place.
-    this[kHandle].startThread();
+    this[kHandle].startThread(options.pool?.[kHandle]);
 
     process.nextTick(() => process.emit('worker', this));
     if (workerThreadsChannel.hasSubscribers) {
@@ -501,4 +542,6 @@ module.exports = {
   assignEnvironmentData,
   threadId,
   Worker,
+  WorkerIsolatePool,
+  getWorkerIsolatePoolStats,
 };
@@ -3,7 +3,22 @@
 const { findSourceMap } = require('internal/source_map/source_map_cache');
 const { Module } = require('internal/modules/cjs/loader');
 const { SourceMap } = require('internal/source_map/source_map');
+const { getCompileCacheStats: _getCompileCacheStats } =
+  internalBinding('contextify');
+
+function getCompileCacheStats() {
+  const stats = _getCompileCacheStats();
+  if (stats === undefined) return undefined;
+  return {
+    directory: stats[0],
+    hits: stats[1],
+    misses: stats[2],
+    rejected: stats[3],
+    written: stats[4],
+  };
+}
 
 Module.findSourceMap = findSourceMap;
+Module.getCompileCacheStats = getCompileCacheStats;
 Module.SourceMap = SourceMap;
 module.exports = Module;
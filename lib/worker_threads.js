@@ -7,7 +7,8 @@ const {
   setEnvironmentData,
   getEnvironmentData,
   threadId,
-  Worker
+  Worker,
+  WorkerIsolatePool,
 } = require('internal/worker');
 
 const {
@@ -33,6 +34,7 @@ module.exports = {
   threadId,
   SHARE_ENV,
   Worker,
+  WorkerIsolatePool,
   parentPort: null,
   workerData: null,
   BroadcastChannel,
@@ -27,7 +27,9 @@ const {
   ArrayPrototypeMap,
   ArrayPrototypePush,
   FunctionPrototypeBind,
+  MathMax,
   MathMaxApply,
+  MathMin,
   NumberIsFinite,
   NumberIsNaN,
   ObjectDefineProperties,
@@ -36,6 +38,7 @@ const {
   ObjectKeys,
   ObjectSetPrototypeOf,
   ReflectApply,
+  SafeMap,
   StringPrototypeStartsWith,
   Symbol,
   TypedArrayPrototypeFill,
@@ -47,6 +50,7 @@ const {
     ERR_BROTLI_INVALID_PARAM,
     ERR_BUFFER_TOO_LARGE,
     ERR_INVALID_ARG_TYPE,
+    ERR_METHOD_NOT_IMPLEMENTED,
     ERR_OUT_OF_RANGE,
     ERR_ZLIB_INITIALIZATION_FAILED,
   },
@@ -72,10 +76,12 @@ const { owner_symbol } = require('internal/async_hooks').symbols;
 const {
   validateFunction,
   validateNumber,
+  validateUint32,
 } = require('internal/validators');
 
 const kFlushFlag = Symbol('kFlushFlag');
 const kError = Symbol('kError');
+const kHandle = Symbol('kHandle');
 
 const constants = internalBinding('constants').zlib;
 const {
@@ -85,6 +91,7 @@ const {
   Z_MIN_CHUNK, Z_MIN_WINDOWBITS, Z_MAX_WINDOWBITS, Z_MIN_LEVEL, Z_MAX_LEVEL,
   Z_MIN_MEMLEVEL, Z_MAX_MEMLEVEL, Z_DEFAULT_CHUNK, Z_DEFAULT_COMPRESSION,
   Z_DEFAULT_STRATEGY, Z_DEFAULT_WINDOWBITS, Z_DEFAULT_MEMLEVEL, Z_FIXED,
+  Z_HUFFMAN_ONLY,
   // Node's compression stream modes (node_zlib_mode)
   DEFLATE, DEFLATERAW, INFLATE, INFLATERAW, GZIP, GUNZIP, UNZIP,
   BROTLI_DECODE, BROTLI_ENCODE,
@@ -627,6 +634,36 @@ const zlibDefaultOpts = {
   finishFlush: Z_FINISH,
   fullFlush: Z_FULL_FLUSH
 };
+// A dictionary that is copied into native memory once and can then be shared
+// by any number of zlib streams, see zlib.createDictionary(). Compression
+// streams using it start from a deflate state that has already been primed
+// with the dictionary.
+class ZlibDictionary {
+  #byteLength;
+
+  constructor(data) {
+    if (isAnyArrayBuffer(data)) {
+      data = Buffer.from(data);
+    } else if (!isArrayBufferView(data)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        'data',
+        ['Buffer', 'TypedArray', 'DataView', 'ArrayBuffer'],
+        data
+      );
+    }
+    this[kHandle] = new binding.ZlibDictionary(data);
+    this.#byteLength = data.byteLength;
+  }
+
+  get byteLength() {
+    return this.#byteLength;
+  }
+}
+
+function createDictionary(data) {
+  return new ZlibDictionary(data);
+}
+
 // Base class for all streams actually backed by zlib and using zlib-specific
 // parameters.
 function Zlib(opts, mode) {
@@ -666,13 +703,15 @@ function Zlib(opts, mode) {
       Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY);
 
     dictionary = opts.dictionary;
-    if (dictionary !== undefined && !isArrayBufferView(dictionary)) {
+    if (dictionary instanceof ZlibDictionary) {
+      dictionary = dictionary[kHandle];
+    } else if (dictionary !== undefined && !isArrayBufferView(dictionary)) {
       if (isAnyArrayBuffer(dictionary)) {
         dictionary = Buffer.from(dictionary);
       } else {
         throw new ERR_INVALID_ARG_TYPE(
           'options.dictionary',
-          ['Buffer', 'TypedArray', 'DataView', 'ArrayBuffer'],
+          ['Buffer', 'TypedArray', 'DataView', 'ArrayBuffer', 'ZlibDictionary'],
           dictionary
         );
       }
@@ -786,6 +825,234 @@ function Unzip(opts) {
 ObjectSetPrototypeOf(Unzip.prototype, Zlib.prototype);
 ObjectSetPrototypeOf(Unzip, Zlib);
 
+// Parallel gzip compression, similar to pigz. The input is cut into blocks
+// that are deflated concurrently on the threadpool. Each block is primed with
+// the last window of input preceding it, so that the concatenated output of
+// all blocks forms a single deflate stream, which is wrapped into one gzip
+// member here.
+const kParallelBlockSize = 128 * 1024;
+const kPending = Symbol('kPending');
+const kPendingLength = Symbol('kPendingLength');
+const kWindow = Symbol('kWindow');
+const kNextBlock = Symbol('kNextBlock');
+const kNextOutput = Symbol('kNextOutput');
+const kResults = Symbol('kResults');
+const kInFlight = Symbol('kInFlight');
+const kCrc = Symbol('kCrc');
+const kWaiting = Symbol('kWaiting');
+const kParallelOptions = Symbol('kParallelOptions');
+
+function ParallelGzip(opts) {
+  const windowBits = checkRangesOrGetDefault(
+    opts.windowBits, 'options.windowBits',
+    Z_MIN_WINDOWBITS + 1, Z_MAX_WINDOWBITS, Z_DEFAULT_WINDOWBITS);
+  const level = checkRangesOrGetDefault(
+    opts.level, 'options.level',
+    Z_MIN_LEVEL, Z_MAX_LEVEL, Z_DEFAULT_COMPRESSION);
+  const memLevel = checkRangesOrGetDefault(
+    opts.memLevel, 'options.memLevel',
+    Z_MIN_MEMLEVEL, Z_MAX_MEMLEVEL, Z_DEFAULT_MEMLEVEL);
+  const strategy = checkRangesOrGetDefault(
+    opts.strategy, 'options.strategy',
+    Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY);
+
+  if (opts.encoding || opts.objectMode || opts.writableObjectMode) {
+    opts = { ...opts };
+    opts.encoding = null;
+    opts.objectMode = false;
+    opts.writableObjectMode = false;
+  }
+
+  ReflectApply(Transform, this, [{ autoDestroy: true, ...opts }]);
+  this[kError] = null;
+  this.bytesWritten = 0;
+  this._handle = null;
+  this._level = level;
+  this._strategy = strategy;
+  this._defaultFullFlushFlag = Z_FULL_FLUSH;
+  this[kParallelOptions] = {
+    parallel: opts.parallel,
+    windowBits,
+    level,
+    memLevel,
+    strategy,
+  };
+  this[kPending] = [];
+  this[kPendingLength] = 0;
+  this[kWindow] = null;
+  this[kNextBlock] = 0;
+  this[kNextOutput] = 0;
+  this[kResults] = new SafeMap();
+  this[kInFlight] = 0;
+  this[kCrc] = 0;
+  this[kWaiting] = null;
+}
+ObjectSetPrototypeOf(ParallelGzip.prototype, Gzip.prototype);
+ObjectSetPrototypeOf(ParallelGzip, Gzip);
+
+ObjectDefineProperty(ParallelGzip.prototype, '_closed', {
+  __proto__: null,
+  configurable: true,
+  enumerable: true,
+  get() {
+    return this.destroyed;
+  }
+});
+
+ParallelGzip.prototype._transform = function(chunk, encoding, cb) {
+  const flushFlag = chunk[kFlushFlag];
+  if (typeof flushFlag === 'number') {
+    if (flushFlag === Z_NO_FLUSH)
+      return cb();
+    // Everything written so far has to be emitted before calling back, so
+    // the partial block is compressed on its own and the stream is drained.
+    if (this[kPendingLength] > 0)
+      dispatchParallelBlock(this, false);
+    this[kWaiting] = { cb, drain: true };
+    return maybeResumeParallelGzip(this);
+  }
+
+  ArrayPrototypePush(this[kPending], chunk);
+  this[kPendingLength] += chunk.byteLength;
+  while (this[kPendingLength] >= kParallelBlockSize)
+    dispatchParallelBlock(this, false);
+  this[kWaiting] = { cb, drain: false };
+  maybeResumeParallelGzip(this);
+};
+
+ParallelGzip.prototype._flush = function(callback) {
+  dispatchParallelBlock(this, true);
+  this[kWaiting] = {
+    cb: () => {
+      const trailer = Buffer.allocUnsafe(8);
+      trailer.writeUInt32LE(this[kCrc], 0);
+      trailer.writeUInt32LE(this.bytesWritten % 0x100000000, 4);
+      this.push(trailer);
+      callback();
+    },
+    drain: true
+  };
+  maybeResumeParallelGzip(this);
+};
+
+ParallelGzip.prototype._destroy = function(err, callback) {
+  this[kPending] = [];
+  this[kPendingLength] = 0;
+  this[kResults].clear();
+  this[kWaiting] = null;
+  callback(err);
+};
+
+ParallelGzip.prototype._processChunk = function() {
+  throw new ERR_METHOD_NOT_IMPLEMENTED('_processChunk()');
+};
+
+ParallelGzip.prototype.params = function() {
+  throw new ERR_METHOD_NOT_IMPLEMENTED('params()');
+};
+
+ParallelGzip.prototype.reset = function() {
+  throw new ERR_METHOD_NOT_IMPLEMENTED('reset()');
+};
+
+function takeParallelBlock(self) {
+  const pending = self[kPending];
+  const length = MathMin(self[kPendingLength], kParallelBlockSize);
+  // Always copy, so that the caller may reuse its buffers once the write
+  // callback has been called, even if the block is still being compressed.
+  const all = Buffer.concat(pending, self[kPendingLength]);
+  const block = all.subarray(0, length);
+  pending.length = 0;
+  if (all.length > length)
+    ArrayPrototypePush(pending, all.subarray(length));
+  self[kPendingLength] -= length;
+  return block;
+}
+
+function dispatchParallelBlock(self, last) {
+  const { windowBits, level, memLevel, strategy } = self[kParallelOptions];
+  const block = takeParallelBlock(self);
+  const dictionary = self[kWindow];
+  const windowSize = 1 << windowBits;
+
+  if (block.length >= windowSize) {
+    self[kWindow] = block.subarray(block.length - windowSize);
+  } else if (block.length > 0) {
+    const window = dictionary === null ?
+      block : Buffer.concat([dictionary, block]);
+    self[kWindow] = window.subarray(MathMax(0, window.length - windowSize));
+  }
+
+  const index = self[kNextBlock]++;
+  const length = block.length;
+  const job = new binding.DeflateBlockJob(level, windowBits, memLevel,
+                                          strategy);
+  job.ondone = (code, output, crc) => {
+    onParallelBlockDone(self, index, length, code, output, crc);
+  };
+  job.run(block, dictionary, last);
+  self[kInFlight]++;
+}
+
+function onParallelBlockDone(self, index, length, code, output, crc) {
+  self[kInFlight]--;
+  if (self.destroyed)
+    return;
+
+  if (code !== undefined) {
+    const error = genericNodeError('Zlib error', { errno: codes[code], code });
+    self[kError] = error;
+    self.destroy(error);
+    return;
+  }
+
+  const results = self[kResults];
+  results.set(index, { output, crc, length });
+  while (results.has(self[kNextOutput])) {
+    const result = results.get(self[kNextOutput]);
+    results.delete(self[kNextOutput]);
+    if (self[kNextOutput]++ === 0)
+      self.push(parallelGzipHeader(self));
+    self[kCrc] = binding.crc32Combine(self[kCrc], result.crc, result.length);
+    self.bytesWritten += result.length;
+    if (result.output.length > 0)
+      self.push(result.output);
+  }
+
+  maybeResumeParallelGzip(self);
+}
+
+function maybeResumeParallelGzip(self) {
+  const waiting = self[kWaiting];
+  if (waiting === null)
+    return;
+  // Blocks that finished out of order are kept around until their
+  // predecessors are done, so they count against the limit as well.
+  const limit = waiting.drain ? 0 : self[kParallelOptions].parallel - 1;
+  if (self[kInFlight] + self[kResults].size > limit)
+    return;
+  self[kWaiting] = null;
+  waiting.cb();
+}
+
+function parallelGzipHeader(self) {
+  const { level, strategy } = self[kParallelOptions];
+  // Mirror the header that zlib itself writes for gzip streams.
+  let xfl = 0;
+  if (level === 9)
+    xfl = 2;
+  else if (strategy >= Z_HUFFMAN_ONLY || (level >= 0 && level < 2))
+    xfl = 4;
+  return Buffer.from([
+    0x1f, 0x8b, // ID1, ID2
+    8, // CM: deflate
+    0, // FLG
+    0, 0, 0, 0, // MTIME
+    xfl,
+    process.platform === 'win32' ? 10 : 3, // OS
+  ]);
+}
+
 function createConvenienceMethod(ctor, sync) {
   if (sync) {
     return function syncBufferWrapper(buffer, opts) {
@@ -921,6 +1188,8 @@ module.exports = {
   brotliCompressSync: createConvenienceMethod(BrotliCompress, true),
   brotliDecompress: createConvenienceMethod(BrotliDecompress, false),
   brotliDecompressSync: createConvenienceMethod(BrotliDecompress, true),
+
+  createDictionary,
 };
 
 ObjectDefineProperties(module.exports, {
@@ -928,7 +1197,19 @@ ObjectDefineProperties(module.exports, {
   createInflate: createProperty(Inflate),
   createDeflateRaw: createProperty(DeflateRaw),
   createInflateRaw: createProperty(InflateRaw),
-  createGzip: createProperty(Gzip),
+  createGzip: {
+    __proto__: null,
+    configurable: true,
+    enumerable: true,
+    value: function(options) {
+      if (options?.parallel !== undefined) {
+        validateUint32(options.parallel, 'options.parallel', true);
+        if (options.parallel > 1)
+          return new ParallelGzip(options);
+      }
+      return new Gzip(options);
+    }
+  },
   createGunzip: createProperty(Gunzip),
   createUnzip: createProperty(Unzip),
   createBrotliCompress: createProperty(BrotliCompress),
@@ -467,6 +467,7 @@
         'src/async_wrap.cc',
         'src/cares_wrap.cc',
         'src/cleanup_queue.cc',
+        'src/compile_cache.cc',
         'src/connect_wrap.cc',
         'src/connection_wrap.cc',
         'src/debug_utils.cc',
@@ -483,6 +484,7 @@
         'src/js_stream.cc',
         'src/json_utils.cc',
         'src/js_udp_wrap.cc',
+        'src/module_resolver.cc',
         'src/module_wrap.cc',
         'src/node.cc',
         'src/node_api.cc',
@@ -507,6 +509,7 @@
         'src/node_metadata.cc',
         'src/node_options.cc',
         'src/node_os.cc',
+        'src/node_package_json.cc',
         'src/node_perf.cc',
         'src/node_platform.cc',
         'src/node_postmortem_metadata.cc',
@@ -570,6 +573,7 @@
         'src/callback_queue-inl.h',
         'src/cleanup_queue.h',
         'src/cleanup_queue-inl.h',
+        'src/compile_cache.h',
         'src/connect_wrap.h',
         'src/connection_wrap.h',
         'src/debug_utils.h',
@@ -586,6 +590,7 @@
         'src/large_pages/node_large_page.h',
         'src/memory_tracker.h',
         'src/memory_tracker-inl.h',
+        'src/module_resolver.h',
         'src/module_wrap.h',
         'src/node.h',
         'src/node_api.h',
@@ -617,6 +622,7 @@
         'src/node_object_wrap.h',
         'src/node_options.h',
         'src/node_options-inl.h',
+        'src/node_package_json.h',
         'src/node_perf.h',
         'src/node_perf_common.h',
         'src/node_platform.h',
@@ -0,0 +1,253 @@
+#include "compile_cache.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_file.h"
+#include "node_internals.h"
+#include "threadpoolwork-inl.h"
+#include "util-inl.h"
+#include "zlib.h"
+
+#include <cstring>
+
+namespace node {
+
+using v8::Function;
+using v8::Local;
+using v8::Module;
+using v8::ScriptCompiler;
+using v8::String;
+
+// Identifies the format of the cache files.
+static constexpr uint32_t kCacheMagicNumber = 0x4e434331;  // NCC1
+
+// Every cache file starts with this header, followed by the code cache.
+struct CacheHeader {
+  uint32_t magic_number;
+  uint32_t code_hash;
+  uint32_t code_size;
+  uint32_t cache_size;
+};
+
+static uint32_t GetHash(const char* data, size_t size) {
+  uLong crc = crc32(0L, Z_NULL, 0);
+  return crc32(crc, reinterpret_cast<const Bytef*>(data), size);
+}
+
+ScriptCompiler::CachedData* CompileCacheEntry::CopyCache() const {
+  CHECK(!cache.empty());
+  return new ScriptCompiler::CachedData(
+      reinterpret_cast<const uint8_t*>(cache.data()),
+      static_cast<int>(cache.size()),
+      ScriptCompiler::CachedData::BufferNotOwned);
+}
+
+// Writes a cache file. The data is written to a temporary file first and then
+// renamed, so that other processes never see partially written files.
+class CompileCacheHandler::WriteWork final : public ThreadPoolWork {
+ public:
+  WriteWork(Environment* env,
+            CompileCacheHandler* handler,
+            std::string filename,
+            std::string contents)
+      : ThreadPoolWork(env),
+        handler_(handler),
+        filename_(std::move(filename)),
+        contents_(std::move(contents)),
+        thread_id_(env->thread_id()) {}
+
+  void DoThreadPoolWork() override {
+    // The process and thread IDs keep processes and workers that write the
+    // same entry at the same time from writing into the same temporary file.
+    const std::string temp = filename_ + "." +
+                             std::to_string(uv_os_getpid()) + "." +
+                             std::to_string(thread_id_) + ".tmp";
+    uv_fs_t req;
+    const int fd = uv_fs_open(nullptr,
+                              &req,
+                              temp.c_str(),
+                              UV_FS_O_WRONLY | UV_FS_O_CREAT | UV_FS_O_TRUNC,
+                              0644,
+                              nullptr);
+    uv_fs_req_cleanup(&req);
+    if (fd < 0) {
+      result_ = fd;
+      return;
+    }
+
+    size_t offset = 0;
+    while (offset < contents_.size()) {
+      uv_buf_t buf = uv_buf_init(contents_.data() + offset,
+                                 contents_.size() - offset);
+      const int written =
+          uv_fs_write(nullptr, &req, fd, &buf, 1, offset, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (written <= 0) {
+        result_ = written < 0 ? written : UV_EIO;
+        break;
+      }
+      offset += written;
+    }
+    uv_fs_close(nullptr, &req, fd, nullptr);
+    uv_fs_req_cleanup(&req);
+
+    if (result_ == 0) {
+      result_ = uv_fs_rename(
+          nullptr, &req, temp.c_str(), filename_.c_str(), nullptr);
+      uv_fs_req_cleanup(&req);
+    }
+    if (result_ != 0) {
+      uv_fs_unlink(nullptr, &req, temp.c_str(), nullptr);
+      uv_fs_req_cleanup(&req);
+    }
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<WriteWork> self(this);
+    if (status == 0 && result_ == 0) {
+      handler_->stats_.written++;
+    } else {
+      Debug(env(),
+            DebugCategory::COMPILE_CACHE,
+            "[compile cache] failed to write %s: %s\n",
+            filename_,
+            uv_strerror(status != 0 ? status : result_));
+    }
+  }
+
+ private:
+  CompileCacheHandler* handler_;
+  std::string filename_;
+  std::string contents_;
+  uint64_t thread_id_;
+  int result_ = 0;
+};
+
+CompileCacheHandler::CompileCacheHandler(Environment* env) : env_(env) {}
+
+int CompileCacheHandler::Enable(const std::string& dir) {
+  // Caches produced with a different V8 version or with different flags
+  // are rejected by V8 anyway, so keep them apart.
+  const std::string cache_dir =
+      dir + kPathSeparator +
+      std::to_string(ScriptCompiler::CachedDataVersionTag());
+
+  fs::FSReqWrapSync req_wrap;
+  const int err =
+      fs::MKDirpSync(nullptr, &req_wrap.req, cache_dir, 0777, nullptr);
+  if (err < 0 && err != UV_EEXIST) {
+    Debug(env_,
+          DebugCategory::COMPILE_CACHE,
+          "[compile cache] cannot create %s: %s\n",
+          cache_dir,
+          uv_strerror(err));
+    return err;
+  }
+
+  cache_dir_ = cache_dir;
+  Debug(env_,
+        DebugCategory::COMPILE_CACHE,
+        "[compile cache] enabled at %s\n",
+        cache_dir_);
+  return 0;
+}
+
+std::unique_ptr<CompileCacheEntry> CompileCacheHandler::Get(
+    Local<String> code, Local<String> filename, CachedCodeType type) {
+  if (!enabled()) return nullptr;
+
+  Utf8Value filename_utf8(env_->isolate(), filename);
+  std::string key(*filename_utf8, filename_utf8.length());
+  key += static_cast<char>(type);
+  Utf8Value code_utf8(env_->isolate(), code);
+
+  auto entry = std::make_unique<CompileCacheEntry>();
+  entry->cache_filename = cache_dir_ + kPathSeparator +
+                          std::to_string(GetHash(key.data(), key.size()));
+  entry->code_hash = GetHash(*code_utf8, code_utf8.length());
+  entry->code_size = static_cast<uint32_t>(code_utf8.length());
+  entry->type = type;
+
+  std::string contents;
+  CacheHeader header;
+  if (ReadFileSync(&contents, entry->cache_filename.c_str()) != 0 ||
+      contents.size() < sizeof(header)) {
+    stats_.misses++;
+    return entry;
+  }
+  memcpy(&header, contents.data(), sizeof(header));
+  if (header.magic_number != kCacheMagicNumber ||
+      header.code_hash != entry->code_hash ||
+      header.code_size != entry->code_size ||
+      header.cache_size != contents.size() - sizeof(header)) {
+    // The source has changed since the cache was written.
+    Debug(env_,
+          DebugCategory::COMPILE_CACHE,
+          "[compile cache] %s is stale for %s\n",
+          entry->cache_filename,
+          *filename_utf8);
+    stats_.misses++;
+    return entry;
+  }
+
+  entry->cache = contents.substr(sizeof(header));
+  return entry;
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Function> fn,
+                                    bool rejected) {
+  if (!entry->cache.empty() && !rejected) {
+    MaybeSaveImpl(entry, nullptr, false);
+    return;
+  }
+  MaybeSaveImpl(entry, ScriptCompiler::CreateCodeCacheForFunction(fn),
+                rejected);
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Module> module,
+                                    bool rejected) {
+  if (!entry->cache.empty() && !rejected) {
+    MaybeSaveImpl(entry, nullptr, false);
+    return;
+  }
+  MaybeSaveImpl(entry,
+                ScriptCompiler::CreateCodeCache(
+                    module->GetUnboundModuleScript()),
+                rejected);
+}
+
+void CompileCacheHandler::MaybeSaveImpl(CompileCacheEntry* entry,
+                                        ScriptCompiler::CachedData* data,
+                                        bool rejected) {
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data(data);
+  if (!entry->cache.empty()) {
+    if (!rejected) {
+      // The cache was used, nothing to update.
+      stats_.hits++;
+      return;
+    }
+    Debug(env_,
+          DebugCategory::COMPILE_CACHE,
+          "[compile cache] %s was rejected\n",
+          entry->cache_filename);
+    stats_.rejected++;
+  }
+  if (!cached_data || cached_data->length <= 0) return;
+
+  CacheHeader header = {kCacheMagicNumber,
+                        entry->code_hash,
+                        entry->code_size,
+                        static_cast<uint32_t>(cached_data->length)};
+  std::string contents(sizeof(header) + cached_data->length, '\0');
+  memcpy(contents.data(), &header, sizeof(header));
+  memcpy(contents.data() + sizeof(header),
+         cached_data->data,
+         cached_data->length);
+
+  auto* work = new WriteWork(
+      env_, this, entry->cache_filename, std::move(contents));
+  work->ScheduleWork();
+}
+
+}  // namespace node
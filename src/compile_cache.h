@@ -0,0 +1,89 @@
+#ifndef SRC_COMPILE_CACHE_H_
+#define SRC_COMPILE_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include "v8.h"
+
+namespace node {
+class Environment;
+
+enum class CachedCodeType : uint8_t {
+  kCommonJS = 0,
+  kESM,
+};
+
+// The cache for a single module. It is looked up before the module is
+// compiled and passed back to the handler afterwards.
+struct CompileCacheEntry {
+  std::string cache_filename;
+  uint32_t code_hash;
+  uint32_t code_size;
+  CachedCodeType type;
+  // The code cache read from disk, if any.
+  std::string cache;
+
+  // Returns a CachedData that does not own the data. The caller takes
+  // ownership of the returned object, e.g. by passing it to
+  // v8::ScriptCompiler::Source.
+  v8::ScriptCompiler::CachedData* CopyCache() const;
+};
+
+// Stores the V8 code cache of user modules on disk, so that later processes
+// can skip parsing and compiling them. The cache of each module lives in
+// its own file, named after a hash of the module's file name and type, in a
+// subdirectory of the cache directory that is specific to the V8 version and
+// flags. Entries are validated against a hash of the source before use, and
+// new entries are written on the thread pool.
+class CompileCacheHandler {
+ public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t rejected = 0;
+    uint64_t written = 0;
+  };
+
+  explicit CompileCacheHandler(Environment* env);
+
+  // Returns 0 on success or a libuv error code if the cache directory could
+  // not be created.
+  int Enable(const std::string& dir);
+  bool enabled() const { return !cache_dir_.empty(); }
+  const std::string& cache_dir() const { return cache_dir_; }
+  const Stats& stats() const { return stats_; }
+
+  std::unique_ptr<CompileCacheEntry> Get(v8::Local<v8::String> code,
+                                         v8::Local<v8::String> filename,
+                                         CachedCodeType type);
+  // Called once the module has been compiled. `rejected` is true if V8 did
+  // not accept the cache from the entry.
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Function> fn,
+                 bool rejected);
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Module> module,
+                 bool rejected);
+
+  CompileCacheHandler(const CompileCacheHandler&) = delete;
+  CompileCacheHandler& operator=(const CompileCacheHandler&) = delete;
+
+ private:
+  class WriteWork;
+
+  void MaybeSaveImpl(CompileCacheEntry* entry,
+                     v8::ScriptCompiler::CachedData* data,
+                     bool rejected);
+
+  Environment* env_;
+  std::string cache_dir_;
+  Stats stats_;
+};
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_COMPILE_CACHE_H_
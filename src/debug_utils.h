@@ -47,6 +47,7 @@ void NODE_EXTERN_PRIVATE FWrite(FILE* file, const std::string& str);
   V(INSPECTOR_SERVER)                                                          \
   V(INSPECTOR_PROFILER)                                                        \
   V(CODE_CACHE)                                                                \
+  V(COMPILE_CACHE)                                                             \
   V(NGTCP2_DEBUG)                                                              \
   V(WASI)                                                                      \
   V(MKSNAPSHOT)
@@ -70,7 +70,9 @@ inline MultiIsolatePlatform* IsolateData::platform() const {
 }
 
 inline void IsolateData::set_worker_context(worker::Worker* context) {
-  CHECK_NULL(worker_context_);  // Should be set only once.
+  // Should be set only once, but isolates of a worker::WorkerIsolatePool are
+  // used by one Worker after another and reset it in between.
+  CHECK(worker_context_ == nullptr || context == nullptr);
   worker_context_ = context;
 }
 
@@ -78,6 +80,15 @@ inline worker::Worker* IsolateData::worker_context() const {
   return worker_context_;
 }
 
+inline void IsolateData::set_snapshot_data(const SnapshotData* snapshot_data) {
+  CHECK_NULL(snapshot_data_);  // Should be set only once.
+  snapshot_data_ = snapshot_data;
+}
+
+inline const SnapshotData* IsolateData::snapshot_data() const {
+  return snapshot_data_;
+}
+
 inline v8::Local<v8::String> IsolateData::async_wrap_provider(int index) const {
   return async_wrap_providers_[index].Get(isolate_);
 }
@@ -393,6 +404,10 @@ inline uint32_t Environment::get_next_function_id() {
   return function_id_counter_++;
 }
 
+inline void Environment::ReserveFunctionId(uint32_t id) {
+  if (function_id_counter_ <= id) function_id_counter_ = id + 1;
+}
+
 ShouldNotAbortOnUncaughtScope::ShouldNotAbortOnUncaughtScope(
     Environment* env)
     : env_(env) {
@@ -706,6 +721,16 @@ inline void Environment::remove_sub_worker_context(worker::Worker* context) {
   sub_worker_contexts_.erase(context);
 }
 
+inline void Environment::add_worker_isolate_pool(
+    worker::WorkerIsolatePool* pool) {
+  worker_isolate_pools_.insert(pool);
+}
+
+inline void Environment::remove_worker_isolate_pool(
+    worker::WorkerIsolatePool* pool) {
+  worker_isolate_pools_.erase(pool);
+}
+
 template <typename Fn>
 inline void Environment::ForEachWorker(Fn&& iterator) {
   for (worker::Worker* w : sub_worker_contexts_) iterator(w);
@@ -1304,6 +1304,15 @@ void CollectExceptionInfo(Environment* env,
   }
 }
 
+int Environment::EnableCompileCache(const std::string& cache_dir) {
+  // The first directory stays in use for the lifetime of the environment.
+  if (compile_cache_handler_) return 0;
+  auto handler = std::make_unique<CompileCacheHandler>(this);
+  const int err = handler->Enable(cache_dir);
+  if (err == 0) compile_cache_handler_ = std::move(handler);
+  return err;
+}
+
 void Environment::CollectUVExceptionInfo(Local<Value> object,
                                          int errorno,
                                          const char* syscall,
@@ -1539,6 +1548,10 @@ void Environment::stop_sub_worker_contexts() {
     w->Exit(1);
     w->JoinThread();
   }
+
+  for (worker::WorkerIsolatePool* pool : worker_isolate_pools_) {
+    pool->Close();
+  }
 }
 
 Environment* Environment::worker_parent_env() const {
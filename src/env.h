@@ -31,6 +31,7 @@
 #endif
 #include "callback_queue.h"
 #include "cleanup_queue-inl.h"
+#include "compile_cache.h"
 #include "debug_utils.h"
 #include "env_properties.h"
 #include "handle_wrap.h"
@@ -89,6 +90,7 @@ class ParentInspectorHandle;
 
 namespace worker {
 class Worker;
+class WorkerIsolatePool;
 }
 
 namespace loader {
@@ -156,6 +158,8 @@ class NoArrayBufferZeroFillScope {
   friend class Environment;
 };
 
+struct SnapshotData;
+
 struct IsolateDataSerializeInfo {
   std::vector<SnapshotIndex> primitive_values;
   std::vector<PropInfo> template_values;
@@ -186,6 +190,11 @@ class NODE_EXTERN_PRIVATE IsolateData : public MemoryRetainer {
   inline worker::Worker* worker_context() const;
   inline void set_worker_context(worker::Worker* context);
 
+  // The snapshot that the isolate was deserialized from, if any. Worker
+  // threads started from this isolate are deserialized from it as well.
+  inline const SnapshotData* snapshot_data() const;
+  inline void set_snapshot_data(const SnapshotData* snapshot_data);
+
 #define VP(PropertyName, StringValue) V(v8::Private, PropertyName)
 #define VY(PropertyName, StringValue) V(v8::Symbol, PropertyName)
 #define VS(PropertyName, StringValue) V(v8::String, PropertyName)
@@ -246,6 +255,7 @@ class NODE_EXTERN_PRIVATE IsolateData : public MemoryRetainer {
   MultiIsolatePlatform* platform_;
   std::shared_ptr<PerIsolateOptions> options_;
   worker::Worker* worker_context_ = nullptr;
+  const SnapshotData* snapshot_data_ = nullptr;
 };
 
 struct ContextInfo {
@@ -538,7 +548,7 @@ struct SnapshotMetadata {
 struct SnapshotData {
   enum class DataOwnership { kOwned, kNotOwned };
 
-  static const uint32_t kMagic = 0x143da19;
+  static const uint32_t kMagic = 0x143da20;
   static const SnapshotIndex kNodeVMContextIndex = 0;
   static const SnapshotIndex kNodeBaseContextIndex = kNodeVMContextIndex + 1;
   static const SnapshotIndex kNodeMainContextIndex = kNodeBaseContextIndex + 1;
@@ -562,11 +572,21 @@ struct SnapshotData {
   // v8::ScriptCompiler::CachedData is not copyable.
   std::vector<builtins::CodeCacheInfo> code_cache;
 
+  // Set by FromFile(). The V8 blob and `mapped_code_cache` point into the
+  // memory-mapped file instead of being owned by this object, and
+  // `code_cache` is empty.
+  bool is_file_backed = false;
+  std::vector<builtins::CodeCacheRef> mapped_code_cache;
+
   void ToBlob(FILE* out) const;
   // If returns false, the metadata doesn't match the current Node.js binary,
   // and the caller should not consume the snapshot data.
   bool Check() const;
-  static bool FromBlob(SnapshotData* out, FILE* in);
+  // Maps the blob written by ToBlob() into memory. The mapping is kept for
+  // the lifetime of the process, and its pages are shared with other
+  // processes that use the same file. Only the small tables of the blob are
+  // copied, the rest is read on demand by V8 and the built-in loader.
+  static bool FromFile(SnapshotData* out, const std::string& path);
 
   ~SnapshotData();
 
@@ -780,11 +800,21 @@ class Environment : public MemoryRetainer {
   inline uint32_t get_next_module_id();
   inline uint32_t get_next_script_id();
   inline uint32_t get_next_function_id();
+  // Makes sure that get_next_function_id() does not return `id`, e.g. for
+  // functions restored from a snapshot.
+  inline void ReserveFunctionId(uint32_t id);
 
   EnabledDebugList* enabled_debug_list() { return &enabled_debug_list_; }
 
   inline performance::PerformanceState* performance_state();
 
+  // Returns nullptr unless the compile cache has been enabled.
+  CompileCacheHandler* compile_cache_handler() {
+    return compile_cache_handler_.get();
+  }
+  // Returns 0 or a libuv error code.
+  int EnableCompileCache(const std::string& cache_dir);
+
   void CollectUVExceptionInfo(v8::Local<v8::Value> context,
                               int errorno,
                               const char* syscall = nullptr,
@@ -827,6 +857,10 @@ class Environment : public MemoryRetainer {
   Environment* worker_parent_env() const;
   inline void add_sub_worker_context(worker::Worker* context);
   inline void remove_sub_worker_context(worker::Worker* context);
+  inline void add_worker_isolate_pool(worker::WorkerIsolatePool* pool);
+  inline void remove_worker_isolate_pool(worker::WorkerIsolatePool* pool);
+  // Also closes the worker isolate pools, whose isolates have to be disposed
+  // of before the platform.
   void stop_sub_worker_contexts();
   template <typename Fn>
   inline void ForEachWorker(Fn&& iterator);
@@ -1126,6 +1160,7 @@ class Environment : public MemoryRetainer {
   // https://w3c.github.io/hr-time/#dfn-get-time-origin-timestamp
   double time_origin_timestamp_;
   std::unique_ptr<performance::PerformanceState> performance_state_;
+  std::unique_ptr<CompileCacheHandler> compile_cache_handler_;
 
   bool has_serialized_options_ = false;
 
@@ -1133,6 +1168,7 @@ class Environment : public MemoryRetainer {
   uint64_t flags_;
   uint64_t thread_id_;
   std::unordered_set<worker::Worker*> sub_worker_contexts_;
+  std::unordered_set<worker::WorkerIsolatePool*> worker_isolate_pools_;
 
 #if HAVE_INSPECTOR
   std::unique_ptr<inspector::Agent> inspector_agent_;
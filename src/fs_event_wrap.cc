@@ -26,8 +26,22 @@
 #include "node_external_reference.h"
 #include "string_bytes.h"
 
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#endif
+
 namespace node {
 
+using v8::Array;
 using v8::Context;
 using v8::DontDelete;
 using v8::DontEnum;
@@ -85,6 +99,357 @@ FSEventWrap::FSEventWrap(Environment* env, Local<Object> object)
 }
 
 
+#ifdef __linux__
+// Watches a directory tree with a single inotify instance, as libuv's
+// uv_fs_event_t does not support recursive watches on Linux. Watches are
+// added for directories as they are created or moved into the tree and
+// removed as they leave it. All events read in one poll callback are
+// coalesced per path and delivered to JS land as a single batch of
+// [eventType, filename, ...] pairs, with filenames relative to the root.
+class FSEventTreeWrap : public HandleWrap {
+ public:
+  static void New(const FunctionCallbackInfo<Value>& args);
+  static void Start(const FunctionCallbackInfo<Value>& args);
+  static void GetInitialized(const FunctionCallbackInfo<Value>& args);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(FSEventTreeWrap)
+  SET_SELF_SIZE(FSEventTreeWrap)
+
+ private:
+  static const encoding kDefaultEncoding = UTF8;
+  static constexpr uint32_t kWatchMask =
+      IN_ATTRIB | IN_CREATE | IN_MODIFY | IN_DELETE | IN_DELETE_SELF |
+      IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO;
+
+  struct PendingEvent {
+    std::string filename;
+    int events;
+  };
+
+  FSEventTreeWrap(Environment* env, Local<Object> object);
+  ~FSEventTreeWrap() override = default;
+
+  void OnClose() override;
+
+  static void OnPoll(uv_poll_t* handle, int status, int events);
+  int ReadEvents();
+  void HandleEvent(const struct inotify_event* event);
+  int WatchTree(const std::string& dir, std::vector<std::string>* found);
+  void UnwatchTree(const std::string& dir);
+  void Record(const std::string& filename, int events);
+  void Flush(int status);
+
+  std::string FullPath(const std::string& relative) const {
+    return relative.empty() ? root_ : root_ + "/" + relative;
+  }
+
+  uv_poll_t handle_;
+  int fd_ = -1;
+  std::string root_;
+  // Watched directories, relative to the root, by watch descriptor and by
+  // path. The latter is ordered so that subtrees can be found by prefix.
+  std::unordered_map<int, std::string> wd_to_dir_;
+  std::map<std::string, int> dir_to_wd_;
+  std::vector<PendingEvent> pending_;
+  std::unordered_map<std::string, size_t> pending_index_;
+  int pending_error_ = 0;
+  enum encoding encoding_ = kDefaultEncoding;
+};
+
+
+FSEventTreeWrap::FSEventTreeWrap(Environment* env, Local<Object> object)
+    : HandleWrap(env,
+                 object,
+                 reinterpret_cast<uv_handle_t*>(&handle_),
+                 AsyncWrap::PROVIDER_FSEVENTWRAP) {
+  MarkAsUninitialized();
+}
+
+
+void FSEventTreeWrap::GetInitialized(const FunctionCallbackInfo<Value>& args) {
+  FSEventTreeWrap* wrap = Unwrap<FSEventTreeWrap>(args.This());
+  CHECK_NOT_NULL(wrap);
+  args.GetReturnValue().Set(!wrap->IsHandleClosing());
+}
+
+
+void FSEventTreeWrap::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  new FSEventTreeWrap(env, args.This());
+}
+
+
+// wrap.start(filename, persistent, encoding)
+void FSEventTreeWrap::Start(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  FSEventTreeWrap* wrap = Unwrap<FSEventTreeWrap>(args.This());
+  CHECK_NOT_NULL(wrap);
+  CHECK(wrap->IsHandleClosing());  // Check that Start() has not been called.
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+  wrap->root_ = path.ToString();
+  if (wrap->root_.size() > 1 && wrap->root_.back() == '/')
+    wrap->root_.pop_back();
+
+  wrap->encoding_ = ParseEncoding(env->isolate(), args[2], kDefaultEncoding);
+
+  wrap->fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (wrap->fd_ == -1)
+    return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+
+  int err = wrap->WatchTree("", nullptr);
+  if (err == 0)
+    err = uv_poll_init(env->event_loop(), &wrap->handle_, wrap->fd_);
+  if (err != 0) {
+    close(wrap->fd_);
+    wrap->fd_ = -1;
+    return args.GetReturnValue().Set(err);
+  }
+
+  err = uv_poll_start(&wrap->handle_, UV_READABLE, OnPoll);
+  wrap->MarkAsInitialized();
+
+  if (err != 0) {
+    FSEventTreeWrap::Close(args);
+    return args.GetReturnValue().Set(err);
+  }
+
+  // Check for persistent argument
+  if (!args[1]->IsTrue()) {
+    uv_unref(reinterpret_cast<uv_handle_t*>(&wrap->handle_));
+  }
+
+  args.GetReturnValue().Set(err);
+}
+
+
+void FSEventTreeWrap::OnClose() {
+  // The poll handle must be closed before its file descriptor.
+  if (fd_ != -1) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+
+// Adds watches for `dir` and every directory below it. When `found` is given,
+// the paths of all entries below `dir` are appended to it, so that entries
+// created before the watches were in place are still reported.
+int FSEventTreeWrap::WatchTree(const std::string& dir,
+                               std::vector<std::string>* found) {
+  std::vector<std::string> queue { dir };
+  while (!queue.empty()) {
+    const std::string current = std::move(queue.back());
+    queue.pop_back();
+    const std::string full_path = FullPath(current);
+
+    // Symbolic links are only followed for the root, so that the watches
+    // cannot form a cycle.
+    const uint32_t mask =
+        current.empty() ? kWatchMask : kWatchMask | IN_ONLYDIR | IN_DONT_FOLLOW;
+    const int wd = inotify_add_watch(fd_, full_path.c_str(), mask);
+    if (wd == -1) {
+      // Running out of watches is an error, but a directory that has been
+      // removed or replaced in the meantime is not.
+      if (current.empty() || errno == ENOSPC || errno == ENOMEM)
+        return uv_translate_sys_error(errno);
+      continue;
+    }
+    wd_to_dir_[wd] = current;
+    dir_to_wd_[current] = wd;
+
+    DIR* stream = opendir(full_path.c_str());
+    if (stream == nullptr)
+      continue;
+    while (const struct dirent* entry = readdir(stream)) {
+      if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+        continue;
+      std::string child =
+          current.empty() ? entry->d_name : current + "/" + entry->d_name;
+      bool is_dir = entry->d_type == DT_DIR;
+      if (entry->d_type == DT_UNKNOWN) {
+        struct stat st;
+        is_dir = fstatat(dirfd(stream), entry->d_name, &st,
+                         AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+      }
+      if (found != nullptr)
+        found->push_back(child);
+      if (is_dir)
+        queue.push_back(std::move(child));
+    }
+    closedir(stream);
+  }
+  return 0;
+}
+
+
+// Removes the watches for `dir` and every directory below it, once it has
+// been moved out of the tree. inotify removes the watches of deleted
+// directories by itself.
+void FSEventTreeWrap::UnwatchTree(const std::string& dir) {
+  const std::string prefix = dir + "/";
+  auto it = dir_to_wd_.lower_bound(prefix);
+  while (it != dir_to_wd_.end() &&
+         it->first.compare(0, prefix.size(), prefix) == 0) {
+    inotify_rm_watch(fd_, it->second);
+    wd_to_dir_.erase(it->second);
+    it = dir_to_wd_.erase(it);
+  }
+  it = dir_to_wd_.find(dir);
+  if (it != dir_to_wd_.end()) {
+    inotify_rm_watch(fd_, it->second);
+    wd_to_dir_.erase(it->second);
+    dir_to_wd_.erase(it);
+  }
+}
+
+
+void FSEventTreeWrap::OnPoll(uv_poll_t* handle, int status, int events) {
+  FSEventTreeWrap* wrap = static_cast<FSEventTreeWrap*>(handle->data);
+  if (status == 0)
+    status = wrap->ReadEvents();
+  wrap->Flush(status);
+}
+
+
+int FSEventTreeWrap::ReadEvents() {
+  alignas(struct inotify_event) char buf[64 * 1024];
+  for (;;) {
+    const ssize_t size = read(fd_, buf, sizeof(buf));
+    if (size == -1) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return 0;
+      return uv_translate_sys_error(errno);
+    }
+    const char* p = buf;
+    while (p < buf + size) {
+      const struct inotify_event* event =
+          reinterpret_cast<const struct inotify_event*>(p);
+      HandleEvent(event);
+      p += sizeof(*event) + event->len;
+    }
+  }
+}
+
+
+void FSEventTreeWrap::HandleEvent(const struct inotify_event* event) {
+  if (event->mask & IN_Q_OVERFLOW) {
+    // Events were dropped, possibly including the creation of directories.
+    // Watch anything that is new and report a change of the root.
+    const int err = WatchTree("", nullptr);
+    if (err != 0)
+      pending_error_ = err;
+    Record("", UV_RENAME);
+    return;
+  }
+
+  auto it = wd_to_dir_.find(event->wd);
+  if (it == wd_to_dir_.end())
+    return;
+  const std::string dir = it->second;
+
+  if (event->mask & IN_IGNORED) {
+    wd_to_dir_.erase(it);
+    auto dir_it = dir_to_wd_.find(dir);
+    if (dir_it != dir_to_wd_.end() && dir_it->second == event->wd)
+      dir_to_wd_.erase(dir_it);
+    return;
+  }
+
+  // Events about a subdirectory itself are also reported by its parent.
+  if (event->len == 0 && !dir.empty())
+    return;
+
+  const std::string filename =
+      event->len == 0 ? dir :
+      dir.empty() ? std::string(event->name) : dir + "/" + event->name;
+
+  int events = 0;
+  if (event->mask & (IN_ATTRIB | IN_MODIFY))
+    events |= UV_CHANGE;
+  if (event->mask & ~(IN_ATTRIB | IN_MODIFY | IN_ISDIR))
+    events |= UV_RENAME;
+  Record(filename, events);
+
+  if (!(event->mask & IN_ISDIR))
+    return;
+  if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+    std::vector<std::string> found;
+    const int err = WatchTree(filename, &found);
+    if (err != 0)
+      pending_error_ = err;
+    for (const std::string& entry : found)
+      Record(entry, UV_RENAME);
+  } else if (event->mask & IN_MOVED_FROM) {
+    UnwatchTree(filename);
+  }
+}
+
+
+void FSEventTreeWrap::Record(const std::string& filename, int events) {
+  auto result = pending_index_.emplace(filename, pending_.size());
+  if (result.second)
+    pending_.push_back(PendingEvent { filename, events });
+  else
+    pending_[result.first->second].events |= events;
+}
+
+
+void FSEventTreeWrap::Flush(int status) {
+  if (status == 0)
+    status = pending_error_;
+  if (pending_.empty() && status == 0)
+    return;
+
+  Environment* env = this->env();
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  // The root itself is reported by its base name, as uv_fs_event_t does.
+  const size_t slash = root_.find_last_of('/');
+  const std::string root_name =
+      slash == std::string::npos ? root_ : root_.substr(slash + 1);
+
+  std::vector<Local<Value>> batch;
+  batch.reserve(pending_.size() * 2);
+  for (const PendingEvent& pending : pending_) {
+    // As in FSEventWrap::OnEvent, a rename implies a change.
+    batch.push_back(pending.events & UV_RENAME ? env->rename_string()
+                                               : env->change_string());
+    const std::string& filename =
+        pending.filename.empty() ? root_name : pending.filename;
+    Local<Value> error;
+    Local<Value> name;
+    if (!StringBytes::Encode(isolate, filename.data(), filename.size(),
+                             encoding_, &error).ToLocal(&name)) {
+      name = StringBytes::Encode(isolate, filename.data(), filename.size(),
+                                 BUFFER, &error).ToLocalChecked();
+    }
+    batch.push_back(name);
+  }
+  pending_.clear();
+  pending_index_.clear();
+  pending_error_ = 0;
+
+  Local<Value> argv[] = {
+    Integer::New(isolate, status),
+    Array::New(isolate, batch.data(), batch.size())
+  };
+  MakeCallback(env->onchange_string(), arraysize(argv), argv);
+}
+#endif  // __linux__
+
+
 void FSEventWrap::GetInitialized(const FunctionCallbackInfo<Value>& args) {
   FSEventWrap* wrap = Unwrap<FSEventWrap>(args.This());
   CHECK_NOT_NULL(wrap);
@@ -118,6 +483,27 @@ void FSEventWrap::Initialize(Local<Object> target,
       static_cast<PropertyAttribute>(ReadOnly | DontDelete | DontEnum));
 
   SetConstructorFunction(context, target, "FSEvent", t);
+
+#ifdef __linux__
+  Local<FunctionTemplate> tree =
+      NewFunctionTemplate(isolate, FSEventTreeWrap::New);
+  tree->InstanceTemplate()->SetInternalFieldCount(
+      FSEventTreeWrap::kInternalFieldCount);
+
+  tree->Inherit(HandleWrap::GetConstructorTemplate(env));
+  SetProtoMethod(isolate, tree, "start", FSEventTreeWrap::Start);
+
+  tree->PrototypeTemplate()->SetAccessorProperty(
+      FIXED_ONE_BYTE_STRING(env->isolate(), "initialized"),
+      FunctionTemplate::New(env->isolate(),
+                            FSEventTreeWrap::GetInitialized,
+                            Local<Value>(),
+                            Signature::New(env->isolate(), tree)),
+      Local<FunctionTemplate>(),
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete | DontEnum));
+
+  SetConstructorFunction(context, target, "FSEventTree", tree);
+#endif
 }
 
 void FSEventWrap::RegisterExternalReferences(
@@ -125,6 +511,11 @@ void FSEventWrap::RegisterExternalReferences(
   registry->Register(New);
   registry->Register(Start);
   registry->Register(GetInitialized);
+#ifdef __linux__
+  registry->Register(FSEventTreeWrap::New);
+  registry->Register(FSEventTreeWrap::Start);
+  registry->Register(FSEventTreeWrap::GetInitialized);
+#endif
 }
 
 void FSEventWrap::New(const FunctionCallbackInfo<Value>& args) {
@@ -0,0 +1,546 @@
+#include "module_resolver.h"
+#include "env-inl.h"
+#include "node_mutex.h"
+#include "node_package_json.h"
+#include "util-inl.h"
+
+#include <sys/stat.h>  // S_IFDIR
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace node {
+namespace loader {
+
+using package_json::JsonValue;
+using package_json::PackageJson;
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Isolate;
+using v8::Local;
+using v8::String;
+using v8::Value;
+
+namespace {
+
+enum class FileType {
+  kNone,
+  kFile,
+  kDirectory,
+};
+
+// Only entries that exist are cached, so that files created while the
+// process runs are found. Entries that are removed later are not noticed,
+// like in the realpath cache of the JS resolver.
+Mutex fs_cache_mutex;
+std::unordered_map<std::string, FileType> file_type_cache;
+std::unordered_map<std::string, std::string> realpath_cache;
+
+FileType GetFileType(const std::string& path) {
+  {
+    Mutex::ScopedLock lock(fs_cache_mutex);
+    auto it = file_type_cache.find(path);
+    if (it != file_type_cache.end()) return it->second;
+  }
+
+  uv_fs_t req;
+  const int rc = uv_fs_stat(nullptr, &req, path.c_str(), nullptr);
+  FileType type = FileType::kNone;
+  if (rc == 0) {
+    const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
+    type = (s->st_mode & S_IFMT) == S_IFDIR ? FileType::kDirectory
+                                            : FileType::kFile;
+  }
+  uv_fs_req_cleanup(&req);
+
+  if (type != FileType::kNone) {
+    Mutex::ScopedLock lock(fs_cache_mutex);
+    file_type_cache.emplace(path, type);
+  }
+  return type;
+}
+
+std::optional<std::string> RealPath(const std::string& path) {
+  {
+    Mutex::ScopedLock lock(fs_cache_mutex);
+    auto it = realpath_cache.find(path);
+    if (it != realpath_cache.end()) return it->second;
+  }
+
+  uv_fs_t req;
+  const int rc = uv_fs_realpath(nullptr, &req, path.c_str(), nullptr);
+  std::optional<std::string> result;
+  if (rc == 0) result = static_cast<const char*>(req.ptr);
+  uv_fs_req_cleanup(&req);
+
+  if (result.has_value()) {
+    Mutex::ScopedLock lock(fs_cache_mutex);
+    realpath_cache.emplace(path, result.value());
+  }
+  return result;
+}
+
+bool StartsWith(const std::string& str, const char* prefix) {
+  return str.compare(0, strlen(prefix), prefix) == 0;
+}
+
+bool EndsWith(const std::string& str, const std::string& suffix) {
+  return str.size() >= suffix.size() &&
+         str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::string Dirname(const std::string& path) {
+  const size_t pos = path.find_last_of('/');
+  if (pos == std::string::npos || pos == 0) return "/";
+  return path.substr(0, pos);
+}
+
+std::string JoinPath(const std::string& dir, const std::string& name) {
+  if (!dir.empty() && dir.back() == '/') return dir + name;
+  return dir + "/" + name;
+}
+
+// Returns false for strings that URL parsing would change, e.g. because they
+// contain percent-encoded characters, queries or fragments, or backslashes,
+// which are separators in file: URLs.
+bool IsPlainPath(const std::string& str) {
+  for (const char c : str) {
+    if (c == '%' || c == '?' || c == '#' || c == '\\' ||
+        static_cast<unsigned char>(c) < 0x20 || c == 0x7F) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Resolves "." and ".." segments like the URL parser does for the path of a
+// file: URL. Unlike path.resolve(), this keeps empty segments. `path` must be
+// absolute.
+std::string NormalizePath(const std::string& path) {
+  std::vector<std::string> segments;
+  size_t start = 1;
+  while (true) {
+    size_t end = path.find('/', start);
+    const bool last = end == std::string::npos;
+    if (last) end = path.size();
+    std::string segment = path.substr(start, end - start);
+    if (segment == "..") {
+      if (!segments.empty()) segments.pop_back();
+      if (last) segments.emplace_back();
+    } else if (segment == ".") {
+      if (last) segments.emplace_back();
+    } else {
+      segments.push_back(std::move(segment));
+    }
+    if (last) break;
+    start = end + 1;
+  }
+  std::string result;
+  for (const std::string& segment : segments) {
+    result += '/';
+    result += segment;
+  }
+  return result.empty() ? "/" : result;
+}
+
+// Checks for the segments that invalidSegmentRegEx in JS matches: empty
+// segments and ".", ".." and "node_modules", in any case.
+bool HasInvalidSegment(const std::string& path) {
+  size_t start = 0;
+  while (true) {
+    size_t end = path.find('/', start);
+    if (end == std::string::npos) end = path.size();
+    std::string segment = path.substr(start, end - start);
+    for (char& c : segment) c = ToLower(c);
+    if (segment.empty() || segment == "." || segment == ".." ||
+        segment == "node_modules") {
+      return true;
+    }
+    if (end == path.size()) return false;
+    start = end + 1;
+  }
+}
+
+// Like isArrayIndex() in JS.
+bool IsArrayIndex(const std::string& key) {
+  if (key.empty() || key.size() > 10) return false;
+  if (key.size() > 1 && key[0] == '0') return false;
+  uint64_t value = 0;
+  for (const char c : key) {
+    if (c < '0' || c > '9') return false;
+    value = value * 10 + (c - '0');
+  }
+  return value < 0xFFFFFFFF;
+}
+
+// Like patternKeyCompare() in JS.
+int PatternKeyCompare(const std::string& a, const std::string& b) {
+  const size_t a_pattern_index = a.find('*');
+  const size_t b_pattern_index = b.find('*');
+  const size_t base_len_a =
+      a_pattern_index == std::string::npos ? a.size() : a_pattern_index + 1;
+  const size_t base_len_b =
+      b_pattern_index == std::string::npos ? b.size() : b_pattern_index + 1;
+  if (base_len_a > base_len_b) return -1;
+  if (base_len_b > base_len_a) return 1;
+  if (a_pattern_index == std::string::npos) return 1;
+  if (b_pattern_index == std::string::npos) return -1;
+  if (a.size() > b.size()) return -1;
+  if (b.size() > a.size()) return 1;
+  return 0;
+}
+
+// Finds the best pattern key in `map` for `request`, like the loops in
+// packageExportsResolve() and packageImportsResolve() in JS.
+const JsonValue* FindPatternMatch(const JsonValue& map,
+                                  const std::string& request,
+                                  std::string* match_subpath) {
+  const std::string* best_match = nullptr;
+  const JsonValue* best_target = nullptr;
+  for (const auto& entry : map.object) {
+    const std::string& key = entry.first;
+    const size_t pattern_index = key.find('*');
+    if (pattern_index == std::string::npos ||
+        request.compare(0, pattern_index, key, 0, pattern_index) != 0) {
+      continue;
+    }
+    const std::string trailer = key.substr(pattern_index + 1);
+    if (request.size() >= key.size() && EndsWith(request, trailer) &&
+        PatternKeyCompare(best_match ? *best_match : "", key) == 1 &&
+        key.rfind('*') == pattern_index) {
+      best_match = &key;
+      best_target = &entry.second;
+      *match_subpath = request.substr(
+          pattern_index, request.size() - trailer.size() - pattern_index);
+    }
+  }
+  return best_target;
+}
+
+std::string ReplaceAll(const std::string& str,
+                       char from,
+                       const std::string& to) {
+  std::string result;
+  for (const char c : str) {
+    if (c == from) {
+      result += to;
+    } else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<const PackageJson> ReadPackageJson(Environment* env,
+                                                   const std::string& path) {
+  return package_json::Read(env, path, false);
+}
+
+}  // anonymous namespace
+
+std::shared_ptr<const PackageJson> ModuleResolver::GetPackageScope(
+    const std::string& dir, std::string* package_dir) {
+  std::string current = dir;
+  while (true) {
+    if (EndsWith(current, "node_modules")) break;
+    std::shared_ptr<const PackageJson> pkg =
+        ReadPackageJson(env_, JoinPath(current, "package.json"));
+    if (pkg) {
+      *package_dir = current;
+      return pkg;
+    }
+    if (current == "/") break;
+    current = Dirname(current);
+  }
+  package_dir->clear();
+  return nullptr;
+}
+
+ModuleResolver::TargetResult ModuleResolver::ResolvePackageTarget(
+    const std::string& package_dir,
+    const JsonValue& target,
+    const std::string& subpath,
+    bool pattern,
+    std::string* resolved) {
+  switch (target.type) {
+    case JsonValue::Type::kString: {
+      const std::string& str = target.string;
+      // Bare targets in "imports" need the builtin module list and the
+      // rest of the JS resolver.
+      if (!StartsWith(str, "./") || !IsPlainPath(str) ||
+          HasInvalidSegment(str.substr(2))) {
+        return TargetResult::kFallback;
+      }
+      // Subpaths only come from patterns. Empty ones are not substituted by
+      // the JS implementation.
+      if (pattern == subpath.empty() || !IsPlainPath(subpath) ||
+          (pattern && (HasInvalidSegment(subpath) ||
+                       package_dir.find('*') != std::string::npos))) {
+        return TargetResult::kFallback;
+      }
+      std::string path = JoinPath(package_dir, str.substr(2));
+      if (pattern) path = ReplaceAll(path, '*', subpath);
+      *resolved = std::move(path);
+      return TargetResult::kResolved;
+    }
+    case JsonValue::Type::kArray: {
+      if (target.array.empty()) return TargetResult::kNull;
+      // Items that fail are skipped by the JS implementation, depending on
+      // the error. Let it handle all failures.
+      for (const JsonValue& item : target.array) {
+        switch (ResolvePackageTarget(
+            package_dir, item, subpath, pattern, resolved)) {
+          case TargetResult::kResolved:
+            return TargetResult::kResolved;
+          case TargetResult::kFallback:
+            return TargetResult::kFallback;
+          case TargetResult::kNull:
+          case TargetResult::kUndefined:
+            break;
+        }
+      }
+      return TargetResult::kFallback;
+    }
+    case JsonValue::Type::kObject: {
+      for (const auto& entry : target.object) {
+        if (IsArrayIndex(entry.first)) return TargetResult::kFallback;
+      }
+      for (const auto& entry : target.object) {
+        if (entry.first != "default" &&
+            conditions_.find(entry.first) == conditions_.end()) {
+          continue;
+        }
+        const TargetResult result = ResolvePackageTarget(
+            package_dir, entry.second, subpath, pattern, resolved);
+        if (result == TargetResult::kUndefined) continue;
+        return result;
+      }
+      return TargetResult::kUndefined;
+    }
+    case JsonValue::Type::kNull:
+      return TargetResult::kNull;
+    default:
+      return TargetResult::kFallback;
+  }
+}
+
+std::optional<std::string> ModuleResolver::PackageExportsResolve(
+    const std::string& package_dir,
+    const std::string& subpath,
+    const JsonValue& exports) {
+  // Subpaths ending in "/" are deprecated folder mappings.
+  if (subpath.back() == '/') return std::nullopt;
+
+  // A string, an array or an object of conditions is the target of ".".
+  bool is_sugar = exports.type == JsonValue::Type::kString ||
+                  exports.type == JsonValue::Type::kArray;
+  if (exports.type == JsonValue::Type::kObject) {
+    bool has_subpath_keys = false;
+    bool has_condition_keys = false;
+    for (const auto& entry : exports.object) {
+      if (entry.first.empty() || entry.first[0] != '.') {
+        has_condition_keys = true;
+      } else {
+        has_subpath_keys = true;
+      }
+    }
+    if (has_subpath_keys && has_condition_keys) return std::nullopt;
+    is_sugar = has_condition_keys;
+  } else if (!is_sugar) {
+    return std::nullopt;
+  }
+
+  std::string resolved;
+  const JsonValue* target = is_sugar ? (subpath == "." ? &exports : nullptr)
+                                     : exports.Get(subpath);
+  if (target != nullptr && subpath.find('*') == std::string::npos) {
+    if (ResolvePackageTarget(package_dir, *target, "", false, &resolved) !=
+        TargetResult::kResolved) {
+      return std::nullopt;
+    }
+    return resolved;
+  }
+  if (is_sugar) return std::nullopt;
+
+  std::string match_subpath;
+  target = FindPatternMatch(exports, subpath, &match_subpath);
+  if (target == nullptr ||
+      ResolvePackageTarget(
+          package_dir, *target, match_subpath, true, &resolved) !=
+          TargetResult::kResolved) {
+    return std::nullopt;
+  }
+  return resolved;
+}
+
+std::optional<std::string> ModuleResolver::PackageImportsResolve(
+    const std::string& name, const std::string& parent_dir) {
+  if (name == "#" || StartsWith(name, "#/") || name.back() == '/')
+    return std::nullopt;
+
+  std::string package_dir;
+  std::shared_ptr<const PackageJson> pkg =
+      GetPackageScope(parent_dir, &package_dir);
+  if (!pkg || (pkg->flags & PackageJson::kNeedsParse) ||
+      !pkg->imports_value ||
+      pkg->imports_value->type != JsonValue::Type::kObject) {
+    return std::nullopt;
+  }
+  const JsonValue& imports = *pkg->imports_value;
+
+  std::string resolved;
+  const JsonValue* target = imports.Get(name);
+  std::string match_subpath;
+  bool pattern = false;
+  if (target == nullptr || name.find('*') != std::string::npos) {
+    target = FindPatternMatch(imports, name, &match_subpath);
+    pattern = true;
+  }
+  if (target == nullptr ||
+      ResolvePackageTarget(
+          package_dir, *target, match_subpath, pattern, &resolved) !=
+          TargetResult::kResolved) {
+    return std::nullopt;
+  }
+  return resolved;
+}
+
+std::optional<std::string> ModuleResolver::PackageResolve(
+    const std::string& specifier, const std::string& parent_dir) {
+  size_t separator_index = specifier.find('/');
+  if (specifier[0] == '@') {
+    if (separator_index == std::string::npos) return std::nullopt;
+    separator_index = specifier.find('/', separator_index + 1);
+  }
+  const std::string package_name = specifier.substr(0, separator_index);
+  if (package_name[0] == '.' || package_name.back() == '/' ||
+      !IsPlainPath(specifier)) {
+    return std::nullopt;
+  }
+  const std::string subpath =
+      "." + (separator_index == std::string::npos
+                 ? std::string()
+                 : specifier.substr(separator_index));
+
+  // Resolve the package itself.
+  std::string scope_dir;
+  std::shared_ptr<const PackageJson> scope =
+      GetPackageScope(parent_dir, &scope_dir);
+  if (scope) {
+    if (scope->flags & PackageJson::kNeedsParse) return std::nullopt;
+    if (!(scope->flags & PackageJson::kRawName) &&
+        scope->name == package_name && scope->exports.has_value()) {
+      if (!scope->exports_value) return std::nullopt;
+      if (scope->exports_value->type != JsonValue::Type::kNull) {
+        return PackageExportsResolve(
+            scope_dir, subpath, *scope->exports_value);
+      }
+    }
+  }
+
+  std::string dir = parent_dir;
+  while (true) {
+    const std::string package_dir =
+        JoinPath(JoinPath(dir, "node_modules"), package_name);
+    if (GetFileType(package_dir) == FileType::kDirectory) {
+      std::shared_ptr<const PackageJson> pkg =
+          ReadPackageJson(env_, JoinPath(package_dir, "package.json"));
+      if (pkg && (pkg->flags & PackageJson::kNeedsParse)) return std::nullopt;
+      if (pkg && pkg->exports.has_value()) {
+        if (!pkg->exports_value) return std::nullopt;
+        if (pkg->exports_value->type != JsonValue::Type::kNull) {
+          return PackageExportsResolve(
+              package_dir, subpath, *pkg->exports_value);
+        }
+      }
+      if (subpath == ".") {
+        // Only the exact "main" file. Everything else is a deprecated
+        // guess, which the JS implementation warns about.
+        if (!pkg || !pkg->main.has_value() ||
+            (pkg->flags & PackageJson::kRawMain) ||
+            !IsPlainPath(pkg->main.value()) ||
+            StartsWith(pkg->main.value(), "/")) {
+          return std::nullopt;
+        }
+        const std::string main =
+            NormalizePath(JoinPath(package_dir, pkg->main.value()));
+        if (GetFileType(main) != FileType::kFile) return std::nullopt;
+        return main;
+      }
+      return JoinPath(package_dir, subpath.substr(2));
+    }
+    if (dir == "/") return std::nullopt;
+    dir = Dirname(dir);
+  }
+}
+
+std::optional<std::string> ModuleResolver::FinalizeResolution(
+    const std::string& path) {
+  const std::string normalized = NormalizePath(path);
+  if (normalized.back() == '/') return std::nullopt;
+  // Directories and missing files are errors.
+  if (GetFileType(normalized) != FileType::kFile) return std::nullopt;
+  if (preserve_symlinks_) return normalized;
+  return RealPath(normalized);
+}
+
+std::optional<std::string> ModuleResolver::Resolve(
+    const std::string& specifier, const std::string& parent_path) {
+  if (specifier.empty() || parent_path.empty() || parent_path[0] != '/')
+    return std::nullopt;
+  const std::string parent_dir = Dirname(parent_path);
+
+  std::optional<std::string> resolved;
+  if (specifier[0] == '/' || specifier == "." || specifier == ".." ||
+      StartsWith(specifier, "./") || StartsWith(specifier, "../")) {
+    // "//" starts a URL with a host.
+    if (StartsWith(specifier, "//") || !IsPlainPath(specifier))
+      return std::nullopt;
+    resolved = specifier[0] == '/' ? specifier
+                                   : JoinPath(parent_dir, specifier);
+  } else if (specifier[0] == '#') {
+    // The name is only used as a key. Pattern matches are checked when
+    // they are substituted into the target.
+    resolved = PackageImportsResolve(specifier, parent_dir);
+  } else {
+    // Specifiers with a colon may be URLs.
+    if (specifier.find(':') != std::string::npos) return std::nullopt;
+    resolved = PackageResolve(specifier, parent_dir);
+  }
+  if (!resolved.has_value()) return std::nullopt;
+  return FinalizeResolution(resolved.value());
+}
+
+void ModuleResolver::Resolve(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsString());
+  CHECK(args[2]->IsArray());
+  Utf8Value specifier(isolate, args[0]);
+  Utf8Value parent_path(isolate, args[1]);
+
+  std::unordered_set<std::string> conditions;
+  Local<Array> conditions_array = args[2].As<Array>();
+  for (uint32_t i = 0; i < conditions_array->Length(); i++) {
+    Local<Value> condition;
+    if (!conditions_array->Get(context, i).ToLocal(&condition)) return;
+    if (!condition->IsString()) return;
+    conditions.emplace(*Utf8Value(isolate, condition));
+  }
+
+  ModuleResolver resolver(env, std::move(conditions), args[3]->IsTrue());
+  std::optional<std::string> resolved =
+      resolver.Resolve(specifier.ToString(), parent_path.ToString());
+  if (!resolved.has_value()) return;
+
+  Local<Value> result;
+  if (!ToV8Value(context, resolved.value()).ToLocal(&result)) return;
+  args.GetReturnValue().Set(result);
+}
+
+}  // namespace loader
+}  // namespace node
@@ -0,0 +1,91 @@
+#ifndef SRC_MODULE_RESOLVER_H_
+#define SRC_MODULE_RESOLVER_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include "v8.h"
+
+namespace node {
+class Environment;
+
+namespace package_json {
+struct JsonValue;
+struct PackageJson;
+}  // namespace package_json
+
+namespace loader {
+
+// Implements the ESM resolution algorithm for file: URLs on path strings,
+// for the common cases of relative and absolute specifiers, package
+// "exports" and "imports", and packages without "exports". Whenever the
+// algorithm would throw or emit a deprecation warning, or the specifier needs
+// URL parsing (e.g. percent-encoding or query strings), resolution is left to
+// the JS implementation in lib/internal/modules/esm/resolve.js, which
+// produces the errors and warnings.
+//
+// File system lookups go through a process-wide cache of the files and
+// directories that were found, and of real paths.
+class ModuleResolver {
+ public:
+  ModuleResolver(Environment* env,
+                 std::unordered_set<std::string> conditions,
+                 bool preserve_symlinks)
+      : env_(env),
+        conditions_(std::move(conditions)),
+        preserve_symlinks_(preserve_symlinks) {}
+
+  // Returns the resolved path, or std::nullopt if the JS implementation has
+  // to take over.
+  std::optional<std::string> Resolve(const std::string& specifier,
+                                     const std::string& parent_path);
+
+  // resolve(specifier, parentPath, conditions, preserveSymlinks) returns the
+  // resolved path or undefined.
+  static void Resolve(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+ private:
+  // The result of resolving a package target. kNull and kUndefined mirror
+  // the null and undefined results of resolvePackageTarget() in JS.
+  enum class TargetResult {
+    kResolved,
+    kNull,
+    kUndefined,
+    kFallback,
+  };
+
+  std::optional<std::string> PackageResolve(const std::string& specifier,
+                                            const std::string& parent_dir);
+  std::optional<std::string> PackageExportsResolve(
+      const std::string& package_dir,
+      const std::string& subpath,
+      const package_json::JsonValue& exports);
+  std::optional<std::string> PackageImportsResolve(
+      const std::string& name, const std::string& parent_dir);
+  TargetResult ResolvePackageTarget(const std::string& package_dir,
+                                    const package_json::JsonValue& target,
+                                    const std::string& subpath,
+                                    bool pattern,
+                                    std::string* resolved);
+  std::optional<std::string> FinalizeResolution(const std::string& path);
+
+  // Returns the directory and the contents of the closest package.json,
+  // like getPackageScopeConfig() in JS. `package_dir` is empty if there is
+  // none.
+  std::shared_ptr<const package_json::PackageJson> GetPackageScope(
+      const std::string& dir, std::string* package_dir);
+
+  Environment* env_;
+  std::unordered_set<std::string> conditions_;
+  bool preserve_symlinks_;
+};
+
+}  // namespace loader
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_MODULE_RESOLVER_H_
@@ -2,12 +2,14 @@
 
 #include "env.h"
 #include "memory_tracker-inl.h"
+#include "module_resolver.h"
 #include "node_contextify.h"
 #include "node_errors.h"
 #include "node_internals.h"
 #include "node_process-inl.h"
 #include "node_url.h"
 #include "node_watchdog.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
 #include <sys/stat.h>  // S_IFDIR
@@ -51,6 +53,9 @@ using v8::UnboundModuleScript;
 using v8::Undefined;
 using v8::Value;
 
+using UniqueStreamingTask =
+    std::unique_ptr<ScriptCompiler::ScriptStreamingTask>;
+
 ModuleWrap::ModuleWrap(Environment* env,
                        Local<Object> object,
                        Local<Module> module,
@@ -138,7 +143,8 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
     // new ModuleWrap(url, context, exportNames, syntheticExecutionFunction)
     CHECK(args[3]->IsFunction());
   } else {
-    // new ModuleWrap(url, context, source, lineOffset, columOffset, cachedData)
+    // new ModuleWrap(url, context, source, lineOffset, columOffset,
+    //                cachedData, useCompileCache, compileJob)
     CHECK(args[2]->IsString());
     CHECK(args[3]->IsNumber());
     line_offset = args[3].As<Int32>()->Value();
@@ -186,6 +192,24 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
       }
 
       Local<String> source_text = args[2].As<String>();
+      CompileCacheHandler* cache_handler = env->compile_cache_handler();
+      std::unique_ptr<CompileCacheEntry> cache_entry;
+      ScriptCompiler::StreamedSource* streamed_source = nullptr;
+      if (args[7]->IsObject()) {
+        CHECK_NULL(cached_data);
+        ModuleCompileJob* job;
+        ASSIGN_OR_RETURN_UNWRAP(&job, args[7]);
+        // The job has already looked up the compile cache.
+        cache_entry = job->TakeCacheEntry();
+        streamed_source = job->streamed_source();
+      } else if (cached_data == nullptr && args[6]->IsTrue() &&
+                 cache_handler != nullptr) {
+        cache_entry =
+            cache_handler->Get(source_text, url, CachedCodeType::kESM);
+      }
+      if (cache_entry && !cache_entry->cache.empty())
+        cached_data = cache_entry->CopyCache();
+
       ScriptOrigin origin(isolate,
                           url,
                           line_offset,
@@ -204,8 +228,15 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
       } else {
         options = ScriptCompiler::kConsumeCodeCache;
       }
-      if (!ScriptCompiler::CompileModule(isolate, &source, options)
-               .ToLocal(&module)) {
+      MaybeLocal<Module> maybe_module;
+      if (streamed_source != nullptr) {
+        CHECK_NULL(cached_data);
+        maybe_module = ScriptCompiler::CompileModule(
+            context, streamed_source, source_text, origin);
+      } else {
+        maybe_module = ScriptCompiler::CompileModule(isolate, &source, options);
+      }
+      if (!maybe_module.ToLocal(&module)) {
         if (try_catch.HasCaught() && !try_catch.HasTerminated()) {
           CHECK(!try_catch.Message().IsEmpty());
           CHECK(!try_catch.Exception().IsEmpty());
@@ -215,8 +246,15 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         }
         return;
       }
-      if (options == ScriptCompiler::kConsumeCodeCache &&
-          source.GetCachedData()->rejected) {
+      if (cache_entry) {
+        // A stale cache on disk is not an error, it is replaced instead.
+        cache_handler->MaybeSave(
+            cache_entry.get(),
+            module,
+            options == ScriptCompiler::kConsumeCodeCache &&
+                source.GetCachedData()->rejected);
+      } else if (options == ScriptCompiler::kConsumeCodeCache &&
+                 source.GetCachedData()->rejected) {
         THROW_ERR_VM_MODULE_CACHED_DATA_REJECTED(
             env, "cachedData buffer was rejected");
         try_catch.ReThrow();
@@ -760,6 +798,167 @@ void ModuleWrap::CreateCachedData(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Hands the whole source to V8 in a single chunk.
+class SourceStream final : public ScriptCompiler::ExternalSourceStream {
+ public:
+  SourceStream(std::unique_ptr<uint8_t[]> data, size_t length)
+      : data_(std::move(data)), length_(length) {}
+
+  size_t GetMoreData(const uint8_t** src) override {
+    if (!data_ || length_ == 0) return 0;
+    // V8 takes ownership of the chunk.
+    *src = data_.release();
+    return length_;
+  }
+
+ private:
+  std::unique_ptr<uint8_t[]> data_;
+  size_t length_;
+};
+
+class ModuleCompileJob::StreamingWork final : public ThreadPoolWork {
+ public:
+  StreamingWork(ModuleCompileJob* job,
+                UniqueStreamingTask task,
+                Local<Promise::Resolver> resolver)
+      : ThreadPoolWork(job->env()),
+        job_(job),
+        task_(std::move(task)),
+        resolver_(job->env()->isolate(), resolver) {}
+
+  void DoThreadPoolWork() override { task_->Run(); }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<StreamingWork> self(this);
+    Environment* env = job_->env();
+    // The source is only complete if the task has run.
+    if (status == UV_ECANCELED) {
+      job_->streamed_source_.reset();
+      return;
+    }
+    job_->finished_ = true;
+    if (!env->can_call_into_js()) return;
+
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+    InternalCallbackScope callback_scope(
+        env,
+        job_->object(),
+        {0, 0},
+        InternalCallbackScope::kSkipAsyncHooks);
+    USE(resolver_.Get(isolate)->Resolve(env->context(), Undefined(isolate)));
+  }
+
+ private:
+  BaseObjectPtr<ModuleCompileJob> job_;
+  UniqueStreamingTask task_;
+  v8::Global<Promise::Resolver> resolver_;
+};
+
+ModuleCompileJob::ModuleCompileJob(Environment* env, Local<Object> object)
+    : BaseObject(env, object) {
+  MakeWeak();
+}
+
+ModuleCompileJob::~ModuleCompileJob() = default;
+
+ScriptCompiler::StreamedSource* ModuleCompileJob::streamed_source() const {
+  CHECK(!started_ || finished_ || !streamed_source_);
+  return finished_ ? streamed_source_.get() : nullptr;
+}
+
+std::unique_ptr<CompileCacheEntry> ModuleCompileJob::TakeCacheEntry() {
+  return std::move(cache_entry_);
+}
+
+void ModuleCompileJob::MemoryInfo(MemoryTracker* tracker) const {
+  if (streamed_source_) tracker->TrackFieldWithSize("source", source_size_);
+  if (cache_entry_)
+    tracker->TrackFieldWithSize("cache", cache_entry_->cache.size());
+}
+
+// new ModuleCompileJob(url, source, useCompileCache)
+void ModuleCompileJob::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsString());
+  Local<String> url = args[0].As<String>();
+  Local<String> source = args[1].As<String>();
+
+  ModuleCompileJob* job = new ModuleCompileJob(env, args.This());
+
+  CompileCacheHandler* cache_handler = env->compile_cache_handler();
+  if (args[2]->IsTrue() && cache_handler != nullptr) {
+    job->cache_entry_ = cache_handler->Get(source, url, CachedCodeType::kESM);
+    // Consuming the cache is cheaper than parsing in the background.
+    if (job->cache_entry_ && !job->cache_entry_->cache.empty()) return;
+  }
+
+  // Copy the source without converting it, so that the background thread
+  // does not touch the heap.
+  const int length = source->Length();
+  std::unique_ptr<uint8_t[]> data;
+  ScriptCompiler::StreamedSource::Encoding encoding;
+  if (source->IsOneByte()) {
+    job->source_size_ = length;
+    data.reset(new uint8_t[job->source_size_]);
+    source->WriteOneByte(
+        isolate, data.get(), 0, length, String::NO_NULL_TERMINATION);
+    encoding = ScriptCompiler::StreamedSource::ONE_BYTE;
+  } else {
+    job->source_size_ = length * sizeof(uint16_t);
+    data.reset(new uint8_t[job->source_size_]);
+    source->Write(isolate,
+                  reinterpret_cast<uint16_t*>(data.get()),
+                  0,
+                  length,
+                  String::NO_NULL_TERMINATION);
+    encoding = ScriptCompiler::StreamedSource::TWO_BYTE;
+  }
+
+  job->streamed_source_ = std::make_unique<ScriptCompiler::StreamedSource>(
+      std::make_unique<SourceStream>(std::move(data), job->source_size_),
+      encoding);
+  job->streaming_task_.reset(ScriptCompiler::StartStreaming(
+      isolate, job->streamed_source_.get(), v8::ScriptType::kModule));
+  if (!job->streaming_task_) job->streamed_source_.reset();
+}
+
+// run() returns a promise that is resolved once the source has been parsed.
+void ModuleCompileJob::Run(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ModuleCompileJob* job;
+  ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+  CHECK(!job->started_);
+  job->started_ = true;
+
+  Local<Promise::Resolver> resolver;
+  if (!Promise::Resolver::New(env->context()).ToLocal(&resolver)) return;
+  args.GetReturnValue().Set(resolver->GetPromise());
+
+  if (!job->streaming_task_) {
+    USE(resolver->Resolve(env->context(), Undefined(env->isolate())));
+    return;
+  }
+  auto* work = new StreamingWork(
+      job, std::move(job->streaming_task_), resolver);
+  work->ScheduleWork();
+}
+
+void ModuleCompileJob::Initialize(Environment* env, Local<Object> target) {
+  Isolate* isolate = env->isolate();
+  Local<FunctionTemplate> tpl = NewFunctionTemplate(isolate, New);
+  tpl->InstanceTemplate()->SetInternalFieldCount(
+      ModuleCompileJob::kInternalFieldCount);
+  tpl->Inherit(BaseObject::GetConstructorTemplate(env));
+  SetProtoMethod(isolate, tpl, "run", Run);
+  SetConstructorFunction(env->context(), target, "ModuleCompileJob", tpl);
+}
+
 void ModuleWrap::Initialize(Local<Object> target,
                             Local<Value> unused,
                             Local<Context> context,
@@ -787,6 +986,7 @@ void ModuleWrap::Initialize(Local<Object> target,
                              GetStaticDependencySpecifiers);
 
   SetConstructorFunction(context, target, "ModuleWrap", tpl);
+  ModuleCompileJob::Initialize(env, target);
 
   SetMethod(context,
             target,
@@ -796,6 +996,7 @@ void ModuleWrap::Initialize(Local<Object> target,
             target,
             "setInitializeImportMetaObjectCallback",
             SetInitializeImportMetaObjectCallback);
+  SetMethod(context, target, "resolve", ModuleResolver::Resolve);
 
 #define V(name)                                                                \
     target->Set(context,                                                       \
@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <memory>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -11,6 +12,7 @@
 namespace node {
 
 class Environment;
+struct CompileCacheEntry;
 
 namespace contextify {
 class ContextifyContext;
@@ -108,6 +110,48 @@ class ModuleWrap : public BaseObject {
   uint32_t id_;
 };
 
+// Parses the source of a module on the thread pool, so that the modules of a
+// graph can be parsed in parallel while the loader fetches the rest of the
+// graph. The job is then passed to the ModuleWrap constructor, which finishes
+// the compilation on the main thread.
+//
+//   const job = new ModuleCompileJob(url, source, useCompileCache);
+//   await job.run();
+//   const wrap = new ModuleWrap(url, undefined, source, 0, 0, undefined,
+//                               useCompileCache, job);
+//
+// If the module is found in the compile cache, or V8 cannot stream it, there
+// is nothing to do in the background and it is compiled by the constructor.
+class ModuleCompileJob : public BaseObject {
+ public:
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+  // Only valid once run() has completed. Returns nullptr if the module has to
+  // be compiled from its source.
+  v8::ScriptCompiler::StreamedSource* streamed_source() const;
+  std::unique_ptr<CompileCacheEntry> TakeCacheEntry();
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(ModuleCompileJob)
+  SET_SELF_SIZE(ModuleCompileJob)
+
+ private:
+  class StreamingWork;
+
+  ModuleCompileJob(Environment* env, v8::Local<v8::Object> object);
+  ~ModuleCompileJob() override;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Run(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  std::unique_ptr<CompileCacheEntry> cache_entry_;
+  std::unique_ptr<v8::ScriptCompiler::StreamedSource> streamed_source_;
+  std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask> streaming_task_;
+  size_t source_size_ = 0;
+  bool started_ = false;
+  bool finished_ = false;
+};
+
 }  // namespace loader
 }  // namespace node
 
@@ -1099,20 +1099,13 @@ int LoadSnapshotDataAndRun(const SnapshotData** snapshot_data_ptr,
   // --snapshot-blob indicates that we are reading a customized snapshot.
   if (!per_process::cli_options->snapshot_blob.empty()) {
     std::string filename = per_process::cli_options->snapshot_blob;
-    FILE* fp = fopen(filename.c_str(), "rb");
-    if (fp == nullptr) {
-      fprintf(stderr, "Cannot open %s", filename.c_str());
-      exit_code = 1;
-      return exit_code;
-    }
     std::unique_ptr<SnapshotData> read_data = std::make_unique<SnapshotData>();
-    if (!SnapshotData::FromBlob(read_data.get(), fp)) {
+    if (!SnapshotData::FromFile(read_data.get(), filename)) {
       // If we fail to read the customized snapshot, simply exit with 1.
       exit_code = 1;
       return exit_code;
     }
     *snapshot_data_ptr = read_data.release();
-    fclose(fp);
   } else if (per_process::cli_options->node_snapshot) {
     // If --snapshot-blob is not specified, we are reading the embedded
     // snapshot, but we will skip it if --no-node-snapshot is specified.
@@ -1127,6 +1120,7 @@ int LoadSnapshotDataAndRun(const SnapshotData** snapshot_data_ptr,
 
   if ((*snapshot_data_ptr) != nullptr) {
     BuiltinLoader::RefreshCodeCache((*snapshot_data_ptr)->code_cache);
+    BuiltinLoader::RefreshCodeCache((*snapshot_data_ptr)->mapped_code_cache);
   }
   NodeMainInstance main_instance(*snapshot_data_ptr,
                                  uv_default_loop(),
@@ -267,6 +267,11 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
                      id,
                      has_cache ? "with" : "without");
 
+  TRACE_EVENT_BEGIN1(TRACING_CATEGORY_NODE1(builtins),
+                     "BuiltinLoader::Compile",
+                     "id",
+                     TRACE_STR_COPY(id));
+
   MaybeLocal<Function> maybe_fun =
       ScriptCompiler::CompileFunction(context,
                                       &script_source,
@@ -280,6 +285,8 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
   // e.g. the syntax errors
   Local<Function> fun;
   if (!maybe_fun.ToLocal(&fun)) {
+    TRACE_EVENT_END0(TRACING_CATEGORY_NODE1(builtins),
+                     "BuiltinLoader::Compile");
     // In the case of early errors, v8 is already capable of
     // decorating the stack for us - note that we use CompileFunction
     // so there is no need to worry about wrappers.
@@ -295,6 +302,13 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
                 ? Result::kWithCache
                 : Result::kWithoutCache;
 
+  TRACE_EVENT_END1(TRACING_CATEGORY_NODE1(builtins),
+                   "BuiltinLoader::Compile",
+                   "code_cache",
+                   !has_cache ? "none"
+                   : script_source.GetCachedData()->rejected ? "rejected"
+                                                             : "accepted");
+
   if (has_cache) {
     per_process::Debug(DebugCategory::CODE_CACHE,
                        "Code cache of %s (%s) %s\n",
@@ -515,6 +529,19 @@ void BuiltinLoader::RefreshCodeCache(const std::vector<CodeCacheInfo>& in) {
   loader->has_code_cache_ = true;
 }
 
+void BuiltinLoader::RefreshCodeCache(const std::vector<CodeCacheRef>& in) {
+  BuiltinLoader* loader = GetInstance();
+  Mutex::ScopedLock lock(loader->code_cache_mutex());
+  auto out = loader->code_cache();
+  for (auto const& item : in) {
+    (*out)[item.id] = std::make_unique<v8::ScriptCompiler::CachedData>(
+        item.data,
+        static_cast<int>(item.length),
+        v8::ScriptCompiler::CachedData::BufferNotOwned);
+  }
+  loader->has_code_cache_ = true;
+}
+
 void BuiltinLoader::GetBuiltinCategories(
     Local<Name> property, const PropertyCallbackInfo<Value>& info) {
   Environment* env = Environment::GetCurrent(info);
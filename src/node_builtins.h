@@ -32,6 +32,15 @@ struct CodeCacheInfo {
   std::vector<uint8_t> data;
 };
 
+// A code cache that lives in memory that is not owned by the loader, e.g. a
+// memory-mapped snapshot blob. The memory must stay valid for the lifetime of
+// the process.
+struct CodeCacheRef {
+  std::string id;
+  const uint8_t* data;
+  size_t length;
+};
+
 // Handles compilation and caching of built-in JavaScript modules and
 // bootstrap scripts, whose source are bundled into the binary as static data.
 class NODE_EXTERN_PRIVATE BuiltinLoader {
@@ -70,6 +79,9 @@ class NODE_EXTERN_PRIVATE BuiltinLoader {
 
   static bool CompileAllBuiltins(v8::Local<v8::Context> context);
   static void RefreshCodeCache(const std::vector<CodeCacheInfo>& in);
+  // Unlike the overload above, this does not copy the code cache, so that
+  // only the caches of the built-ins that are compiled are ever read.
+  static void RefreshCodeCache(const std::vector<CodeCacheRef>& in);
   static void CopyCodeCache(std::vector<CodeCacheInfo>* out);
 
  private:
@@ -1102,12 +1102,23 @@ void ContextifyContext::CompileFunction(
     params_buf = args[8].As<Array>();
   }
 
+  // Argument 10: use the compile cache (optional)
+  CompileCacheHandler* cache_handler = env->compile_cache_handler();
+  std::unique_ptr<CompileCacheEntry> cache_entry;
+  if (args[9]->IsTrue() && cached_data_buf.IsEmpty() &&
+      cache_handler != nullptr) {
+    cache_entry =
+        cache_handler->Get(code, filename, CachedCodeType::kCommonJS);
+  }
+
   // Read cache from cached data buffer
   ScriptCompiler::CachedData* cached_data = nullptr;
   if (!cached_data_buf.IsEmpty()) {
     uint8_t* data = static_cast<uint8_t*>(cached_data_buf->Buffer()->Data());
     cached_data = new ScriptCompiler::CachedData(
       data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
+  } else if (cache_entry && !cache_entry->cache.empty()) {
+    cached_data = cache_entry->CopyCache();
   }
 
   // Get the function id
@@ -1187,6 +1198,13 @@ void ContextifyContext::CompileFunction(
     return;
   }
 
+  if (cache_entry) {
+    cache_handler->MaybeSave(
+        cache_entry.get(),
+        fn,
+        source.GetCachedData() != nullptr && source.GetCachedData()->rejected);
+  }
+
   Local<Object> cache_key;
   if (!env->compiled_fn_entry_template()->NewInstance(
            context).ToLocal(&cache_key)) {
@@ -1239,13 +1257,48 @@ CompiledFnEntry::CompiledFnEntry(Environment* env,
                                  Local<Object> object,
                                  uint32_t id,
                                  Local<Function> fn)
-    : BaseObject(env, object), id_(id), fn_(env->isolate(), fn) {
+    : SnapshotableObject(env, object, type_int),
+      id_(id),
+      fn_(env->isolate(), fn) {
   fn_.SetWeak(this, WeakCallback, v8::WeakCallbackType::kParameter);
 }
 
 CompiledFnEntry::~CompiledFnEntry() {
   env()->id_to_function_map.erase(id_);
-  fn_.ClearWeak();
+  if (!fn_.IsEmpty()) fn_.ClearWeak();
+}
+
+bool CompiledFnEntry::PrepareForSerialization(Local<Context> context,
+                                              v8::SnapshotCreator* creator) {
+  // The function is kept alive by the snapshot, like the entry itself.
+  fn_index_ = creator->AddData(context, fn_.Get(context->GetIsolate()));
+  fn_.Reset();
+  return true;
+}
+
+InternalFieldInfoBase* CompiledFnEntry::Serialize(int index) {
+  DCHECK_EQ(index, BaseObject::kEmbedderType);
+  InternalFieldInfo* info =
+      InternalFieldInfoBase::New<InternalFieldInfo>(type());
+  info->id = id_;
+  info->fn = fn_index_;
+  return info;
+}
+
+void CompiledFnEntry::Deserialize(Local<Context> context,
+                                  Local<Object> holder,
+                                  int index,
+                                  InternalFieldInfoBase* info) {
+  DCHECK_EQ(index, BaseObject::kEmbedderType);
+  HandleScope scope(context->GetIsolate());
+  Environment* env = Environment::GetCurrent(context);
+  InternalFieldInfo* entry_info = reinterpret_cast<InternalFieldInfo*>(info);
+  Local<Function> fn =
+      context->GetDataFromSnapshotOnce<Function>(entry_info->fn)
+          .ToLocalChecked();
+  CompiledFnEntry* entry = new CompiledFnEntry(env, holder, entry_info->id, fn);
+  env->id_to_function_map.emplace(entry_info->id, entry);
+  env->ReserveFunctionId(entry_info->id);
 }
 
 static void StartSigintWatchdog(const FunctionCallbackInfo<Value>& args) {
@@ -1286,6 +1339,35 @@ static void MeasureMemory(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(promise);
 }
 
+// enableCompileCache(directory) returns 0 or a libuv error code.
+static void EnableCompileCache(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());
+  Utf8Value dir(env->isolate(), args[0]);
+  args.GetReturnValue().Set(env->EnableCompileCache(dir.ToString()));
+}
+
+// Returns [directory, hits, misses, rejected, written], or undefined if the
+// compile cache is not enabled.
+static void GetCompileCacheStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  CompileCacheHandler* handler = env->compile_cache_handler();
+  if (handler == nullptr) return;
+
+  const CompileCacheHandler::Stats& stats = handler->stats();
+  Local<Value> dir;
+  if (!ToV8Value(env->context(), handler->cache_dir()).ToLocal(&dir)) return;
+  Local<Value> result[] = {
+      dir,
+      Number::New(isolate, static_cast<double>(stats.hits)),
+      Number::New(isolate, static_cast<double>(stats.misses)),
+      Number::New(isolate, static_cast<double>(stats.rejected)),
+      Number::New(isolate, static_cast<double>(stats.written)),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, result, arraysize(result)));
+}
+
 MicrotaskQueueWrap::MicrotaskQueueWrap(Environment* env, Local<Object> obj)
   : BaseObject(env, obj),
     microtask_queue_(
@@ -1370,6 +1452,9 @@ void Initialize(Local<Object> target,
   target->Set(context, env->constants_string(), constants).Check();
 
   SetMethod(context, target, "measureMemory", MeasureMemory);
+  SetMethod(context, target, "enableCompileCache", EnableCompileCache);
+  SetMethodNoSideEffect(
+      context, target, "getCompileCacheStats", GetCompileCacheStats);
 }
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
@@ -1381,6 +1466,8 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(StopSigintWatchdog);
   registry->Register(WatchdogHasPendingSigint);
   registry->Register(MeasureMemory);
+  registry->Register(EnableCompileCache);
+  registry->Register(GetCompileCacheStats);
 }
 }  // namespace contextify
 }  // namespace node
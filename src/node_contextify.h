@@ -6,6 +6,7 @@
 #include "base_object-inl.h"
 #include "node_context_data.h"
 #include "node_errors.h"
+#include "node_snapshotable.h"
 
 namespace node {
 class ExternalReferenceRegistry;
@@ -173,12 +174,27 @@ class ContextifyScript : public BaseObject {
   uint32_t id_;
 };
 
-class CompiledFnEntry final : public BaseObject {
+// Keeps track of a function compiled by compileFunction(), so that its id
+// can be used to look up the dynamic import() callback for it. Functions
+// compiled while building a startup snapshot, e.g. CommonJS modules, are
+// restored together with their ids.
+class CompiledFnEntry final : public SnapshotableObject {
  public:
+  SERIALIZABLE_OBJECT_METHODS()
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(CompiledFnEntry)
   SET_SELF_SIZE(CompiledFnEntry)
 
+  static constexpr FastStringKey type_name{
+      "node::contextify::CompiledFnEntry"};
+  static constexpr EmbedderObjectType type_int =
+      EmbedderObjectType::k_compiled_fn_entry;
+
+  struct InternalFieldInfo : public node::InternalFieldInfoBase {
+    uint32_t id;
+    SnapshotIndex fn;
+  };
+
   CompiledFnEntry(Environment* env,
                   v8::Local<v8::Object> object,
                   uint32_t id,
@@ -190,6 +206,7 @@ class CompiledFnEntry final : public BaseObject {
  private:
   uint32_t id_;
   v8::Global<v8::Function> fn_;
+  SnapshotIndex fn_index_ = 0;
 
   static void WeakCallback(const v8::WeakCallbackInfo<CompiledFnEntry>& data);
 };
@@ -1,8 +1,11 @@
 #include "node_dir.h"
+#include "node_buffer.h"
 #include "node_external_reference.h"
 #include "node_file-inl.h"
+#include "node_mutex.h"
 #include "node_process-inl.h"
 #include "memory_tracker-inl.h"
+#include "threadpoolwork-inl.h"
 #include "util.h"
 
 #include "tracing/trace_event.h"
@@ -16,8 +19,16 @@
 #include <cerrno>
 #include <climits>
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
 namespace node {
 
 namespace fs_dir {
@@ -28,6 +39,7 @@ using fs::FSReqWrapSync;
 using fs::GetReqWrap;
 
 using v8::Array;
+using v8::ArrayBuffer;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -40,6 +52,9 @@ using v8::Null;
 using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
+using v8::TryCatch;
+using v8::Uint32Array;
+using v8::Uint8Array;
 using v8::Value;
 
 static const char* get_dir_func_name_by_type(uv_fs_type req_type) {
@@ -275,6 +290,14 @@ static void AfterDirRead(uv_fs_t* req) {
 }
 
 
+void DirHandle::SetBufferSize(size_t buffer_size) {
+  if (buffer_size != dirents_.size()) {
+    dirents_.resize(buffer_size);
+    dir_->nentries = buffer_size;
+    dir_->dirents = dirents_.data();
+  }
+}
+
 void DirHandle::Read(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -288,13 +311,7 @@ void DirHandle::Read(const FunctionCallbackInfo<Value>& args) {
   ASSIGN_OR_RETURN_UNWRAP(&dir, args.Holder());
 
   CHECK(args[1]->IsNumber());
-  uint64_t buffer_size = static_cast<uint64_t>(args[1].As<Number>()->Value());
-
-  if (buffer_size != dir->dirents_.size()) {
-    dir->dirents_.resize(buffer_size);
-    dir->dir_->nentries = buffer_size;
-    dir->dir_->dirents = dir->dirents_.data();
-  }
+  dir->SetBufferSize(static_cast<size_t>(args[1].As<Number>()->Value()));
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 2);
   if (req_wrap_async != nullptr) {  // dir.read(encoding, bufferSize, req)
@@ -338,6 +355,120 @@ void DirHandle::Read(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Returns [names, offsets, types], where `names` is a Buffer holding all
+// file names back to back, name `i` spans offsets[i] to offsets[i + 1], and
+// types[i] is its UV_DIRENT_* type. This avoids creating a string per entry.
+static MaybeLocal<Array> DirentListToPacked(Environment* env,
+                                            uv_dirent_t* ents,
+                                            int num) {
+  Isolate* isolate = env->isolate();
+
+  Local<ArrayBuffer> offsets_ab =
+      ArrayBuffer::New(isolate, (num + 1) * sizeof(uint32_t));
+  uint32_t* offsets = static_cast<uint32_t*>(offsets_ab->Data());
+  Local<ArrayBuffer> types_ab = ArrayBuffer::New(isolate, num);
+  uint8_t* types = static_cast<uint8_t*>(types_ab->Data());
+
+  size_t total = 0;
+  for (int i = 0; i < num; i++) {
+    offsets[i] = static_cast<uint32_t>(total);
+    total += strlen(ents[i].name);
+    types[i] = static_cast<uint8_t>(ents[i].type);
+  }
+  offsets[num] = static_cast<uint32_t>(total);
+
+  Local<Object> names;
+  if (!Buffer::New(isolate, total).ToLocal(&names)) return MaybeLocal<Array>();
+  char* data = Buffer::Data(names);
+  for (int i = 0; i < num; i++)
+    memcpy(data + offsets[i], ents[i].name, offsets[i + 1] - offsets[i]);
+
+  Local<Value> result[] = {
+      names,
+      Uint32Array::New(offsets_ab, 0, num + 1),
+      Uint8Array::New(types_ab, 0, num),
+  };
+  return Array::New(isolate, result, arraysize(result));
+}
+
+static void AfterDirReadPacked(uv_fs_t* req) {
+  BaseObjectPtr<FSReqBase> req_wrap { FSReqBase::from_req(req) };
+  FSReqAfterScope after(req_wrap.get(), req);
+  FS_DIR_ASYNC_TRACE_END1(
+      req->fs_type, req_wrap, "result", static_cast<int>(req->result))
+  if (!after.Proceed()) {
+    return;
+  }
+
+  Environment* env = req_wrap->env();
+
+  if (req->result == 0) {
+    // Done
+    after.Clear();
+    req_wrap->Resolve(Null(env->isolate()));
+    return;
+  }
+
+  uv_dir_t* dir = static_cast<uv_dir_t*>(req->ptr);
+  TryCatch try_catch(env->isolate());
+  Local<Array> packed;
+  if (!DirentListToPacked(env, dir->dirents, static_cast<int>(req->result))
+           .ToLocal(&packed)) {
+    after.Clear();
+    if (try_catch.HasCaught() && !try_catch.HasTerminated())
+      req_wrap->Reject(try_catch.Exception());
+    return;
+  }
+
+  // As in AfterDirRead(), release libuv resources before calling into JS.
+  after.Clear();
+  req_wrap->Resolve(packed);
+}
+
+void DirHandle::ReadPacked(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  DirHandle* dir;
+  ASSIGN_OR_RETURN_UNWRAP(&dir, args.Holder());
+
+  CHECK(args[0]->IsNumber());
+  dir->SetBufferSize(static_cast<size_t>(args[0].As<Number>()->Value()));
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 1);
+  if (req_wrap_async != nullptr) {  // dir.readPacked(bufferSize, req)
+    FS_DIR_ASYNC_TRACE_BEGIN0(UV_FS_READDIR, req_wrap_async)
+    AsyncCall(env, req_wrap_async, args, "readdir", BUFFER,
+              AfterDirReadPacked, uv_fs_readdir, dir->dir());
+  } else {  // dir.readPacked(bufferSize, undefined, ctx)
+    CHECK_EQ(argc, 3);
+    FSReqWrapSync req_wrap_sync;
+    FS_DIR_SYNC_TRACE_BEGIN(readdir);
+    int err = SyncCall(env, args[2], &req_wrap_sync, "readdir", uv_fs_readdir,
+                       dir->dir());
+    FS_DIR_SYNC_TRACE_END(readdir);
+    if (err < 0) {
+      return;  // syscall failed, no need to continue, error info is in ctx
+    }
+
+    if (req_wrap_sync.req.result == 0) {
+      // Done
+      args.GetReturnValue().Set(Null(env->isolate()));
+      return;
+    }
+
+    Local<Array> packed;
+    if (DirentListToPacked(env,
+                           dir->dir()->dirents,
+                           static_cast<int>(req_wrap_sync.req.result))
+            .ToLocal(&packed)) {
+      args.GetReturnValue().Set(packed);
+    }
+  }
+}
+
 void AfterOpenDir(uv_fs_t* req) {
   FSReqBase* req_wrap = FSReqBase::from_req(req);
   FSReqAfterScope after(req_wrap, req);
@@ -392,6 +523,453 @@ static void OpenDir(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+#ifdef _WIN32
+static constexpr char kPathSeparator = '\\';
+#else
+static constexpr char kPathSeparator = '/';
+#endif
+
+struct DirWalker::State {
+  State(std::string root,
+        std::vector<std::string> exclude,
+        std::vector<std::string> suffixes)
+      : root(std::move(root)),
+        exclude(std::move(exclude)),
+        suffixes(std::move(suffixes)) {}
+
+  // Names that are neither reported nor walked into.
+  bool IsExcluded(const char* name) const {
+    return std::find(exclude.begin(), exclude.end(), name) != exclude.end();
+  }
+
+  // Whether an entry is reported. Directories are walked into regardless.
+  bool IsReported(const char* name) const {
+    if (suffixes.empty()) return true;
+    const size_t length = strlen(name);
+    for (const std::string& suffix : suffixes) {
+      if (length >= suffix.size() &&
+          memcmp(name + length - suffix.size(), suffix.data(), suffix.size()) ==
+              0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::string FullPath(const std::string& relative) const {
+    if (relative.empty()) return root;
+    if (!root.empty() && (root.back() == '/' || root.back() == kPathSeparator))
+      return root + relative;
+    return root + kPathSeparator + relative;
+  }
+
+  // Set when the walker is created and not modified afterwards.
+  const std::string root;
+  const std::vector<std::string> exclude;
+  const std::vector<std::string> suffixes;
+
+  Mutex mutex;
+  // Directories that are still to be read, relative to the root.
+  std::deque<std::string> directories;
+  // Entries that are waiting to be taken by read().
+  std::deque<Entry> entries;
+  int error = 0;
+  std::string error_path;
+  bool closed = false;
+};
+
+static uv_dirent_type_t DirentTypeFromMode(uint64_t mode) {
+  switch (mode & S_IFMT) {
+    case S_IFREG:
+      return UV_DIRENT_FILE;
+    case S_IFDIR:
+      return UV_DIRENT_DIR;
+#ifndef _WIN32
+    case S_IFLNK:
+      return UV_DIRENT_LINK;
+    case S_IFIFO:
+      return UV_DIRENT_FIFO;
+    case S_IFSOCK:
+      return UV_DIRENT_SOCKET;
+    case S_IFCHR:
+      return UV_DIRENT_CHAR;
+    case S_IFBLK:
+      return UV_DIRENT_BLOCK;
+#endif
+    default:
+      return UV_DIRENT_UNKNOWN;
+  }
+}
+
+// Reads a directory, appending the entries to report to `entries` and the
+// subdirectories to walk into to `directories`.
+class DirectoryReader {
+ public:
+  // Large enough for several hundred entries per getdents64() call.
+  static constexpr size_t kBufferSize = 64 * 1024;
+
+  explicit DirectoryReader(const DirWalker::State& state) : state_(state) {}
+
+  int Read(const std::string& directory,
+           std::vector<DirWalker::Entry>* entries,
+           std::vector<std::string>* directories);
+
+ private:
+  void Visit(const std::string& directory,
+             const char* name,
+             uv_dirent_type_t type,
+             std::vector<DirWalker::Entry>* entries,
+             std::vector<std::string>* directories) {
+    if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) return;
+    if (state_.IsExcluded(name)) return;
+    std::string path =
+        directory.empty() ? name : directory + kPathSeparator + name;
+    if (state_.IsReported(name)) entries->push_back({path, type});
+    if (type == UV_DIRENT_DIR) directories->push_back(std::move(path));
+  }
+
+  const DirWalker::State& state_;
+#ifdef __linux__
+  std::unique_ptr<char[]> buffer_;
+#endif
+};
+
+#ifdef __linux__
+// The record layout of getdents64(2), which glibc only declares since 2.30.
+struct LinuxDirent64 {
+  uint64_t d_ino;
+  int64_t d_off;
+  uint16_t d_reclen;
+  uint8_t d_type;
+  char d_name[1];
+};
+
+static uv_dirent_type_t DirentTypeFromDType(uint8_t type) {
+  switch (type) {
+    case DT_REG:
+      return UV_DIRENT_FILE;
+    case DT_DIR:
+      return UV_DIRENT_DIR;
+    case DT_LNK:
+      return UV_DIRENT_LINK;
+    case DT_FIFO:
+      return UV_DIRENT_FIFO;
+    case DT_SOCK:
+      return UV_DIRENT_SOCKET;
+    case DT_CHR:
+      return UV_DIRENT_CHAR;
+    case DT_BLK:
+      return UV_DIRENT_BLOCK;
+    default:
+      return UV_DIRENT_UNKNOWN;
+  }
+}
+
+int DirectoryReader::Read(const std::string& directory,
+                          std::vector<DirWalker::Entry>* entries,
+                          std::vector<std::string>* directories) {
+  const std::string path = state_.FullPath(directory);
+  int fd;
+  do {
+    fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  } while (fd == -1 && errno == EINTR);
+  if (fd == -1) return uv_translate_sys_error(errno);
+  auto close_fd = OnScopeLeave([fd]() { close(fd); });
+
+  if (!buffer_) buffer_.reset(new char[kBufferSize]);
+  for (;;) {
+    const ssize_t size =
+        syscall(SYS_getdents64, fd, buffer_.get(), kBufferSize);
+    if (size == -1) {
+      if (errno == EINTR) continue;
+      return uv_translate_sys_error(errno);
+    }
+    if (size == 0) return 0;
+
+    for (ssize_t offset = 0; offset < size;) {
+      const LinuxDirent64* record =
+          reinterpret_cast<const LinuxDirent64*>(buffer_.get() + offset);
+      offset += record->d_reclen;
+      uv_dirent_type_t type = DirentTypeFromDType(record->d_type);
+      // Some file systems do not report types, so ask for them.
+      struct stat s;
+      if (type == UV_DIRENT_UNKNOWN &&
+          fstatat(fd, record->d_name, &s, AT_SYMLINK_NOFOLLOW) == 0) {
+        type = DirentTypeFromMode(s.st_mode);
+      }
+      Visit(directory, record->d_name, type, entries, directories);
+    }
+  }
+}
+#else
+int DirectoryReader::Read(const std::string& directory,
+                          std::vector<DirWalker::Entry>* entries,
+                          std::vector<std::string>* directories) {
+  const std::string path = state_.FullPath(directory);
+  uv_fs_t req;
+  int err = uv_fs_scandir(nullptr, &req, path.c_str(), 0, nullptr);
+  auto cleanup = OnScopeLeave([&req]() { uv_fs_req_cleanup(&req); });
+  if (err < 0) return err;
+
+  uv_dirent_t ent;
+  while ((err = uv_fs_scandir_next(&req, &ent)) == 0) {
+    uv_dirent_type_t type = ent.type;
+    if (type == UV_DIRENT_UNKNOWN) {
+      const std::string entry_path = path + kPathSeparator + ent.name;
+      uv_fs_t stat_req;
+      if (uv_fs_lstat(nullptr, &stat_req, entry_path.c_str(), nullptr) == 0)
+        type = DirentTypeFromMode(stat_req.statbuf.st_mode);
+      uv_fs_req_cleanup(&stat_req);
+    }
+    Visit(directory, ent.name, type, entries, directories);
+  }
+  return err == UV_EOF ? 0 : err;
+}
+#endif  // __linux__
+
+class DirWalker::Work final : public ThreadPoolWork {
+ public:
+  explicit Work(DirWalker* walker)
+      : ThreadPoolWork(walker->env()),
+        walker_(walker),
+        state_(walker->state_) {}
+
+  void DoThreadPoolWork() override {
+    DirectoryReader reader(*state_);
+    std::vector<Entry> entries;
+    std::vector<std::string> directories;
+    size_t count = 0;
+    for (;;) {
+      std::string directory;
+      {
+        Mutex::ScopedLock lock(state_->mutex);
+        if (state_->closed) return;
+        count += entries.size();
+        for (Entry& entry : entries)
+          state_->entries.push_back(std::move(entry));
+        for (std::string& path : directories)
+          state_->directories.push_back(std::move(path));
+        entries.clear();
+        directories.clear();
+        if (state_->error != 0 || state_->directories.empty() ||
+            count >= kEntriesPerWork ||
+            state_->entries.size() >= kHighWaterMark) {
+          return;
+        }
+        directory = std::move(state_->directories.front());
+        state_->directories.pop_front();
+      }
+
+      int err = reader.Read(directory, &entries, &directories);
+      if (err == 0) continue;
+      // Subdirectories that are removed or replaced during the walk are not
+      // an error, but failing to read the root or anything else is.
+      if (!directory.empty() && (err == UV_ENOENT || err == UV_ENOTDIR)) {
+        entries.clear();
+        directories.clear();
+        continue;
+      }
+      Mutex::ScopedLock lock(state_->mutex);
+      if (state_->error == 0) {
+        state_->error = err;
+        state_->error_path = state_->FullPath(directory);
+      }
+      return;
+    }
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<Work> self(this);
+    walker_->OnWorkDone();
+  }
+
+ private:
+  BaseObjectPtr<DirWalker> walker_;
+  std::shared_ptr<State> state_;
+};
+
+DirWalker::DirWalker(Environment* env,
+                     Local<Object> obj,
+                     std::shared_ptr<State> state)
+    : AsyncWrap(env, obj, AsyncWrap::PROVIDER_DIRWALKER),
+      state_(std::move(state)) {
+  MakeWeak();
+  state_->directories.emplace_back();
+}
+
+DirWalker::~DirWalker() {
+  Mutex::ScopedLock lock(state_->mutex);
+  state_->closed = true;
+}
+
+void DirWalker::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("state", sizeof(*state_));
+  tracker->TrackField("pending_read", pending_read_);
+}
+
+// new DirWalker(path, exclude, suffixes)
+void DirWalker::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+
+  std::vector<std::string> names[2];
+  for (int i = 0; i < 2; i++) {
+    CHECK(args[i + 1]->IsArray());
+    Local<Array> array = args[i + 1].As<Array>();
+    for (uint32_t j = 0; j < array->Length(); j++) {
+      Local<Value> value;
+      if (!array->Get(env->context(), j).ToLocal(&value)) return;
+      Utf8Value name(isolate, value);
+      names[i].emplace_back(*name, name.length());
+    }
+  }
+
+  auto state = std::make_shared<State>(std::string(*path, path.length()),
+                                       std::move(names[0]),
+                                       std::move(names[1]));
+  new DirWalker(env, args.This(), std::move(state));
+}
+
+void DirWalker::ScheduleWork() {
+  while (active_work_ < kMaxConcurrentWork) {
+    {
+      Mutex::ScopedLock lock(state_->mutex);
+      // Only start another work item if there is a directory for it that
+      // the running ones are not going to pick up first.
+      if (state_->closed || state_->error != 0 ||
+          state_->entries.size() >= kHighWaterMark ||
+          state_->directories.size() <= active_work_) {
+        return;
+      }
+    }
+    active_work_++;
+    (new Work(this))->ScheduleWork();
+  }
+}
+
+void DirWalker::OnWorkDone() {
+  active_work_--;
+  ScheduleWork();
+  MaybeFinishRead();
+}
+
+void DirWalker::MaybeFinishRead() {
+  if (!pending_read_ || !env()->can_call_into_js()) return;
+
+  std::vector<Entry> entries;
+  int error;
+  std::string error_path;
+  bool done;
+  {
+    Mutex::ScopedLock lock(state_->mutex);
+    error = state_->error;
+    error_path = state_->error_path;
+    const size_t count = std::min(state_->entries.size(), kEntriesPerWork);
+    entries.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      entries.push_back(std::move(state_->entries.front()));
+      state_->entries.pop_front();
+    }
+    done = state_->closed ||
+           (state_->entries.empty() && state_->directories.empty() &&
+            active_work_ == 0);
+  }
+  if (error == 0 && entries.empty() && !done) return;
+
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env()->context());
+
+  // Like FSReqAfterScope, let the request be deleted once it is done.
+  BaseObjectPtr<FSReqBase> req_wrap = std::move(pending_read_);
+  req_wrap->Detach();
+
+  if (error != 0) {
+    req_wrap->Reject(
+        UVException(isolate, error, "scandir", nullptr, error_path.c_str()));
+    return;
+  }
+
+  if (entries.empty()) {
+    req_wrap->Resolve(Null(isolate));
+    return;
+  }
+
+  MaybeStackBuffer<Local<Value>, 64> values(entries.size() * 2);
+  size_t j = 0;
+  for (const Entry& entry : entries) {
+    Local<Value> error;
+    if (!StringBytes::Encode(isolate,
+                             entry.path.data(),
+                             entry.path.size(),
+                             pending_encoding_,
+                             &error)
+             .ToLocal(&values[j++])) {
+      req_wrap->Reject(error);
+      return;
+    }
+    values[j++] = Integer::New(isolate, entry.type);
+  }
+  req_wrap->Resolve(Array::New(isolate, values.out(), j));
+
+  // Taking entries may have brought the buffer below the high water mark.
+  ScheduleWork();
+}
+
+// walker.read(encoding, req) resolves with an array of alternating paths,
+// relative to the root, and dirent types, or with null once the walk ends.
+void DirWalker::Read(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  DirWalker* walker;
+  ASSIGN_OR_RETURN_UNWRAP(&walker, args.Holder());
+  CHECK(!walker->pending_read_);
+
+  walker->pending_encoding_ = ParseEncoding(env->isolate(), args[0], UTF8);
+  FSReqBase* req_wrap_async = GetReqWrap(args, 1);
+  CHECK_NOT_NULL(req_wrap_async);
+  req_wrap_async->Init("scandir", nullptr, 0, walker->pending_encoding_);
+  walker->pending_read_.reset(req_wrap_async);
+
+  walker->ScheduleWork();
+  // Entries may already be buffered, but the read is always settled
+  // asynchronously.
+  env->SetImmediate([walker = BaseObjectPtr<DirWalker>(walker)](Environment*) {
+    walker->MaybeFinishRead();
+  });
+  req_wrap_async->SetReturnValue(args);
+}
+
+// walker.close() stops the walk. A pending read resolves with null.
+void DirWalker::Close(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  DirWalker* walker;
+  ASSIGN_OR_RETURN_UNWRAP(&walker, args.Holder());
+  {
+    Mutex::ScopedLock lock(walker->state_->mutex);
+    walker->state_->closed = true;
+    walker->state_->directories.clear();
+    walker->state_->entries.clear();
+  }
+  if (walker->pending_read_) {
+    env->SetImmediate(
+        [walker = BaseObjectPtr<DirWalker>(walker)](Environment*) {
+          walker->MaybeFinishRead();
+        });
+  }
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -405,18 +983,32 @@ void Initialize(Local<Object> target,
   Local<FunctionTemplate> dir = NewFunctionTemplate(isolate, DirHandle::New);
   dir->Inherit(AsyncWrap::GetConstructorTemplate(env));
   SetProtoMethod(isolate, dir, "read", DirHandle::Read);
+  SetProtoMethod(isolate, dir, "readPacked", DirHandle::ReadPacked);
   SetProtoMethod(isolate, dir, "close", DirHandle::Close);
   Local<ObjectTemplate> dirt = dir->InstanceTemplate();
   dirt->SetInternalFieldCount(DirHandle::kInternalFieldCount);
   SetConstructorFunction(context, target, "DirHandle", dir);
   env->set_dir_instance_template(dirt);
+
+  Local<FunctionTemplate> walker =
+      NewFunctionTemplate(isolate, DirWalker::New);
+  walker->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  SetProtoMethod(isolate, walker, "read", DirWalker::Read);
+  SetProtoMethod(isolate, walker, "close", DirWalker::Close);
+  walker->InstanceTemplate()->SetInternalFieldCount(
+      DirWalker::kInternalFieldCount);
+  SetConstructorFunction(context, target, "DirWalker", walker);
 }
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(OpenDir);
   registry->Register(DirHandle::New);
   registry->Register(DirHandle::Read);
+  registry->Register(DirHandle::ReadPacked);
   registry->Register(DirHandle::Close);
+  registry->Register(DirWalker::New);
+  registry->Register(DirWalker::Read);
+  registry->Register(DirWalker::Close);
 }
 
 }  // namespace fs_dir
@@ -5,6 +5,10 @@
 
 #include "node_file.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace node {
 
 namespace fs_dir {
@@ -17,6 +21,7 @@ class DirHandle : public AsyncWrap {
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Read(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void ReadPacked(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Close(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   inline uv_dir_t* dir() { return dir_; }
@@ -35,6 +40,8 @@ class DirHandle : public AsyncWrap {
 
   // Synchronous close that emits a warning
   void GCClose();
+  // Sets the number of entries that a single libuv call reads.
+  void SetBufferSize(size_t buffer_size);
 
   uv_dir_t* dir_;
   // Multiple entries are read through a single libuv call.
@@ -43,6 +50,57 @@ class DirHandle : public AsyncWrap {
   bool closed_ = false;
 };
 
+// Walks a directory tree breadth-first. Directories are read by up to
+// kMaxConcurrentWork thread pool work items at a time, and their entries are
+// buffered until they are taken by read().
+class DirWalker : public AsyncWrap {
+ public:
+  static constexpr size_t kMaxConcurrentWork = 4;
+  // Number of entries after which a work item returns to the main thread so
+  // that they can be delivered.
+  static constexpr size_t kEntriesPerWork = 4096;
+  // Directories are not read while this many entries are waiting for JS.
+  static constexpr size_t kHighWaterMark = 64 * 1024;
+
+  struct Entry {
+    std::string path;
+    uv_dirent_type_t type;
+  };
+  struct State;
+
+  ~DirWalker() override;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Read(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Close(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(DirWalker)
+  SET_SELF_SIZE(DirWalker)
+
+  DirWalker(const DirWalker&) = delete;
+  DirWalker& operator=(const DirWalker&) = delete;
+  DirWalker(const DirWalker&&) = delete;
+  DirWalker& operator=(const DirWalker&&) = delete;
+
+ private:
+  class Work;
+
+  DirWalker(Environment* env,
+            v8::Local<v8::Object> obj,
+            std::shared_ptr<State> state);
+
+  void ScheduleWork();
+  void OnWorkDone();
+  // Settles the pending read() if there are entries or the walk has ended.
+  void MaybeFinishRead();
+
+  std::shared_ptr<State> state_;
+  BaseObjectPtr<fs::FSReqBase> pending_read_;
+  enum encoding pending_encoding_ = UTF8;
+  size_t active_work_ = 0;
+};
+
 }  // namespace fs_dir
 
 }  // namespace node
@@ -24,8 +24,10 @@
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
 #include "node_external_reference.h"
+#include "node_package_json.h"
 #include "node_process-inl.h"
 #include "node_stat_watcher.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
 #include "tracing/trace_event.h"
@@ -43,6 +45,9 @@
 
 #if defined(__MINGW32__) || defined(_MSC_VER)
 # include <io.h>
+#else
+# include <sys/mman.h>
+# include <unistd.h>
 #endif
 
 #include <memory>
@@ -52,6 +57,8 @@ namespace node {
 namespace fs {
 
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::BigInt;
 using v8::Boolean;
 using v8::Context;
@@ -61,6 +68,7 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Int32;
+using v8::Int32Array;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -71,6 +79,7 @@ using v8::ObjectTemplate;
 using v8::Promise;
 using v8::String;
 using v8::Symbol;
+using v8::Uint32;
 using v8::Undefined;
 using v8::Value;
 
@@ -517,10 +526,26 @@ FileHandleReadWrap::FileHandleReadWrap(FileHandle* handle, Local<Object> obj)
   : ReqWrap(handle->env(), obj, AsyncWrap::PROVIDER_FSREQCALLBACK),
     file_handle_(handle) {}
 
+// Tells the kernel that a range of the file is going to be read sequentially,
+// so that it reads further ahead. A length of 0 extends to the end of the
+// file. This is only a hint, and a no-op where posix_fadvise() is missing.
+static void SetSequentialAdvice(uv_file fd, int64_t offset, int64_t length) {
+#ifdef POSIX_FADV_SEQUENTIAL
+  USE(posix_fadvise(fd, offset, length, POSIX_FADV_SEQUENTIAL));
+#endif
+}
+
 int FileHandle::ReadStart() {
   if (!IsAlive() || IsClosing())
     return UV_EOF;
 
+  if (!advised_) {
+    advised_ = true;
+    SetSequentialAdvice(fd_,
+                        std::max<int64_t>(read_offset_, 0),
+                        std::max<int64_t>(read_length_, 0));
+  }
+
   reading_ = true;
 
   if (current_read_)
@@ -971,98 +996,48 @@ void Close(const FunctionCallbackInfo<Value>& args) {
 }
 
 
-// Used to speed up module loading. Returns an array [string, boolean]
-static void InternalModuleReadJSON(const FunctionCallbackInfo<Value>& args) {
+// Used to speed up module loading. Returns undefined if the file cannot be
+// read, or an array [flags, name, main, type, exports, imports, source]. See
+// package_json::PackageJson for the meaning of the entries.
+static void InternalModuleReadPackageJSON(
+    const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
-  uv_loop_t* loop = env->event_loop();
 
   CHECK(args[0]->IsString());
   node::Utf8Value path(isolate, args[0]);
+  const bool include_source = args[1]->IsTrue();
 
   if (strlen(*path) != path.length()) {
-    args.GetReturnValue().Set(Array::New(isolate));
     return;  // Contains a nul byte.
   }
-  uv_fs_t open_req;
-  const int fd = uv_fs_open(loop, &open_req, *path, O_RDONLY, 0, nullptr);
-  uv_fs_req_cleanup(&open_req);
-
-  if (fd < 0) {
-    args.GetReturnValue().Set(Array::New(isolate));
-    return;
-  }
-
-  auto defer_close = OnScopeLeave([fd, loop]() {
-    uv_fs_t close_req;
-    CHECK_EQ(0, uv_fs_close(loop, &close_req, fd, nullptr));
-    uv_fs_req_cleanup(&close_req);
-  });
-
-  const size_t kBlockSize = 32 << 10;
-  std::vector<char> chars;
-  int64_t offset = 0;
-  ssize_t numchars;
-  do {
-    const size_t start = chars.size();
-    chars.resize(start + kBlockSize);
-
-    uv_buf_t buf;
-    buf.base = &chars[start];
-    buf.len = kBlockSize;
-
-    uv_fs_t read_req;
-    numchars = uv_fs_read(loop, &read_req, fd, &buf, 1, offset, nullptr);
-    uv_fs_req_cleanup(&read_req);
-
-    if (numchars < 0) {
-      args.GetReturnValue().Set(Array::New(isolate));
-      return;
-    }
-    offset += numchars;
-  } while (static_cast<size_t>(numchars) == kBlockSize);
-
-  size_t start = 0;
-  if (offset >= 3 && 0 == memcmp(&chars[0], "\xEF\xBB\xBF", 3)) {
-    start = 3;  // Skip UTF-8 BOM.
-  }
-
-  const size_t size = offset - start;
-  char* p = &chars[start];
-  char* pe = &chars[size];
-  char* pos[2];
-  char** ppos = &pos[0];
-
-  while (p < pe) {
-    char c = *p++;
-    if (c == '\\' && p < pe && *p == '"') p++;
-    if (c != '"') continue;
-    *ppos++ = p;
-    if (ppos < &pos[2]) continue;
-    ppos = &pos[0];
-
-    char* s = &pos[0][0];
-    char* se = &pos[1][-1];  // Exclude quote.
-    size_t n = se - s;
-
-    if (n == 4) {
-      if (0 == memcmp(s, "main", 4)) break;
-      if (0 == memcmp(s, "name", 4)) break;
-      if (0 == memcmp(s, "type", 4)) break;
-    } else if (n == 7) {
-      if (0 == memcmp(s, "exports", 7)) break;
-      if (0 == memcmp(s, "imports", 7)) break;
-    }
-  }
 
+  std::shared_ptr<const package_json::PackageJson> pkg =
+      package_json::Read(env, path.ToString(), include_source);
+  if (!pkg) return;
 
+  Local<Context> context = env->context();
+  auto field = [&](const std::optional<std::string>& value) -> Local<Value> {
+    if (!value.has_value()) return Undefined(isolate);
+    Local<Value> result;
+    if (!ToV8Value(context, value.value()).ToLocal(&result)) return {};
+    return result;
+  };
   Local<Value> return_value[] = {
-    String::NewFromUtf8(isolate,
-                        &chars[start],
-                        v8::NewStringType::kNormal,
-                        size).ToLocalChecked(),
-    Boolean::New(isolate, p < pe ? true : false)
+    Integer::NewFromUnsigned(isolate, pkg->flags),
+    field(pkg->name),
+    field(pkg->main),
+    field(pkg->type),
+    field(pkg->exports),
+    field(pkg->imports),
+    field(pkg->source.empty() &&
+                  !(pkg->flags & package_json::PackageJson::kNeedsParse)
+              ? std::nullopt
+              : std::make_optional(pkg->source)),
   };
+  for (const Local<Value>& value : return_value) {
+    if (value.IsEmpty()) return;
+  }
   args.GetReturnValue().Set(
     Array::New(isolate, return_value, arraysize(return_value)));
 }
@@ -1186,6 +1161,137 @@ static void FStat(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// State shared by the thread pool work items of a single statMany() call.
+// Each item stats a contiguous batch of paths, so that large calls are
+// spread over the pool without a request per path.
+struct StatManyState {
+  StatManyState(FSReqBase* req_wrap, std::vector<std::string>&& paths)
+      : req_wrap(req_wrap),
+        paths(std::move(paths)),
+        stats(this->paths.size()),
+        errors(this->paths.size()) {}
+
+  BaseObjectPtr<FSReqBase> req_wrap;
+  std::vector<std::string> paths;
+  std::vector<uv_stat_t> stats;
+  std::vector<int> errors;
+  // Only accessed on the main thread.
+  size_t pending = 0;
+};
+
+class StatManyWork final : public ThreadPoolWork {
+ public:
+  static constexpr size_t kBatchSize = 64;
+
+  StatManyWork(std::shared_ptr<StatManyState> state, size_t begin, size_t end)
+      : ThreadPoolWork(state->req_wrap->env()),
+        state_(std::move(state)),
+        begin_(begin),
+        end_(end) {}
+
+  void DoThreadPoolWork() override {
+    for (size_t i = begin_; i < end_; i++) {
+      uv_fs_t req;
+      int err =
+          uv_fs_stat(nullptr, &req, state_->paths[i].c_str(), nullptr);
+      if (err == 0) state_->stats[i] = req.statbuf;
+      state_->errors[i] = err;
+      uv_fs_req_cleanup(&req);
+    }
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<StatManyWork> self(this);
+    if (--state_->pending > 0) return;
+
+    // Like FSReqAfterScope, let the request be deleted once it is done.
+    BaseObjectPtr<FSReqBase> req_wrap = std::move(state_->req_wrap);
+    req_wrap->Detach();
+    Environment* env = req_wrap->env();
+    if (status == UV_ECANCELED || !env->can_call_into_js()) return;
+    CHECK_EQ(status, 0);
+
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    const size_t count = state_->paths.size();
+    Local<Value> stats;
+    if (req_wrap->use_bigint()) {
+      stats = FillStatsArrays<AliasedBigInt64Array>(isolate, count);
+    } else {
+      stats = FillStatsArrays<AliasedFloat64Array>(isolate, count);
+    }
+
+    Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, count * sizeof(int32_t));
+    if (count > 0) {
+      memcpy(ab->Data(), state_->errors.data(), count * sizeof(int32_t));
+    }
+    Local<Value> result[] = {stats, Int32Array::New(ab, 0, count)};
+    req_wrap->Resolve(Array::New(isolate, result, arraysize(result)));
+  }
+
+ private:
+  template <typename AliasedBufferT>
+  Local<Value> FillStatsArrays(Isolate* isolate, size_t count) {
+    constexpr size_t kFieldsNumber =
+        static_cast<size_t>(FsStatsOffset::kFsStatsFieldsNumber);
+    AliasedBufferT fields(isolate, count * kFieldsNumber);
+    for (size_t i = 0; i < count; i++) {
+      if (state_->errors[i] == 0)
+        FillStatsArray(&fields, &state_->stats[i], i * kFieldsNumber);
+    }
+    return fields.GetJSArray();
+  }
+
+  std::shared_ptr<StatManyState> state_;
+  size_t begin_;
+  size_t end_;
+};
+
+// statMany(paths, use_bigint, req) resolves with [stats, errors], where stats
+// holds kFsStatsFieldsNumber fields for each path in the same layout as
+// statValues and errors holds 0 or the error code of each stat() call.
+static void StatMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  CHECK(args[0]->IsArray());
+  Local<Array> array = args[0].As<Array>();
+  std::vector<std::string> paths;
+  paths.reserve(array->Length());
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> value;
+    if (!array->Get(env->context(), i).ToLocal(&value)) return;
+    BufferValue path(isolate, value);
+    CHECK_NOT_NULL(*path);
+    paths.emplace_back(*path, path.length());
+  }
+
+  bool use_bigint = args[1]->IsTrue();
+  FSReqBase* req_wrap_async = GetReqWrap(args, 2, use_bigint);
+  CHECK_NOT_NULL(req_wrap_async);
+  req_wrap_async->Init("stat", nullptr, 0, UTF8);
+
+  const size_t count = paths.size();
+  auto state = std::make_shared<StatManyState>(req_wrap_async,
+                                               std::move(paths));
+  // Even an empty batch goes through the thread pool so that the callback is
+  // always called asynchronously.
+  const size_t batches = std::max<size_t>(
+      1, (count + StatManyWork::kBatchSize - 1) / StatManyWork::kBatchSize);
+  state->pending = batches;
+  for (size_t i = 0; i < batches; i++) {
+    const size_t begin = i * StatManyWork::kBatchSize;
+    const size_t end = std::min(count, begin + StatManyWork::kBatchSize);
+    (new StatManyWork(state, begin, end))->ScheduleWork();
+  }
+  req_wrap_async->SetReturnValue(args);
+}
+
 static void Symlink(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -1859,6 +1965,192 @@ static void Open(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Reads a whole file in a single thread pool task: open, fstat, read until
+// the end of the file and close, instead of one round trip per step. The
+// buffer is sized with fstat() for regular files and grown otherwise.
+class ReadFileWork final : public ThreadPoolWork {
+ public:
+  // Mirrors kReadFileUnknownBufferLength and kIoMaxLength in
+  // lib/internal/fs/utils.js.
+  static constexpr size_t kUnknownSizeChunk = 64 * 1024;
+  static constexpr int64_t kMaxSize = 0x7FFFFFFF;
+
+  ReadFileWork(FSReqBase* req_wrap,
+               std::string path,
+               uv_file fd,
+               int flags,
+               bool utf8)
+      : ThreadPoolWork(req_wrap->env()),
+        req_wrap_(req_wrap),
+        path_(std::move(path)),
+        fd_(fd),
+        flags_(flags),
+        utf8_(utf8) {}
+
+  ~ReadFileWork() override { free(data_); }
+
+  void DoThreadPoolWork() override {
+    uv_fs_t req;
+    uv_file fd = fd_;
+    if (fd < 0) {
+      int result = uv_fs_open(nullptr, &req, path_.c_str(), flags_, 0666,
+                              nullptr);
+      uv_fs_req_cleanup(&req);
+      if (result < 0) return SetError(result, "open");
+      fd = result;
+    }
+    auto close_fd = OnScopeLeave([&]() {
+      if (fd_ >= 0) return;
+      uv_fs_close(nullptr, &req, fd, nullptr);
+      uv_fs_req_cleanup(&req);
+    });
+
+    int result = uv_fs_fstat(nullptr, &req, fd, nullptr);
+    const uv_stat_t stat = req.statbuf;
+    uv_fs_req_cleanup(&req);
+    if (result < 0) return SetError(result, "fstat");
+
+    // Like the JS implementation, treat all files that are not regular files
+    // as being of unknown size and read until there is nothing left.
+    int64_t size = 0;
+    if ((stat.st_mode & S_IFMT) == S_IFREG)
+      size = static_cast<int64_t>(stat.st_size);
+    if (size > kMaxSize) {
+      too_large_size_ = size;
+      return;
+    }
+
+    size_t capacity = size > 0 ? static_cast<size_t>(size) : kUnknownSizeChunk;
+    data_ = UncheckedMalloc(capacity);
+    if (data_ == nullptr) return SetError(UV_ENOMEM, "read");
+
+    for (;;) {
+      if (length_ == capacity) {
+        if (size > 0) break;
+        if (capacity >= static_cast<size_t>(kMaxSize)) {
+          too_large_size_ = capacity;
+          return;
+        }
+        capacity = std::min<size_t>(capacity * 2, kMaxSize);
+        char* data = UncheckedRealloc(data_, capacity);
+        if (data == nullptr) return SetError(UV_ENOMEM, "read");
+        data_ = data;
+      }
+      uv_buf_t buf = uv_buf_init(data_ + length_, capacity - length_);
+      result = uv_fs_read(nullptr, &req, fd, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (result < 0) return SetError(result, "read");
+      if (result == 0) break;
+      length_ += result;
+    }
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReadFileWork> self(this);
+    // Like FSReqAfterScope, let the request be deleted once it is done.
+    req_wrap_->Detach();
+    Environment* env = req_wrap_->env();
+    if (status == UV_ECANCELED || !env->can_call_into_js()) return;
+    CHECK_EQ(status, 0);
+
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    if (error_ < 0) {
+      const bool has_path = strcmp(syscall_, "open") == 0;
+      req_wrap_->Reject(UVException(isolate,
+                                    error_,
+                                    syscall_,
+                                    nullptr,
+                                    has_path ? path_.c_str() : nullptr));
+      return;
+    }
+
+    // Let the caller throw ERR_FS_FILE_TOO_LARGE.
+    if (too_large_size_ > 0) {
+      req_wrap_->Resolve(
+          Number::New(isolate, static_cast<double>(too_large_size_)));
+      return;
+    }
+
+    if (utf8_) {
+      Local<Value> error;
+      MaybeLocal<Value> string =
+          StringBytes::Encode(isolate, data_, length_, UTF8, &error);
+      Local<Value> value;
+      if (!string.ToLocal(&value)) {
+        CHECK(!error.IsEmpty());
+        req_wrap_->Reject(error);
+        return;
+      }
+      req_wrap_->Resolve(value);
+      return;
+    }
+
+    std::shared_ptr<BackingStore> store = ArrayBuffer::NewBackingStore(
+        data_, length_, [](void* data, size_t, void*) { free(data); },
+        nullptr);
+    data_ = nullptr;
+    Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(store));
+    Local<Object> buffer;
+    if (!Buffer::New(env, ab, 0, length_).ToLocal(&buffer)) return;
+    req_wrap_->Resolve(buffer);
+  }
+
+ private:
+  void SetError(int error, const char* syscall) {
+    error_ = error;
+    syscall_ = syscall;
+  }
+
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  std::string path_;
+  uv_file fd_;
+  int flags_;
+  bool utf8_;
+
+  char* data_ = nullptr;
+  size_t length_ = 0;
+  int64_t too_large_size_ = 0;
+  int error_ = 0;
+  const char* syscall_ = nullptr;
+};
+
+// readFileUtf8(path | fd, flags, req) and readFileBuffer(path | fd, flags, req)
+// resolve with the contents of the file as a string or Buffer, or with its
+// size if it is too large to be read into a Buffer.
+template <bool utf8>
+static void ReadFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  std::string path;
+  uv_file fd = -1;
+  if (args[0]->IsInt32()) {
+    fd = args[0].As<Int32>()->Value();
+    CHECK_GE(fd, 0);
+  } else {
+    BufferValue value(env->isolate(), args[0]);
+    CHECK_NOT_NULL(*value);
+    path = std::string(*value, value.length());
+  }
+
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 2);
+  CHECK_NOT_NULL(req_wrap_async);
+  req_wrap_async->Init("read", nullptr, 0, UTF8);
+
+  ReadFileWork* work =
+      new ReadFileWork(req_wrap_async, std::move(path), fd, flags, utf8);
+  work->ScheduleWork();
+  req_wrap_async->SetReturnValue(args);
+}
+
 static void OpenFileHandle(const FunctionCallbackInfo<Value>& args) {
   BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
   Environment* env = binding_data->env();
@@ -1936,6 +2228,552 @@ static void CopyFile(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Copies a file for fs.cp() and applies the mode, and optionally the
+// timestamps, of the source to the copy, so that each file only takes one
+// thread pool request. On failure, `syscall` is set to the failing call.
+static int CopyFileWithMetadata(const char* src,
+                                const char* dest,
+                                int mode,
+                                bool preserve_timestamps,
+                                const char** syscall) {
+  uv_fs_t req;
+  // Try a reflink first. Otherwise libuv copies the data in the kernel with
+  // copy_file_range() or sendfile() where those are available.
+  int err = uv_fs_copyfile(
+      nullptr, &req, src, dest, UV_FS_COPYFILE_FICLONE, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err < 0) {
+    *syscall = "copyfile";
+    return err;
+  }
+
+  if (preserve_timestamps) {
+    // Setting the timestamps of a read-only file fails on Windows.
+    if ((mode & 0200) == 0) {
+      err = uv_fs_chmod(nullptr, &req, dest, mode | 0200, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (err < 0) {
+        *syscall = "chmod";
+        return err;
+      }
+    }
+    // Reading the source may have updated its atime, so stat it again.
+    err = uv_fs_stat(nullptr, &req, src, nullptr);
+    const uv_stat_t s = req.statbuf;
+    uv_fs_req_cleanup(&req);
+    if (err < 0) {
+      *syscall = "stat";
+      return err;
+    }
+    err = uv_fs_utime(nullptr, &req, dest,
+                      s.st_atim.tv_sec + s.st_atim.tv_nsec / 1e9,
+                      s.st_mtim.tv_sec + s.st_mtim.tv_nsec / 1e9,
+                      nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err < 0) {
+      *syscall = "utime";
+      return err;
+    }
+  }
+
+  err = uv_fs_chmod(nullptr, &req, dest, mode, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err < 0) *syscall = "chmod";
+  return err;
+}
+
+class CopyFileWork final : public ThreadPoolWork {
+ public:
+  CopyFileWork(FSReqBase* req_wrap,
+               std::string src,
+               std::string dest,
+               int mode,
+               bool preserve_timestamps)
+      : ThreadPoolWork(req_wrap->env()),
+        req_wrap_(req_wrap),
+        src_(std::move(src)),
+        dest_(std::move(dest)),
+        mode_(mode),
+        preserve_timestamps_(preserve_timestamps) {}
+
+  void DoThreadPoolWork() override {
+    error_ = CopyFileWithMetadata(
+        src_.c_str(), dest_.c_str(), mode_, preserve_timestamps_, &syscall_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<CopyFileWork> self(this);
+    // Like FSReqAfterScope, let the request be deleted once it is done.
+    req_wrap_->Detach();
+    Environment* env = req_wrap_->env();
+    if (status == UV_ECANCELED || !env->can_call_into_js()) return;
+    CHECK_EQ(status, 0);
+
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    if (error_ == 0) {
+      req_wrap_->Resolve(Undefined(isolate));
+    } else if (strcmp(syscall_, "copyfile") == 0) {
+      req_wrap_->Reject(UVException(
+          isolate, error_, syscall_, nullptr, src_.c_str(), dest_.c_str()));
+    } else {
+      req_wrap_->Reject(
+          UVException(isolate, error_, syscall_, nullptr, dest_.c_str()));
+    }
+  }
+
+ private:
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  std::string src_;
+  std::string dest_;
+  int mode_;
+  bool preserve_timestamps_;
+
+  int error_ = 0;
+  const char* syscall_ = nullptr;
+};
+
+static void CpFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 5);
+
+  BufferValue src(isolate, args[0]);
+  CHECK_NOT_NULL(*src);
+
+  BufferValue dest(isolate, args[1]);
+  CHECK_NOT_NULL(*dest);
+
+  CHECK(args[2]->IsInt32());
+  const int mode = args[2].As<Int32>()->Value();
+
+  const bool preserve_timestamps = args[3]->IsTrue();
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 4);
+  if (req_wrap_async != nullptr) {
+    // cpFile(src, dest, mode, preserveTimestamps, req)
+    req_wrap_async->Init("copyfile", nullptr, 0, UTF8);
+    CopyFileWork* work =
+        new CopyFileWork(req_wrap_async,
+                         std::string(*src, src.length()),
+                         std::string(*dest, dest.length()),
+                         mode,
+                         preserve_timestamps);
+    work->ScheduleWork();
+    req_wrap_async->SetReturnValue(args);
+  } else {  // cpFile(src, dest, mode, preserveTimestamps, undefined, ctx)
+    CHECK_EQ(argc, 6);
+    env->PrintSyncTrace();
+    const char* syscall = nullptr;
+    FS_SYNC_TRACE_BEGIN(copyfile);
+    int err =
+        CopyFileWithMetadata(*src, *dest, mode, preserve_timestamps, &syscall);
+    FS_SYNC_TRACE_END(copyfile);
+    if (err == 0) return;
+
+    Local<Context> context = env->context();
+    Local<Object> ctx_obj = args[5].As<Object>();
+    ctx_obj->Set(context, env->errno_string(), Integer::New(isolate, err))
+        .Check();
+    ctx_obj->Set(context, env->syscall_string(),
+                 OneByteString(isolate, syscall)).Check();
+    // Only copying involves both paths.
+    if (strcmp(syscall, "copyfile") != 0) {
+      ctx_obj->Set(context, env->path_string(), args[1]).Check();
+      ctx_obj->Set(context, env->dest_string(), Undefined(isolate)).Check();
+    }
+  }
+}
+
+
+// Mirrors kMmapAdvice in lib/internal/fs/mmap.js.
+enum class MmapAdvice { kNormal, kSequential, kRandom, kWillNeed };
+
+struct MappedRegion {
+  void* base;
+  size_t length;
+};
+
+static void UnmapRegion(void* data, size_t length, void* deleter_data) {
+  MappedRegion* region = static_cast<MappedRegion*>(deleter_data);
+#ifdef _WIN32
+  UnmapViewOfFile(region->base);
+#else
+  munmap(region->base, region->length);
+#endif
+  delete region;
+}
+
+// mmap(fd, offset, length, writable, shared, advice, ctx) returns a Buffer
+// backed by a mapping of the given range of the file, which is unmapped
+// when the Buffer is garbage collected. Read-only requests are mapped
+// copy-on-write, since JS can write to any Buffer and a write to a page
+// without write access would crash the process; such writes never reach the
+// file.
+static void MMap(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_EQ(argc, 7);
+
+  CHECK(args[0]->IsInt32());
+  const int fd = args[0].As<Int32>()->Value();
+
+  CHECK(IsSafeJsInt(args[1]));
+  const int64_t offset = args[1].As<Integer>()->Value();
+  CHECK_GE(offset, 0);
+
+  CHECK(args[2]->IsNumber());
+  const size_t length = static_cast<size_t>(args[2].As<Number>()->Value());
+  CHECK_GT(length, 0);
+
+  const bool writable = args[3]->IsTrue();
+  const bool shared = args[4]->IsTrue();
+
+  CHECK(args[5]->IsInt32());
+  const MmapAdvice advice =
+      static_cast<MmapAdvice>(args[5].As<Int32>()->Value());
+
+  // Mappings start at a multiple of the page size, or of the allocation
+  // granularity on Windows.
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const int64_t granularity = info.dwAllocationGranularity;
+#else
+  const int64_t granularity = sysconf(_SC_PAGESIZE);
+#endif
+  const int64_t aligned_offset = offset - offset % granularity;
+  const size_t delta = static_cast<size_t>(offset - aligned_offset);
+  const size_t map_length = length + delta;
+
+  void* base = nullptr;
+  int err = 0;
+#ifdef _WIN32
+  HANDLE file = reinterpret_cast<HANDLE>(uv_get_osfhandle(fd));
+  DWORD protect = PAGE_WRITECOPY;
+  DWORD access = FILE_MAP_COPY;
+  if (writable && shared) {
+    protect = PAGE_READWRITE;
+    access = FILE_MAP_WRITE;
+  }
+  HANDLE mapping = CreateFileMappingW(file, nullptr, protect, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    err = uv_translate_sys_error(GetLastError());
+  } else {
+    base = MapViewOfFile(mapping,
+                         access,
+                         static_cast<DWORD>(aligned_offset >> 32),
+                         static_cast<DWORD>(aligned_offset & 0xFFFFFFFF),
+                         map_length);
+    if (base == nullptr) err = uv_translate_sys_error(GetLastError());
+    // The view keeps the mapping alive.
+    CloseHandle(mapping);
+  }
+  // Windows has no equivalent of madvise() for file mappings.
+  USE(advice);
+#else
+  base = mmap(nullptr,
+              map_length,
+              PROT_READ | PROT_WRITE,
+              writable && shared ? MAP_SHARED : MAP_PRIVATE,
+              fd,
+              aligned_offset);
+  if (base == MAP_FAILED) {
+    base = nullptr;
+    err = uv_translate_sys_error(errno);
+  } else if (advice != MmapAdvice::kNormal) {
+    int hint = POSIX_MADV_NORMAL;
+    switch (advice) {
+      case MmapAdvice::kSequential:
+        hint = POSIX_MADV_SEQUENTIAL;
+        break;
+      case MmapAdvice::kRandom:
+        hint = POSIX_MADV_RANDOM;
+        break;
+      case MmapAdvice::kWillNeed:
+        hint = POSIX_MADV_WILLNEED;
+        break;
+      default:
+        UNREACHABLE();
+    }
+    // The advice is only a hint, so failing to apply it is not an error.
+    USE(posix_madvise(base, map_length, hint));
+  }
+#endif
+
+  if (err != 0) {
+    Local<Context> context = env->context();
+    Local<Object> ctx_obj = args[6].As<Object>();
+    ctx_obj->Set(context, env->errno_string(), Integer::New(isolate, err))
+        .Check();
+    ctx_obj->Set(context, env->syscall_string(),
+                 FIXED_ONE_BYTE_STRING(isolate, "mmap")).Check();
+    return;
+  }
+
+  std::shared_ptr<BackingStore> store =
+      ArrayBuffer::NewBackingStore(static_cast<char*>(base) + delta,
+                                   length,
+                                   UnmapRegion,
+                                   new MappedRegion{base, map_length});
+  Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(store));
+  Local<Object> buffer;
+  if (!Buffer::New(env, ab, 0, length).ToLocal(&buffer)) return;
+  args.GetReturnValue().Set(buffer);
+}
+
+
+class FileSink::FlushWork final : public ThreadPoolWork {
+ public:
+  FlushWork(FileSink* sink,
+            FSReqBase* req_wrap,
+            size_t length,
+            int64_t position)
+      : ThreadPoolWork(sink->env()),
+        sink_(sink),
+        req_wrap_(req_wrap),
+        offset_(sink->head_),
+        length_(length),
+        position_(position) {}
+
+  void DoThreadPoolWork() override {
+    size_t written;
+    const int err = sink_->WriteRegion(offset_, length_, position_, &written);
+    Mutex::ScopedLock lock(sink_->mutex_);
+    error_ = err;
+    written_ = written;
+    done_ = true;
+    sink_->flush_done_.Broadcast(lock);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<FlushWork> self(this);
+    // Like FSReqAfterScope, let the request be deleted once it is done.
+    req_wrap_->Detach();
+    // FlushSync() may already have accounted for this flush.
+    if (sink_->flush_work_ == this)
+      sink_->FinishFlush(status == 0 ? written_ : 0);
+
+    Environment* env = req_wrap_->env();
+    if (status == UV_ECANCELED || !env->can_call_into_js()) return;
+    CHECK_EQ(status, 0);
+
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    if (error_ == 0) {
+      req_wrap_->Resolve(Number::New(isolate, static_cast<double>(length_)));
+    } else {
+      req_wrap_->Reject(UVException(isolate, error_, "write"));
+    }
+  }
+
+ private:
+  friend class FileSink;
+
+  BaseObjectPtr<FileSink> sink_;
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  const size_t offset_;
+  const size_t length_;
+  const int64_t position_;
+
+  // Guarded by sink_->mutex_.
+  bool done_ = false;
+  int error_ = 0;
+  size_t written_ = 0;
+};
+
+FileSink::FileSink(Environment* env,
+                   Local<Object> obj,
+                   uv_file fd,
+                   size_t capacity,
+                   int64_t position)
+    : BaseObject(env, obj),
+      fd_(fd),
+      data_(new char[capacity]),
+      capacity_(capacity),
+      position_(position) {
+  MakeWeak();
+}
+
+void FileSink::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("buffer", capacity_);
+}
+
+int FileSink::WriteRegion(size_t offset,
+                          size_t length,
+                          int64_t position,
+                          size_t* written_total) {
+  *written_total = 0;
+  // The region wraps around the end of the ring buffer at most once.
+  uv_buf_t bufs[2];
+  unsigned int nbufs = 1;
+  const size_t first = std::min(length, capacity_ - offset);
+  bufs[0] = uv_buf_init(data_.get() + offset, first);
+  if (first < length) {
+    bufs[1] = uv_buf_init(data_.get(), length - first);
+    nbufs = 2;
+  }
+
+  while (length > 0) {
+    uv_fs_t req;
+    const int result =
+        uv_fs_write(nullptr, &req, fd_, bufs, nbufs, position, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (result < 0) return result;
+    if (result == 0) return UV_EIO;
+
+    // Skip what has been written and retry the rest.
+    size_t written = result;
+    *written_total += written;
+    length -= written;
+    if (position >= 0) position += written;
+    while (written > 0) {
+      if (written >= bufs[0].len) {
+        written -= bufs[0].len;
+        bufs[0] = bufs[1];
+        nbufs--;
+      } else {
+        bufs[0].base += written;
+        bufs[0].len -= written;
+        written = 0;
+      }
+    }
+  }
+  return 0;
+}
+
+void FileSink::Consume(size_t written) {
+  head_ = (head_ + written) % capacity_;
+  size_ -= written;
+}
+
+void FileSink::FinishFlush(size_t written) {
+  // Data that could not be written stays buffered, and is written at the
+  // same position by the next flush.
+  Consume(written);
+  if (position_ >= 0) position_ -= in_flight_ - written;
+  flush_work_ = nullptr;
+  in_flight_ = 0;
+}
+
+void FileSink::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+
+  CHECK(args[0]->IsInt32());
+  const uv_file fd = args[0].As<Int32>()->Value();
+
+  CHECK(args[1]->IsUint32());
+  const size_t capacity = args[1].As<Uint32>()->Value();
+  CHECK_GT(capacity, 0);
+
+  CHECK(IsSafeJsInt(args[2]));
+  const int64_t position = args[2].As<Integer>()->Value();
+
+  new FileSink(env, args.This(), fd, capacity, position);
+}
+
+void FileSink::Write(const FunctionCallbackInfo<Value>& args) {
+  FileSink* sink;
+  ASSIGN_OR_RETURN_UNWRAP(&sink, args.Holder());
+
+  CHECK(Buffer::HasInstance(args[0]));
+  const char* data = Buffer::Data(args[0]);
+  const size_t length =
+      std::min(Buffer::Length(args[0]), sink->capacity_ - sink->size_);
+
+  const size_t tail = (sink->head_ + sink->size_) % sink->capacity_;
+  const size_t first = std::min(length, sink->capacity_ - tail);
+  memcpy(sink->data_.get() + tail, data, first);
+  memcpy(sink->data_.get(), data + first, length - first);
+  sink->size_ += length;
+
+  args.GetReturnValue().Set(static_cast<double>(length));
+}
+
+void FileSink::Flush(const FunctionCallbackInfo<Value>& args) {
+  FileSink* sink;
+  ASSIGN_OR_RETURN_UNWRAP(&sink, args.Holder());
+  CHECK_NULL(sink->flush_work_);
+
+  FSReqBase* req_wrap = GetReqWrap(args, 0);
+  CHECK_NOT_NULL(req_wrap);
+  req_wrap->Init("write", nullptr, 0, UTF8);
+
+  const size_t length = sink->size_;
+  FlushWork* work = new FlushWork(sink, req_wrap, length, sink->position_);
+  if (sink->position_ >= 0) sink->position_ += length;
+  sink->flush_work_ = work;
+  sink->in_flight_ = length;
+  work->ScheduleWork();
+  req_wrap->SetReturnValue(args);
+}
+
+void FileSink::FlushSync(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  FileSink* sink;
+  ASSIGN_OR_RETURN_UNWRAP(&sink, args.Holder());
+
+  // Earlier data has to reach the file first, so wait for the thread pool.
+  if (sink->flush_work_ != nullptr) {
+    {
+      Mutex::ScopedLock lock(sink->mutex_);
+      while (!sink->flush_work_->done_)
+        sink->flush_done_.Wait(lock);
+    }
+    // The request is still settled by FlushWork::AfterThreadPoolWork(),
+    // which reports the error if it failed.
+    const int err = sink->flush_work_->error_;
+    sink->FinishFlush(sink->flush_work_->written_);
+    if (err != 0) {
+      Local<Context> context = env->context();
+      Local<Object> ctx_obj = args[0].As<Object>();
+      ctx_obj->Set(context, env->errno_string(),
+                   Integer::New(env->isolate(), err)).Check();
+      ctx_obj->Set(context, env->syscall_string(),
+                   FIXED_ONE_BYTE_STRING(env->isolate(), "write")).Check();
+      return;
+    }
+  }
+
+  size_t total = 0;
+  while (sink->size_ > 0) {
+    const size_t length =
+        std::min(sink->size_, sink->capacity_ - sink->head_);
+    size_t written;
+    const int err =
+        sink->WriteRegion(sink->head_, length, sink->position_, &written);
+    if (sink->position_ >= 0) sink->position_ += written;
+    sink->Consume(written);
+    if (err != 0) {
+      Local<Context> context = env->context();
+      Local<Object> ctx_obj = args[0].As<Object>();
+      ctx_obj->Set(context, env->errno_string(),
+                   Integer::New(env->isolate(), err)).Check();
+      ctx_obj->Set(context, env->syscall_string(),
+                   FIXED_ONE_BYTE_STRING(env->isolate(), "write")).Check();
+      return;
+    }
+    total += length;
+  }
+  args.GetReturnValue().Set(static_cast<double>(total));
+}
+
+void FileSink::Buffered(const FunctionCallbackInfo<Value>& args) {
+  FileSink* sink;
+  ASSIGN_OR_RETURN_UNWRAP(&sink, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(sink->size_));
+}
+
+
 // Wrapper for write(2).
 //
 // bytesWritten = write(fd, buffer, offset, length, position, callback)
@@ -2246,6 +3084,26 @@ static void ReadBuffers(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// adviseSequential(fd, offset, length) hints that a range of the file is
+// going to be read sequentially. It does not report errors.
+static void AdviseSequential(const FunctionCallbackInfo<Value>& args) {
+  CHECK_EQ(args.Length(), 3);
+
+  CHECK(args[0]->IsInt32());
+  const int fd = args[0].As<Int32>()->Value();
+
+  CHECK(IsSafeJsInt(args[1]));
+  const int64_t offset = args[1].As<Integer>()->Value();
+  CHECK_GE(offset, 0);
+
+  CHECK(IsSafeJsInt(args[2]));
+  const int64_t length = args[2].As<Integer>()->Value();
+  CHECK_GE(length, 0);
+
+  SetSequentialAdvice(fd, offset, length);
+}
+
+
 /* fs.chmod(path, mode);
  * Wrapper for chmod(1) / EIO_CHMOD
  */
@@ -2607,8 +3465,11 @@ void Initialize(Local<Object> target,
   SetMethod(context, target, "close", Close);
   SetMethod(context, target, "open", Open);
   SetMethod(context, target, "openFileHandle", OpenFileHandle);
+  SetMethod(context, target, "readFileUtf8", ReadFile<true>);
+  SetMethod(context, target, "readFileBuffer", ReadFile<false>);
   SetMethod(context, target, "read", Read);
   SetMethod(context, target, "readBuffers", ReadBuffers);
+  SetMethod(context, target, "adviseSequential", AdviseSequential);
   SetMethod(context, target, "fdatasync", Fdatasync);
   SetMethod(context, target, "fsync", Fsync);
   SetMethod(context, target, "rename", Rename);
@@ -2616,11 +3477,15 @@ void Initialize(Local<Object> target,
   SetMethod(context, target, "rmdir", RMDir);
   SetMethod(context, target, "mkdir", MKDir);
   SetMethod(context, target, "readdir", ReadDir);
-  SetMethod(context, target, "internalModuleReadJSON", InternalModuleReadJSON);
+  SetMethod(context,
+            target,
+            "internalModuleReadPackageJSON",
+            InternalModuleReadPackageJSON);
   SetMethod(context, target, "internalModuleStat", InternalModuleStat);
   SetMethod(context, target, "stat", Stat);
   SetMethod(context, target, "lstat", LStat);
   SetMethod(context, target, "fstat", FStat);
+  SetMethod(context, target, "statMany", StatMany);
   SetMethod(context, target, "link", Link);
   SetMethod(context, target, "symlink", Symlink);
   SetMethod(context, target, "readlink", ReadLink);
@@ -2630,6 +3495,8 @@ void Initialize(Local<Object> target,
   SetMethod(context, target, "writeString", WriteString);
   SetMethod(context, target, "realpath", RealPath);
   SetMethod(context, target, "copyFile", CopyFile);
+  SetMethod(context, target, "cpFile", CpFile);
+  SetMethod(context, target, "mmap", MMap);
 
   SetMethod(context, target, "chmod", Chmod);
   SetMethod(context, target, "fchmod", FChmod);
@@ -2694,6 +3561,16 @@ void Initialize(Local<Object> target,
   SetConstructorFunction(context, target, "FileHandle", fd);
   env->set_fd_constructor_template(fdt);
 
+  // Create FunctionTemplate for FileSink
+  Local<FunctionTemplate> sink = NewFunctionTemplate(isolate, FileSink::New);
+  sink->InstanceTemplate()->SetInternalFieldCount(
+      FileSink::kInternalFieldCount);
+  SetProtoMethod(isolate, sink, "write", FileSink::Write);
+  SetProtoMethod(isolate, sink, "flush", FileSink::Flush);
+  SetProtoMethod(isolate, sink, "flushSync", FileSink::FlushSync);
+  SetProtoMethodNoSideEffect(isolate, sink, "buffered", FileSink::Buffered);
+  SetConstructorFunction(context, target, "FileSink", sink);
+
   // Create FunctionTemplate for FileHandle::CloseReq
   Local<FunctionTemplate> fdclose = FunctionTemplate::New(isolate);
   fdclose->SetClassName(FIXED_ONE_BYTE_STRING(isolate,
@@ -2722,9 +3599,12 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
 
   registry->Register(Close);
   registry->Register(Open);
+  registry->Register(ReadFile<true>);
+  registry->Register(ReadFile<false>);
   registry->Register(OpenFileHandle);
   registry->Register(Read);
   registry->Register(ReadBuffers);
+  registry->Register(AdviseSequential);
   registry->Register(Fdatasync);
   registry->Register(Fsync);
   registry->Register(Rename);
@@ -2732,11 +3612,12 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(RMDir);
   registry->Register(MKDir);
   registry->Register(ReadDir);
-  registry->Register(InternalModuleReadJSON);
+  registry->Register(InternalModuleReadPackageJSON);
   registry->Register(InternalModuleStat);
   registry->Register(Stat);
   registry->Register(LStat);
   registry->Register(FStat);
+  registry->Register(StatMany);
   registry->Register(Link);
   registry->Register(Symlink);
   registry->Register(ReadLink);
@@ -2746,6 +3627,8 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(WriteString);
   registry->Register(RealPath);
   registry->Register(CopyFile);
+  registry->Register(CpFile);
+  registry->Register(MMap);
 
   registry->Register(Chmod);
   registry->Register(FChmod);
@@ -2762,6 +3645,11 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(NewFSReqCallback);
 
   registry->Register(FileHandle::New);
+  registry->Register(FileSink::New);
+  registry->Register(FileSink::Write);
+  registry->Register(FileSink::Flush);
+  registry->Register(FileSink::FlushSync);
+  registry->Register(FileSink::Buffered);
   registry->Register(FileHandle::Close);
   registry->Register(FileHandle::ReleaseFD);
   StreamBase::RegisterExternalReferences(registry);
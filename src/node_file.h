@@ -5,6 +5,7 @@
 
 #include "aliased_buffer.h"
 #include "node_messaging.h"
+#include "node_mutex.h"
 #include "node_snapshotable.h"
 #include "stream_base.h"
 
@@ -355,6 +356,8 @@ class FileHandle final : public AsyncWrap, public StreamBase {
   bool closing_ = false;
   bool closed_ = false;
   bool reading_ = false;
+  // Whether the read pattern has been passed to posix_fadvise().
+  bool advised_ = false;
   int64_t read_offset_ = -1;
   int64_t read_length_ = -1;
 
@@ -363,6 +366,70 @@ class FileHandle final : public AsyncWrap, public StreamBase {
   BaseObjectPtr<BindingData> binding_data_;
 };
 
+// Buffers writes to a file descriptor in a fixed-size ring buffer, so that
+// many small writes reach the file through a single write on the thread pool
+// or through FlushSync(). Data can be added while a flush is in progress, as
+// long as there is room next to the part of the buffer being written.
+//
+// The sink does not own the fd. fs.WriteStream keeps it open until the last
+// flush has completed, including when the fd belongs to a FileHandle, which
+// the stream holds a reference to.
+class FileSink final : public BaseObject {
+ public:
+  FileSink(Environment* env,
+           v8::Local<v8::Object> obj,
+           uv_file fd,
+           size_t capacity,
+           int64_t position);
+
+  // new FileSink(fd, capacity, position)
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // sink.write(buffer) copies as much of the data as fits and returns the
+  // number of bytes copied.
+  static void Write(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // sink.flush(req) writes the buffered data and resolves with the number of
+  // bytes written. Only one flush may be in progress at a time.
+  static void Flush(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // sink.flushSync(ctx) waits for a flush in progress, then writes the rest
+  // of the buffered data and returns the number of bytes it wrote itself.
+  static void FlushSync(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // sink.buffered() returns the number of bytes not yet written.
+  static void Buffered(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(FileSink)
+  SET_SELF_SIZE(FileSink)
+
+ private:
+  class FlushWork;
+
+  // Writes `length` bytes starting at `offset` in the ring buffer, and
+  // stores the number of bytes written before any error in `written`.
+  int WriteRegion(size_t offset,
+                  size_t length,
+                  int64_t position,
+                  size_t* written);
+  // Drops the oldest `written` bytes, which have reached the file.
+  void Consume(size_t written);
+  // Accounts for the end of the flush in progress, of which `written` bytes
+  // have reached the file.
+  void FinishFlush(size_t written);
+
+  uv_file fd_;
+  std::unique_ptr<char[]> data_;
+  size_t capacity_;
+  // -1 to write at the current file position.
+  int64_t position_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+
+  // Set while a FlushWork is writing the oldest `in_flight_` bytes.
+  FlushWork* flush_work_ = nullptr;
+  size_t in_flight_ = 0;
+  Mutex mutex_;
+  ConditionVariable flush_done_;
+};
+
 int MKDirpSync(uv_loop_t* loop,
                uv_fs_t* req,
                const std::string& path,
@@ -0,0 +1,443 @@
+#include "node_package_json.h"
+#include "env-inl.h"
+#include "node_mutex.h"
+#include "util-inl.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace node {
+namespace package_json {
+
+namespace {
+
+// Deeper documents are left to JSON.parse().
+constexpr int kMaxDepth = 1000;
+
+// A validating scanner for JSON text that only decodes the strings it is
+// asked for. Everything else is skipped.
+class Scanner {
+ public:
+  Scanner(const char* data, size_t size) : p_(data), end_(data + size) {}
+
+  bool ParseDocument(PackageJson* pkg);
+
+ private:
+  void SkipWhitespace() {
+    while (p_ < end_ &&
+           (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) {
+      p_++;
+    }
+  }
+
+  bool Consume(char c) {
+    if (p_ >= end_ || *p_ != c) return false;
+    p_++;
+    return true;
+  }
+
+  bool SkipLiteral(const char* literal) {
+    const size_t length = strlen(literal);
+    if (static_cast<size_t>(end_ - p_) < length ||
+        memcmp(p_, literal, length) != 0) {
+      return false;
+    }
+    p_ += length;
+    return true;
+  }
+
+  bool SkipDigits() {
+    const char* start = p_;
+    while (p_ < end_ && *p_ >= '0' && *p_ <= '9') p_++;
+    return p_ > start;
+  }
+
+  bool SkipNumber();
+  bool ReadHex4(uint32_t* value);
+  // Decodes the string at the current position into `out` unless it is
+  // nullptr. `exact` is set to false if the string contains lone surrogates,
+  // which cannot be represented in UTF-8.
+  bool ScanString(std::string* out, bool* exact);
+  bool SkipValue(int depth);
+  // Like SkipValue(), but builds the value. `exact` is set to false if any
+  // of the strings contains lone surrogates.
+  bool ParseValue(JsonValue* out, int depth, bool* exact);
+
+  const char* p_;
+  const char* end_;
+};
+
+void AppendUtf8(std::string* out, uint32_t code_point) {
+  if (code_point < 0x80) {
+    *out += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    *out += static_cast<char>(0xC0 | (code_point >> 6));
+    *out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    *out += static_cast<char>(0xE0 | (code_point >> 12));
+    *out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    *out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    *out += static_cast<char>(0xF0 | (code_point >> 18));
+    *out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    *out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    *out += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+
+bool Scanner::SkipNumber() {
+  Consume('-');
+  if (!Consume('0') && !SkipDigits()) return false;
+  if (Consume('.') && !SkipDigits()) return false;
+  if (Consume('e') || Consume('E')) {
+    if (!Consume('+')) Consume('-');
+    if (!SkipDigits()) return false;
+  }
+  return true;
+}
+
+bool Scanner::ReadHex4(uint32_t* value) {
+  if (end_ - p_ < 4) return false;
+  *value = 0;
+  for (int i = 0; i < 4; i++) {
+    const char c = *p_++;
+    uint32_t digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      digit = c - 'A' + 10;
+    } else {
+      return false;
+    }
+    *value = (*value << 4) | digit;
+  }
+  return true;
+}
+
+bool Scanner::ScanString(std::string* out, bool* exact) {
+  if (!Consume('"')) return false;
+  while (p_ < end_) {
+    const char c = *p_++;
+    if (c == '"') return true;
+    if (static_cast<unsigned char>(c) < 0x20) return false;
+    if (c != '\\') {
+      if (out != nullptr) *out += c;
+      continue;
+    }
+    if (p_ >= end_) return false;
+    const char escape = *p_++;
+    char decoded;
+    switch (escape) {
+      case '"': decoded = '"'; break;
+      case '\\': decoded = '\\'; break;
+      case '/': decoded = '/'; break;
+      case 'b': decoded = '\b'; break;
+      case 'f': decoded = '\f'; break;
+      case 'n': decoded = '\n'; break;
+      case 'r': decoded = '\r'; break;
+      case 't': decoded = '\t'; break;
+      case 'u': {
+        uint32_t code_point;
+        if (!ReadHex4(&code_point)) return false;
+        if (code_point >= 0xD800 && code_point <= 0xDBFF &&
+            end_ - p_ >= 6 && p_[0] == '\\' && p_[1] == 'u') {
+          const char* low_start = p_;
+          p_ += 2;
+          uint32_t low;
+          if (!ReadHex4(&low)) return false;
+          if (low >= 0xDC00 && low <= 0xDFFF) {
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                         (low - 0xDC00);
+          } else {
+            // Not a pair, decode the second escape on its own.
+            p_ = low_start;
+          }
+        }
+        if (code_point >= 0xD800 && code_point <= 0xDFFF) *exact = false;
+        if (out != nullptr) AppendUtf8(out, code_point);
+        continue;
+      }
+      default:
+        return false;
+    }
+    if (out != nullptr) *out += decoded;
+  }
+  return false;
+}
+
+bool Scanner::SkipValue(int depth) {
+  if (depth > kMaxDepth) return false;
+  SkipWhitespace();
+  if (p_ >= end_) return false;
+  switch (*p_) {
+    case '"': {
+      bool exact = true;
+      return ScanString(nullptr, &exact);
+    }
+    case '{':
+    case '[': {
+      const bool is_object = *p_++ == '{';
+      const char close = is_object ? '}' : ']';
+      SkipWhitespace();
+      if (Consume(close)) return true;
+      do {
+        if (is_object) {
+          SkipWhitespace();
+          bool exact = true;
+          if (!ScanString(nullptr, &exact)) return false;
+          SkipWhitespace();
+          if (!Consume(':')) return false;
+        }
+        if (!SkipValue(depth + 1)) return false;
+        SkipWhitespace();
+      } while (Consume(','));
+      return Consume(close);
+    }
+    case 't':
+      return SkipLiteral("true");
+    case 'f':
+      return SkipLiteral("false");
+    case 'n':
+      return SkipLiteral("null");
+    default:
+      return SkipNumber();
+  }
+}
+
+bool Scanner::ParseValue(JsonValue* out, int depth, bool* exact) {
+  if (depth > kMaxDepth) return false;
+  SkipWhitespace();
+  if (p_ >= end_) return false;
+  switch (*p_) {
+    case '"':
+      out->type = JsonValue::Type::kString;
+      return ScanString(&out->string, exact);
+    case '[':
+      p_++;
+      out->type = JsonValue::Type::kArray;
+      SkipWhitespace();
+      if (Consume(']')) return true;
+      do {
+        out->array.emplace_back();
+        if (!ParseValue(&out->array.back(), depth + 1, exact)) return false;
+        SkipWhitespace();
+      } while (Consume(','));
+      return Consume(']');
+    case '{':
+      p_++;
+      out->type = JsonValue::Type::kObject;
+      SkipWhitespace();
+      if (Consume('}')) return true;
+      do {
+        SkipWhitespace();
+        std::string key;
+        if (!ScanString(&key, exact)) return false;
+        SkipWhitespace();
+        if (!Consume(':')) return false;
+        JsonValue value;
+        if (!ParseValue(&value, depth + 1, exact)) return false;
+        auto it = std::find_if(
+            out->object.begin(), out->object.end(), [&](const auto& entry) {
+              return entry.first == key;
+            });
+        if (it != out->object.end()) {
+          it->second = std::move(value);
+        } else {
+          out->object.emplace_back(std::move(key), std::move(value));
+        }
+        SkipWhitespace();
+      } while (Consume(','));
+      return Consume('}');
+    case 't':
+      out->type = JsonValue::Type::kBoolean;
+      return SkipLiteral("true");
+    case 'f':
+      out->type = JsonValue::Type::kBoolean;
+      return SkipLiteral("false");
+    case 'n':
+      out->type = JsonValue::Type::kNull;
+      return SkipLiteral("null");
+    default:
+      out->type = JsonValue::Type::kNumber;
+      return SkipNumber();
+  }
+}
+
+bool Scanner::ParseDocument(PackageJson* pkg) {
+  SkipWhitespace();
+  if (!Consume('{')) return false;
+  SkipWhitespace();
+  if (!Consume('}')) {
+    do {
+      SkipWhitespace();
+      std::string key;
+      bool exact = true;
+      if (!ScanString(&key, &exact)) return false;
+      SkipWhitespace();
+      if (!Consume(':')) return false;
+      SkipWhitespace();
+
+      std::optional<std::string>* field = nullptr;
+      std::shared_ptr<const JsonValue>* field_value = nullptr;
+      uint32_t raw_flag = 0;
+      if (key == "name") {
+        field = &pkg->name;
+        raw_flag = PackageJson::kRawName;
+      } else if (key == "main") {
+        field = &pkg->main;
+        raw_flag = PackageJson::kRawMain;
+      } else if (key == "type") {
+        field = &pkg->type;
+        raw_flag = PackageJson::kRawType;
+      } else if (key == "exports") {
+        field = &pkg->exports;
+        field_value = &pkg->exports_value;
+      } else if (key == "imports") {
+        field = &pkg->imports;
+        field_value = &pkg->imports_value;
+      }
+
+      const char* value_start = p_;
+      if (field == nullptr) {
+        if (!SkipValue(1)) return false;
+        SkipWhitespace();
+        continue;
+      }
+
+      // Later keys win, like in JSON.parse().
+      pkg->flags |= PackageJson::kContainsKeys;
+      pkg->flags &= ~raw_flag;
+      std::string value;
+      exact = true;
+      if (field_value != nullptr) {
+        auto parsed = std::make_shared<JsonValue>();
+        if (!ParseValue(parsed.get(), 1, &exact)) return false;
+        if (exact) {
+          *field_value = std::move(parsed);
+        } else {
+          field_value->reset();
+        }
+        exact = false;
+      } else if (raw_flag != 0 && p_ < end_ && *p_ == '"') {
+        if (!ScanString(&value, &exact)) return false;
+      } else {
+        if (!SkipValue(1)) return false;
+        exact = false;
+      }
+      if (!exact) {
+        value.assign(value_start, p_ - value_start);
+        pkg->flags |= raw_flag;
+      }
+      *field = std::move(value);
+      SkipWhitespace();
+    } while (Consume(','));
+    if (!Consume('}')) return false;
+  }
+  SkipWhitespace();
+  return p_ == end_;
+}
+
+// Checks whether the text contains one of the fields as a quoted string.
+// This is used for files that are not handled by the scanner, for which
+// require() has always ignored parse errors if none of the fields appear.
+bool RoughlyContainsKeys(const std::string& source) {
+  const char* p = source.data();
+  const char* pe = p + source.size();
+  const char* pos[2];
+  const char** ppos = &pos[0];
+
+  while (p < pe) {
+    char c = *p++;
+    if (c == '\\' && p < pe && *p == '"') p++;
+    if (c != '"') continue;
+    *ppos++ = p;
+    if (ppos < &pos[2]) continue;
+    ppos = &pos[0];
+
+    const char* s = &pos[0][0];
+    const char* se = &pos[1][-1];  // Exclude quote.
+    size_t n = se - s;
+
+    if (n == 4) {
+      if (0 == memcmp(s, "main", 4)) return true;
+      if (0 == memcmp(s, "name", 4)) return true;
+      if (0 == memcmp(s, "type", 4)) return true;
+    } else if (n == 7) {
+      if (0 == memcmp(s, "exports", 7)) return true;
+      if (0 == memcmp(s, "imports", 7)) return true;
+    }
+  }
+  return false;
+}
+
+Mutex cache_mutex;
+std::unordered_map<std::string, std::shared_ptr<const PackageJson>> cache;
+
+std::shared_ptr<const PackageJson> ReadUncached(const std::string& path) {
+  std::string source;
+  if (ReadFileSync(&source, path.c_str()) != 0) return nullptr;
+  return std::make_shared<const PackageJson>(Parse(std::move(source)));
+}
+
+}  // anonymous namespace
+
+const JsonValue* JsonValue::Get(const std::string& key) const {
+  if (type != Type::kObject) return nullptr;
+  for (const auto& entry : object) {
+    if (entry.first == key) return &entry.second;
+  }
+  return nullptr;
+}
+
+PackageJson Parse(std::string source) {
+  size_t start = 0;
+  if (source.size() >= 3 && 0 == memcmp(source.data(), "\xEF\xBB\xBF", 3)) {
+    start = 3;  // Skip UTF-8 BOM.
+  }
+
+  PackageJson pkg;
+  Scanner scanner(source.data() + start, source.size() - start);
+  if (!scanner.ParseDocument(&pkg)) {
+    pkg = PackageJson();
+    pkg.flags = PackageJson::kNeedsParse;
+    source.erase(0, start);
+    if (RoughlyContainsKeys(source)) pkg.flags |= PackageJson::kContainsKeys;
+    pkg.source = std::move(source);
+  }
+  return pkg;
+}
+
+std::shared_ptr<const PackageJson> Read(Environment* env,
+                                        const std::string& path,
+                                        bool include_source) {
+  if (include_source) {
+    std::string source;
+    if (ReadFileSync(&source, path.c_str()) != 0) return nullptr;
+    PackageJson pkg = Parse(source);
+    if (source.size() >= 3 && 0 == memcmp(source.data(), "\xEF\xBB\xBF", 3))
+      source.erase(0, 3);
+    pkg.source = std::move(source);
+    return std::make_shared<const PackageJson>(std::move(pkg));
+  }
+
+  {
+    Mutex::ScopedLock lock(cache_mutex);
+    auto it = cache.find(path);
+    if (it != cache.end()) return it->second;
+  }
+
+  // Parse outside of the lock, so that threads do not wait for each other's
+  // file system accesses.
+  std::shared_ptr<const PackageJson> pkg = ReadUncached(path);
+  if (env->is_main_thread()) {
+    Mutex::ScopedLock lock(cache_mutex);
+    cache.emplace(path, pkg);
+  }
+  return pkg;
+}
+
+}  // namespace package_json
+}  // namespace node
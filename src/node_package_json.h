@@ -0,0 +1,93 @@
+#ifndef SRC_NODE_PACKAGE_JSON_H_
+#define SRC_NODE_PACKAGE_JSON_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cinttypes>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace node {
+class Environment;
+
+namespace package_json {
+
+// A parsed JSON value. Numbers and booleans are only kept as types, since
+// the module resolvers do not look at their values.
+struct JsonValue {
+  enum class Type : uint8_t {
+    kNull,
+    kBoolean,
+    kNumber,
+    kString,
+    kArray,
+    kObject,
+  };
+
+  Type type = Type::kNull;
+  std::string string;
+  std::vector<JsonValue> array;
+  // In the order in which JSON.parse() would create the properties, i.e.
+  // duplicate keys keep the position of their first occurrence.
+  std::vector<std::pair<std::string, JsonValue>> object;
+
+  // Returns nullptr if this is not an object or has no such key.
+  const JsonValue* Get(const std::string& key) const;
+};
+
+// The fields of a package.json file that the module resolvers look at.
+// The file is parsed once, and only these fields are kept.
+struct PackageJson {
+  // Keep in sync with lib/internal/modules/package_json_reader.js.
+  enum Flags : uint32_t {
+    // One of the fields below is present.
+    kContainsKeys = 1 << 0,
+    // The file could not be handled by the scanner, e.g. because it is not
+    // valid JSON. `source` contains the file, and callers have to parse it
+    // themselves to report the error.
+    kNeedsParse = 1 << 1,
+    // The value of `name`, `main` or `type` is not a string and is stored as
+    // JSON text instead.
+    kRawName = 1 << 2,
+    kRawMain = 1 << 3,
+    kRawType = 1 << 4,
+  };
+
+  uint32_t flags = 0;
+  std::optional<std::string> name;
+  std::optional<std::string> main;
+  std::optional<std::string> type;
+  // JSON text of the values.
+  std::optional<std::string> exports;
+  std::optional<std::string> imports;
+  // The parsed values, for the native ESM resolver. These are nullptr if the
+  // field is absent or contains strings that cannot be represented in UTF-8.
+  std::shared_ptr<const JsonValue> exports_value;
+  std::shared_ptr<const JsonValue> imports_value;
+  // Only set if kNeedsParse is set or if the caller asked for it.
+  std::string source;
+};
+
+// Parses `source`. The parser accepts the same documents as JSON.parse(),
+// but gives up with kNeedsParse on documents that are not objects or that are
+// nested very deeply.
+PackageJson Parse(std::string source);
+
+// Returns the parsed package.json at `path`, or nullptr if it cannot be read.
+// Files are cached for the lifetime of the process. The main thread fills the
+// cache, and worker threads only read from it, so that they do not hold on to
+// files that only they have looked at. If `include_source` is true, the file
+// is read again, bypassing the cache, and `source` is set.
+std::shared_ptr<const PackageJson> Read(Environment* env,
+                                        const std::string& path,
+                                        bool include_source);
+
+}  // namespace package_json
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_PACKAGE_JSON_H_
@@ -1,5 +1,6 @@
 
 #include "node_snapshotable.h"
+#include <fcntl.h>
 #include <iostream>
 #include <sstream>
 #include "base_object-inl.h"
@@ -24,6 +25,10 @@
 #include "inspector/worker_inspector.h"  // ParentInspectorHandle
 #endif
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 namespace node {
 
 using v8::Context;
@@ -61,6 +66,23 @@ std::ostream& operator<<(std::ostream& output,
   return output;
 }
 
+std::ostream& operator<<(std::ostream& output,
+                         const builtins::CodeCacheRef& info) {
+  output << "<builtins::CodeCacheRef id=" << info.id
+         << ", size=" << info.length << ">\n";
+  return output;
+}
+
+std::ostream& operator<<(std::ostream& output,
+                         const std::vector<builtins::CodeCacheRef>& vec) {
+  output << "{\n";
+  for (const auto& info : vec) {
+    output << info;
+  }
+  output << "}\n";
+  return output;
+}
+
 std::ostream& operator<<(std::ostream& output,
                          const std::vector<uint8_t>& vec) {
   output << "{\n";
@@ -134,11 +156,15 @@ std::ostream& operator<<(std::ostream& output, const EnvSerializeInfo& i) {
   return output;
 }
 
+// Large sections of the blob, i.e. the V8 startup data and the code cache of
+// each built-in, start at offsets that are multiples of this, so that they
+// can be used in place when the blob is memory-mapped.
+constexpr size_t kBlobSectionAlignment = 8;
+
 class FileIO {
  public:
-  explicit FileIO(FILE* file)
-      : f(file),
-        is_debug(per_process::enabled_debug_list.enabled(
+  FileIO()
+      : is_debug(per_process::enabled_debug_list.enabled(
             DebugCategory::MKSNAPSHOT)) {}
 
   template <typename... Args>
@@ -158,6 +184,7 @@ class FileIO {
   std::string GetName() const {
 #define TYPE_LIST(V)                                                           \
   V(builtins::CodeCacheInfo)                                                   \
+  V(builtins::CodeCacheRef)                                                    \
   V(PropInfo)                                                                  \
   V(std::string)
 
@@ -180,13 +207,13 @@ class FileIO {
     return name;
   }
 
-  FILE* f = nullptr;
   bool is_debug = false;
 };
 
+// Reads a blob that is in memory, e.g. a memory-mapped file.
 class FileReader : public FileIO {
  public:
-  explicit FileReader(FILE* file) : FileIO(file) {}
+  FileReader(const char* data, size_t size) : data_(data), size_(size) {}
   ~FileReader() {}
 
   // Helper for reading numeric types.
@@ -231,10 +258,8 @@ class FileReader : public FileIO {
     }
 
     CHECK_GT(length, 0);  // There should be no empty strings.
-    MallocedBuffer<char> buf(length + 1);
-    size_t r = fread(buf.data, 1, length + 1, f);
-    CHECK_EQ(r, length + 1);
-    std::string result(buf.data, length);  // This creates a copy of buf.data.
+    std::string result(Consume(length + 1), length);
+    size_t r = length + 1;
 
     if (is_debug) {
       Debug("\"%s\", read %d bytes\n", result.c_str(), r);
@@ -244,9 +269,28 @@ class FileReader : public FileIO {
     return result;
   }
 
+  // Returns a pointer to the next `length` bytes, which start at a multiple
+  // of kBlobSectionAlignment. The bytes are not copied.
+  const char* ReadAlignedBytes(size_t length) {
+    size_t padding = RoundUp(pos_, kBlobSectionAlignment) - pos_;
+    Consume(padding);
+    if (is_debug) {
+      Debug("ReadAlignedBytes(), length=%d, offset=%d\n", length, pos_);
+    }
+    read_total += padding + length;
+    return Consume(length);
+  }
+
   size_t read_total = 0;
 
  private:
+  const char* Consume(size_t length) {
+    CHECK_LE(length, size_ - pos_);
+    const char* result = data_ + pos_;
+    pos_ += length;
+    return result;
+  }
+
   // Helper for reading an array of numeric types.
   template <typename T>
   void Read(T* out, size_t count) {
@@ -257,8 +301,8 @@ class FileReader : public FileIO {
       Debug("Read<%s>()(%d-byte), count=%d: ", name.c_str(), sizeof(T), count);
     }
 
-    size_t r = fread(out, sizeof(T), count, f);
-    CHECK_EQ(r, count);
+    memcpy(out, Consume(sizeof(T) * count), sizeof(T) * count);
+    size_t r = count;
 
     if (is_debug) {
       std::string str =
@@ -297,11 +341,15 @@ class FileReader : public FileIO {
 
     return result;
   }
+
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
 };
 
 class FileWriter : public FileIO {
  public:
-  explicit FileWriter(FILE* file) : FileIO(file) {}
+  explicit FileWriter(FILE* file) : f(file) {}
   ~FileWriter() {}
 
   // Helper for writing numeric types.
@@ -362,6 +410,26 @@ class FileWriter : public FileIO {
     return written_total;
   }
 
+  // Writes `length` bytes at the next multiple of kBlobSectionAlignment.
+  // See FileReader::ReadAlignedBytes().
+  size_t WriteAlignedBytes(const char* data, size_t length) {
+    long offset = ftell(f);  // NOLINT(runtime/int)
+    CHECK_GE(offset, 0);
+    static const char zeros[kBlobSectionAlignment] = {};
+    size_t padding =
+        RoundUp(static_cast<size_t>(offset), kBlobSectionAlignment) - offset;
+    if (padding > 0) CHECK_EQ(fwrite(zeros, 1, padding, f), padding);
+    if (is_debug) {
+      Debug("WriteAlignedBytes(), length=%d, offset=%d\n",
+            length,
+            offset + padding);
+    }
+    CHECK_EQ(fwrite(data, 1, length, f), length);
+    return padding + length;
+  }
+
+  FILE* f;
+
  private:
   // Helper for writing an array of numeric types.
   template <typename T>
@@ -436,11 +504,8 @@ v8::StartupData FileReader::Read() {
   Debug("size=%d\n", raw_size);
 
   CHECK_GT(raw_size, 0);  // There should be no startup data of size 0.
-  // The data pointer of v8::StartupData would be deleted so it must be new'ed.
-  std::unique_ptr<char> buf = std::unique_ptr<char>(new char[raw_size]);
-  Read<char>(buf.get(), raw_size);
-
-  return v8::StartupData{buf.release(), raw_size};
+  // The data stays in the blob, see SnapshotData::is_file_backed.
+  return v8::StartupData{ReadAlignedBytes(raw_size), raw_size};
 }
 
 template <>
@@ -449,7 +514,8 @@ size_t FileWriter::Write(const v8::StartupData& data) {
 
   CHECK_GT(data.raw_size, 0);  // There should be no startup data of size 0.
   size_t written_total = Write<int>(data.raw_size);
-  written_total += Write<char>(data.data, static_cast<size_t>(data.raw_size));
+  written_total +=
+      WriteAlignedBytes(data.data, static_cast<size_t>(data.raw_size));
 
   Debug("Write<v8::StartupData>() wrote %d bytes\n\n", written_total);
   return written_total;
@@ -459,16 +525,22 @@ size_t FileWriter::Write(const v8::StartupData& data) {
 // [  4/8 bytes ]  length of the module id string
 // [    ...     ]  |length| bytes of module id
 // [  4/8 bytes ]  length of module code cache
+// [    ...     ]  padding to kBlobSectionAlignment
 // [    ...     ]  |length| bytes of module code cache
+// It is read back as a builtins::CodeCacheRef that points into the blob.
 template <>
-builtins::CodeCacheInfo FileReader::Read() {
-  Debug("Read<builtins::CodeCacheInfo>()\n");
+builtins::CodeCacheRef FileReader::Read() {
+  Debug("Read<builtins::CodeCacheRef>()\n");
 
-  builtins::CodeCacheInfo result{ReadString(), ReadVector<uint8_t>()};
+  builtins::CodeCacheRef result;
+  result.id = ReadString();
+  result.length = Read<size_t>();
+  result.data = reinterpret_cast<const uint8_t*>(
+      result.length > 0 ? ReadAlignedBytes(result.length) : nullptr);
 
   if (is_debug) {
     std::string str = ToStr(result);
-    Debug("Read<builtins::CodeCacheInfo>() %s\n", str.c_str());
+    Debug("Read<builtins::CodeCacheRef>() %s\n", str.c_str());
   }
   return result;
 }
@@ -481,7 +553,11 @@ size_t FileWriter::Write(const builtins::CodeCacheInfo& data) {
         data.data.size());
 
   size_t written_total = WriteString(data.id);
-  written_total += WriteVector<uint8_t>(data.data);
+  written_total += Write<size_t>(data.data.size());
+  if (!data.data.empty()) {
+    written_total += WriteAlignedBytes(
+        reinterpret_cast<const char*>(data.data.data()), data.data.size());
+  }
 
   Debug("Write<builtins::CodeCacheInfo>() wrote %d bytes\n", written_total);
   return written_total;
@@ -824,7 +900,8 @@ size_t FileWriter::Write(const SnapshotMetadata& data) {
 // [    ...       ]  contents of Node.js version string
 // [   4/8 bytes  ]  length of Node.js arch string
 // [    ...       ]  contents of Node.js arch string
-// [    ...       ]  v8_snapshot_blob_data from SnapshotCreator::CreateBlob()
+// [    ...       ]  v8_snapshot_blob_data from SnapshotCreator::CreateBlob(),
+//                   aligned to kBlobSectionAlignment
 // [    ...       ]  isolate_data_info
 // [    ...       ]  env_info
 // [    ...       ]  code_cache
@@ -850,16 +927,71 @@ void SnapshotData::ToBlob(FILE* out) const {
   w.Debug("SnapshotData::ToBlob() Wrote %d bytes\n", written_total);
 }
 
-bool SnapshotData::FromBlob(SnapshotData* out, FILE* in) {
-  FileReader r(in);
-  r.Debug("SnapshotData::FromBlob()\n");
+// Maps the file at `path` read-only into memory. The mapping is never
+// unmapped, because V8 and the built-in loader keep pointers into it.
+static const char* MapFileForReading(const std::string& path, size_t* size) {
+  uv_fs_t req;
+  int fd = uv_fs_open(nullptr, &req, path.c_str(), O_RDONLY, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0) return nullptr;
+  auto close_fd = OnScopeLeave([&]() {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+    uv_fs_req_cleanup(&close_req);
+  });
+
+  if (uv_fs_fstat(nullptr, &req, fd, nullptr) != 0) {
+    uv_fs_req_cleanup(&req);
+    return nullptr;
+  }
+  *size = static_cast<size_t>(req.statbuf.st_size);
+  uv_fs_req_cleanup(&req);
+  if (*size == 0) return nullptr;
+
+  void* base = nullptr;
+#ifdef _WIN32
+  HANDLE file = reinterpret_cast<HANDLE>(uv_get_osfhandle(fd));
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) return nullptr;
+  base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, *size);
+  // The view keeps the mapping alive.
+  CloseHandle(mapping);
+#else
+  base = mmap(nullptr, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (base == MAP_FAILED) base = nullptr;
+#endif
+  return static_cast<const char*>(base);
+}
+
+bool SnapshotData::FromFile(SnapshotData* out, const std::string& path) {
+  size_t size = 0;
+  const char* data = MapFileForReading(path, &size);
+  if (data == nullptr) {
+    fprintf(stderr, "Cannot open %s\n", path.c_str());
+    return false;
+  }
+
+  FileReader r(data, size);
+  r.Debug("SnapshotData::FromFile()\n");
 
   DCHECK_EQ(out->data_ownership, SnapshotData::DataOwnership::kOwned);
+  out->is_file_backed = true;
 
   // Metadata
+  if (size < sizeof(kMagic)) {
+    fprintf(stderr, "%s is not a snapshot blob\n", path.c_str());
+    return false;
+  }
   uint32_t magic = r.Read<uint32_t>();
   r.Debug("Read magic %" PRIx32 "\n", magic);
-  CHECK_EQ(magic, kMagic);
+  if (magic != kMagic) {
+    fprintf(stderr,
+            "%s is not a snapshot blob or was built by an incompatible "
+            "version of Node.js\n",
+            path.c_str());
+    return false;
+  }
   out->metadata = r.Read<SnapshotMetadata>();
   r.Debug("Read metadata\n");
   if (!out->Check()) {
@@ -871,9 +1003,9 @@ bool SnapshotData::FromBlob(SnapshotData* out, FILE* in) {
   out->isolate_data_info = r.Read<IsolateDataSerializeInfo>();
   out->env_info = r.Read<EnvSerializeInfo>();
   r.Debug("Read code_cache\n");
-  out->code_cache = r.ReadVector<builtins::CodeCacheInfo>();
+  out->mapped_code_cache = r.ReadVector<builtins::CodeCacheRef>();
 
-  r.Debug("SnapshotData::FromBlob() read %d bytes\n", r.read_total);
+  r.Debug("SnapshotData::FromFile() read %d bytes\n", r.read_total);
   return true;
 }
 
@@ -925,7 +1057,7 @@ bool SnapshotData::Check() const {
 }
 
 SnapshotData::~SnapshotData() {
-  if (data_ownership == DataOwnership::kOwned &&
+  if (data_ownership == DataOwnership::kOwned && !is_file_backed &&
       v8_snapshot_blob_data.data != nullptr) {
     delete[] v8_snapshot_blob_data.data;
   }
@@ -1191,6 +1323,14 @@ int SnapshotBuilder::Generate(SnapshotData* out,
         if (exit_code != 0) {
           return exit_code;
         }
+        // CommonJS modules can be snapshotted, but ModuleWraps cannot be
+        // serialized yet.
+        if (!env->id_to_module_map.empty()) {
+          fprintf(stderr,
+                  "ES modules are not yet supported in the snapshot. Use "
+                  "require() to load the application instead.\n");
+          return SNAPSHOT_ERROR;
+        }
       }
 
       if (per_process::enabled_debug_list.enabled(DebugCategory::MKSNAPSHOT)) {
@@ -27,7 +27,8 @@ struct PropInfo {
   V(v8_binding_data, v8_utils::BindingData)                                    \
   V(blob_binding_data, BlobBindingData)                                        \
   V(process_binding_data, process::BindingData)                                \
-  V(util_weak_reference, util::WeakReference)
+  V(util_weak_reference, util::WeakReference)                                  \
+  V(compiled_fn_entry, contextify::CompiledFnEntry)
 
 enum class EmbedderObjectType : uint8_t {
 #define V(PropertyName, NativeType) k_##PropertyName,
@@ -25,11 +25,16 @@
 #include "memory_tracker-inl.h"
 #include "node_external_reference.h"
 #include "node_file-inl.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
 #include <cstring>
 #include <cstdlib>
 
+#ifdef __linux__
+#include <sys/vfs.h>
+#endif
+
 namespace node {
 
 using v8::Context;
@@ -43,6 +48,143 @@ using v8::Object;
 using v8::Uint32;
 using v8::Value;
 
+namespace {
+
+#ifdef __linux__
+// Filesystems whose changes are not reliably reported through inotify,
+// either because they can be changed remotely or because they are
+// synthesized by the kernel. Files on them are always polled.
+constexpr uint32_t kPolledFilesystems[] = {
+  0x6969,      // NFS_SUPER_MAGIC
+  0x517b,      // SMB_SUPER_MAGIC
+  0xff534d42,  // CIFS_SUPER_MAGIC
+  0xfe534d42,  // SMB2_SUPER_MAGIC
+  0x65735546,  // FUSE_SUPER_MAGIC
+  0x01021997,  // V9FS_MAGIC
+  0x00c36400,  // CEPH_SUPER_MAGIC
+  0x5346414f,  // AFS_SUPER_MAGIC
+  0x73757245,  // CODA_SUPER_MAGIC
+  0x9fa0,      // PROC_SUPER_MAGIC
+  0x62656572,  // SYSFS_MAGIC
+};
+#endif
+
+void SplitPath(const std::string& path, std::string* dir, std::string* name) {
+  const size_t slash = path.find_last_of('/');
+  if (slash == std::string::npos) {
+    *dir = ".";
+    *name = path;
+  } else {
+    *dir = slash == 0 ? "/" : path.substr(0, slash);
+    *name = path.substr(slash + 1);
+  }
+}
+
+// Same comparison as uv_fs_poll, so that both modes report the same changes.
+bool StatEqual(const uv_stat_t* a, const uv_stat_t* b) {
+  return a->st_ctim.tv_nsec == b->st_ctim.tv_nsec &&
+         a->st_mtim.tv_nsec == b->st_mtim.tv_nsec &&
+         a->st_birthtim.tv_nsec == b->st_birthtim.tv_nsec &&
+         a->st_ctim.tv_sec == b->st_ctim.tv_sec &&
+         a->st_mtim.tv_sec == b->st_mtim.tv_sec &&
+         a->st_birthtim.tv_sec == b->st_birthtim.tv_sec &&
+         a->st_size == b->st_size &&
+         a->st_mode == b->st_mode &&
+         a->st_uid == b->st_uid &&
+         a->st_gid == b->st_gid &&
+         a->st_ino == b->st_ino &&
+         a->st_dev == b->st_dev &&
+         a->st_flags == b->st_flags &&
+         a->st_gen == b->st_gen;
+}
+
+// Events on the directory of a path only cover changes made through that
+// directory entry. Symbolic links whose target is elsewhere, and files with
+// other hard links, can change without the directory seeing it, so such
+// files are polled instead.
+bool IsLinkedElsewhere(const std::string& path, const uv_stat_t* statbuf) {
+  if (statbuf->st_nlink > 1)
+    return true;
+  uv_fs_t req;
+  const int err = uv_fs_lstat(nullptr, &req, path.c_str(), nullptr);
+  const bool is_link = err == 0 && S_ISLNK(req.statbuf.st_mode);
+  uv_fs_req_cleanup(&req);
+  return is_link;
+}
+
+// Whether the directory is reached through a symbolic link, e.g. the
+// `..data` link of a Kubernetes ConfigMap volume, which can be swapped
+// without the watched directory itself changing.
+bool HasLinkedDirectory(const std::string& dir) {
+  std::string absolute = dir;
+  if (dir[0] != '/') {
+    char cwd[PATH_MAX_BYTES];
+    size_t size = sizeof(cwd);
+    if (uv_cwd(cwd, &size) != 0)
+      return true;
+    absolute = std::string(cwd, size) + "/" + dir;
+  }
+  uv_fs_t req;
+  bool linked = true;
+  if (uv_fs_realpath(nullptr, &req, absolute.c_str(), nullptr) == 0)
+    linked = absolute != static_cast<const char*>(req.ptr);
+  uv_fs_req_cleanup(&req);
+  return linked;
+}
+
+}  // anonymous namespace
+
+// Watches a file through change notifications on its parent directory. libuv
+// shares one inotify instance per loop and one watch per directory between
+// all handles, so watching many files in the same directory is cheap. The
+// file is only stat'ed when an event names it, and is polled while it or its
+// directory is missing, or for good once CanUseEvents() finds that events
+// do not cover it. This is allocated separately because the stat request,
+// the check and the timer can outlive the StatWatcher.
+struct StatWatcher::NotifyContext {
+  StatWatcher* watcher;
+  uv_loop_t* loop;
+  std::string path;
+  std::string dir;
+  std::string name;
+  uint32_t interval;
+  uv_fs_t req;
+  uv_timer_t timer;
+  uv_stat_t statbuf{};
+  // Same meaning as busy_polling in uv_fs_poll: 0 before the first stat, 1
+  // after a successful one and the error code after a failed one.
+  int status = 0;
+  bool watching_dir = false;
+  // Set once CanUseEvents() has failed, after which the file is only polled.
+  bool polling = false;
+  bool checked = false;
+  bool check_active = false;
+  bool check_pending = false;
+  bool stat_active = false;
+  bool stat_pending = false;
+  bool timer_closed = false;
+};
+
+// Runs CanUseEvents() on the thread pool, since it accesses the file system
+// and would block the event loop on slow or hung mounts.
+class StatWatcher::NotifyCheck final : public ThreadPoolWork {
+ public:
+  NotifyCheck(Environment* env, NotifyContext* ctx)
+      : ThreadPoolWork(env), ctx_(ctx), path_(ctx->path) {}
+
+  void DoThreadPoolWork() override { usable_ = CanUseEvents(path_); }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<NotifyCheck> self(this);
+    OnCheck(ctx_, status == 0 && usable_);
+  }
+
+ private:
+  NotifyContext* const ctx_;
+  const std::string path_;
+  bool usable_ = false;
+};
+
 void StatWatcher::Initialize(Environment* env, Local<Object> target) {
   Isolate* isolate = env->isolate();
   HandleScope scope(env->isolate());
@@ -65,14 +207,20 @@ void StatWatcher::RegisterExternalReferences(
 
 StatWatcher::StatWatcher(fs::BindingData* binding_data,
                          Local<Object> wrap,
-                         bool use_bigint)
+                         bool use_bigint,
+                         bool use_events)
     : HandleWrap(binding_data->env(),
                  wrap,
                  reinterpret_cast<uv_handle_t*>(&watcher_),
                  AsyncWrap::PROVIDER_STATWATCHER),
       use_bigint_(use_bigint),
+      use_events_(use_events),
       binding_data_(binding_data) {
-  CHECK_EQ(0, uv_fs_poll_init(env()->event_loop(), &watcher_));
+  if (use_events_) {
+    CHECK_EQ(0, uv_fs_event_init(env()->event_loop(), &watcher_.event));
+  } else {
+    CHECK_EQ(0, uv_fs_poll_init(env()->event_loop(), &watcher_.poll));
+  }
 }
 
 
@@ -80,26 +228,279 @@ void StatWatcher::Callback(uv_fs_poll_t* handle,
                            int status,
                            const uv_stat_t* prev,
                            const uv_stat_t* curr) {
-  StatWatcher* wrap = ContainerOf(&StatWatcher::watcher_, handle);
-  Environment* env = wrap->env();
-  HandleScope handle_scope(env->isolate());
-  Context::Scope context_scope(env->context());
+  StatWatcher* wrap = static_cast<StatWatcher*>(handle->data);
+  wrap->OnChange(status, prev, curr);
+}
+
+
+void StatWatcher::OnChange(int status,
+                           const uv_stat_t* prev,
+                           const uv_stat_t* curr) {
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
 
   Local<Value> arr = fs::FillGlobalStatsArray(
-      wrap->binding_data_.get(), wrap->use_bigint_, curr);
-  USE(fs::FillGlobalStatsArray(
-      wrap->binding_data_.get(), wrap->use_bigint_, prev, true));
+      binding_data_.get(), use_bigint_, curr);
+  USE(fs::FillGlobalStatsArray(binding_data_.get(), use_bigint_, prev, true));
 
-  Local<Value> argv[2] = { Integer::New(env->isolate(), status), arr };
-  wrap->MakeCallback(env->onchange_string(), arraysize(argv), argv);
+  Local<Value> argv[2] = { Integer::New(env()->isolate(), status), arr };
+  MakeCallback(env()->onchange_string(), arraysize(argv), argv);
 }
 
 
+bool StatWatcher::CanWatchName(const std::string& path) {
+#ifdef __linux__
+  std::string dir;
+  std::string name;
+  SplitPath(path, &dir, &name);
+  return !name.empty() && name != "." && name != "..";
+#else
+  return false;
+#endif
+}
+
+
+bool StatWatcher::CanUseEvents(const std::string& path) {
+#ifdef __linux__
+  std::string dir;
+  std::string name;
+  SplitPath(path, &dir, &name);
+
+  struct statfs buf;
+  if (statfs(dir.c_str(), &buf) != 0)
+    return false;
+  const uint32_t type = static_cast<uint32_t>(buf.f_type);
+  for (const uint32_t polled : kPolledFilesystems) {
+    if (type == polled)
+      return false;
+  }
+
+  if (HasLinkedDirectory(dir))
+    return false;
+  // A file that does not exist yet is checked again once it shows up.
+  uv_fs_t req;
+  const int err = uv_fs_stat(nullptr, &req, path.c_str(), nullptr);
+  const uv_stat_t statbuf = req.statbuf;
+  uv_fs_req_cleanup(&req);
+  return err != 0 || !IsLinkedElsewhere(path, &statbuf);
+#else
+  return false;
+#endif
+}
+
+
+int StatWatcher::StartNotifying(const std::string& path, uint32_t interval) {
+  CHECK_NULL(notify_);
+  std::unique_ptr<NotifyContext> ctx = std::make_unique<NotifyContext>();
+  ctx->watcher = this;
+  ctx->loop = env()->event_loop();
+  ctx->path = path;
+  SplitPath(path, &ctx->dir, &ctx->name);
+  ctx->interval = interval > 0 ? interval : 1;
+
+  CHECK_EQ(0, uv_timer_init(ctx->loop, &ctx->timer));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&ctx->timer));
+
+  notify_ = ctx.release();
+  // The directory is watched, and the initial stat taken, once the check is
+  // done.
+  ScheduleCheck(notify_);
+  return 0;
+}
+
+
+void StatWatcher::ScheduleCheck(NotifyContext* ctx) {
+  if (ctx->check_active) {
+    ctx->check_pending = true;
+    return;
+  }
+  ctx->check_active = true;
+  (new NotifyCheck(ctx->watcher->env(), ctx))->ScheduleWork();
+}
+
+
+void StatWatcher::OnCheck(NotifyContext* ctx, bool usable) {
+  ctx->check_active = false;
+  StatWatcher* wrap = ctx->watcher;
+  if (wrap == nullptr || wrap->IsHandleClosing()) {
+    MaybeFreeContext(ctx);
+    return;
+  }
+  if (!usable)
+    ctx->polling = true;
+  if (ctx->check_pending && !ctx->polling) {
+    ctx->check_pending = false;
+    ScheduleCheck(ctx);
+    return;
+  }
+  ctx->check_pending = false;
+
+  if (!ctx->checked) {
+    ctx->checked = true;
+    WatchDirectory(ctx);
+    // Like uv_fs_poll, take an initial stat to compare later changes
+    // against.
+    ScheduleStat(ctx);
+  } else if (ctx->polling && ctx->watching_dir) {
+    WatchDirectory(ctx);
+    if (!ctx->stat_active)
+      CHECK_EQ(0, uv_timer_start(&ctx->timer, OnTimer, ctx->interval, 0));
+  }
+}
+
+
+void StatWatcher::OnFsEvent(uv_fs_event_t* handle,
+                            const char* filename,
+                            int events,
+                            int status) {
+  StatWatcher* wrap = static_cast<StatWatcher*>(handle->data);
+  NotifyContext* ctx = wrap->notify_;
+  if (ctx == nullptr || wrap->IsHandleClosing())
+    return;
+  // The directory watch is shared with other files in it, so ignore events
+  // that name a different file.
+  if (status == 0 && filename != nullptr && ctx->name != filename)
+    return;
+  ScheduleStat(ctx);
+}
+
+
+void StatWatcher::ScheduleStat(NotifyContext* ctx) {
+  // Events that arrive while a stat is in progress are coalesced into a
+  // single follow-up stat.
+  if (ctx->stat_active) {
+    ctx->stat_pending = true;
+    return;
+  }
+  uv_timer_stop(&ctx->timer);
+  ctx->stat_active = true;
+  CHECK_EQ(0, uv_fs_stat(ctx->loop, &ctx->req, ctx->path.c_str(), OnStat));
+}
+
+
+void StatWatcher::OnStat(uv_fs_t* req) {
+  NotifyContext* ctx = ContainerOf(&NotifyContext::req, req);
+  const int result = static_cast<int>(req->result);
+  const uv_stat_t statbuf = req->statbuf;
+  uv_fs_req_cleanup(req);
+  ctx->stat_active = false;
+
+  StatWatcher* wrap = ctx->watcher;
+  if (wrap == nullptr || wrap->IsHandleClosing()) {
+    MaybeFreeContext(ctx);
+    return;
+  }
+
+  // Report changes exactly like uv_fs_poll does, so that JS land cannot
+  // tell the two modes apart.
+  const uv_stat_t prev = ctx->statbuf;
+  const int prev_status = ctx->status;
+  bool check = false;
+  if (result != 0) {
+    ctx->status = result;
+    if (prev_status != result) {
+      static const uv_stat_t zero_statbuf = {};
+      wrap->OnChange(result, &prev, &zero_statbuf);
+    }
+  } else {
+    ctx->statbuf = statbuf;
+    ctx->status = 1;
+    // Files that have just appeared or been replaced may be links.
+    if (!ctx->polling) {
+      if (statbuf.st_nlink > 1)
+        ctx->polling = true;
+      else if (prev_status < 0 || prev.st_ino != statbuf.st_ino)
+        check = true;
+    }
+    // The file may have come back together with a recreated directory,
+    // whose old watch no longer reports anything.
+    if (ctx->polling || prev_status < 0 || !ctx->watching_dir)
+      WatchDirectory(ctx);
+    if (prev_status < 0 ||
+        (prev_status > 0 && !StatEqual(&prev, &statbuf))) {
+      wrap->OnChange(0, &prev, &statbuf);
+    }
+  }
+
+  if (wrap->IsHandleClosing())
+    return;
+  if (check)
+    ScheduleCheck(ctx);
+  if (ctx->stat_pending) {
+    ctx->stat_pending = false;
+    ScheduleStat(ctx);
+  } else if (ctx->status < 0 || !ctx->watching_dir) {
+    // Events cannot be relied upon while the file or its directory is
+    // missing, so poll until it is back, or for good if it is a link.
+    CHECK_EQ(0, uv_timer_start(&ctx->timer, OnTimer, ctx->interval, 0));
+  }
+}
+
+
+void StatWatcher::WatchDirectory(NotifyContext* ctx) {
+  uv_fs_event_t* handle = &ctx->watcher->watcher_.event;
+  uv_handle_t* timer = reinterpret_cast<uv_handle_t*>(&ctx->timer);
+  uv_fs_event_stop(handle);
+  ctx->watching_dir = !ctx->polling &&
+      uv_fs_event_start(handle, OnFsEvent, ctx->dir.c_str(), 0) == 0;
+  // A stopped handle does not keep the loop alive, so let the timer do it
+  // until the directory can be watched again.
+  if (!ctx->watching_dir && uv_has_ref(reinterpret_cast<uv_handle_t*>(handle)))
+    uv_ref(timer);
+  else
+    uv_unref(timer);
+}
+
+
+void StatWatcher::OnTimer(uv_timer_t* timer) {
+  NotifyContext* ctx = ContainerOf(&NotifyContext::timer, timer);
+  if (ctx->watcher == nullptr || ctx->watcher->IsHandleClosing())
+    return;
+  ScheduleStat(ctx);
+}
+
+
+void StatWatcher::OnClose() {
+  NotifyContext* ctx = notify_;
+  if (ctx == nullptr)
+    return;
+  notify_ = nullptr;
+  ctx->watcher = nullptr;
+  uv_close(reinterpret_cast<uv_handle_t*>(&ctx->timer), OnTimerClose);
+}
+
+
+void StatWatcher::OnTimerClose(uv_handle_t* handle) {
+  NotifyContext* ctx = ContainerOf(&NotifyContext::timer,
+                                   reinterpret_cast<uv_timer_t*>(handle));
+  ctx->timer_closed = true;
+  MaybeFreeContext(ctx);
+}
+
+
+void StatWatcher::MaybeFreeContext(NotifyContext* ctx) {
+  if (ctx->watcher == nullptr && ctx->timer_closed && !ctx->stat_active &&
+      !ctx->check_active) {
+    delete ctx;
+  }
+}
+
+
+// new StatWatcher(useBigint[, filename])
+// Files are watched through change notifications when `filename` is given
+// and names a file in a directory, and polled otherwise. Whether the
+// notifications can be relied upon for the file is checked once the watcher
+// has started.
 void StatWatcher::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
   fs::BindingData* binding_data =
       Environment::GetBindingData<fs::BindingData>(args);
-  new StatWatcher(binding_data, args.This(), args[0]->IsTrue());
+  bool use_events = false;
+  if (args[1]->IsString()) {
+    node::Utf8Value path(args.GetIsolate(), args[1]);
+    use_events = CanWatchName(path.ToString());
+  }
+  new StatWatcher(binding_data, args.This(), args[0]->IsTrue(), use_events);
 }
 
 // wrap.start(filename, interval)
@@ -116,9 +517,15 @@ void StatWatcher::Start(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[1]->IsUint32());
   const uint32_t interval = args[1].As<Uint32>()->Value();
 
-  // Note that uv_fs_poll_start does not return ENOENT, we are handling
-  // mostly memory errors here.
-  const int err = uv_fs_poll_start(&wrap->watcher_, Callback, *path, interval);
+  int err;
+  if (wrap->use_events_) {
+    // The file is polled if its directory cannot be watched.
+    err = wrap->StartNotifying(path.ToString(), interval);
+  } else {
+    // Note that uv_fs_poll_start does not return ENOENT, we are handling
+    // mostly memory errors here.
+    err = uv_fs_poll_start(&wrap->watcher_.poll, Callback, *path, interval);
+  }
   if (err != 0) {
     args.GetReturnValue().Set(err);
   }
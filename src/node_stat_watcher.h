@@ -29,6 +29,8 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <string>
+
 namespace node {
 namespace fs {
 class BindingData;
@@ -43,25 +45,58 @@ class StatWatcher : public HandleWrap {
   static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
  protected:
+  // When `use_events` is true the file is watched through change
+  // notifications on its parent directory instead of being polled.
   StatWatcher(fs::BindingData* binding_data,
               v8::Local<v8::Object> wrap,
-              bool use_bigint);
+              bool use_bigint,
+              bool use_events);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
 
+  void OnClose() override;
+
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(StatWatcher)
   SET_SELF_SIZE(StatWatcher)
 
  private:
+  struct NotifyContext;
+  class NotifyCheck;
+
   static void Callback(uv_fs_poll_t* handle,
                        int status,
                        const uv_stat_t* prev,
                        const uv_stat_t* curr);
+  void OnChange(int status, const uv_stat_t* prev, const uv_stat_t* curr);
+
+  // Whether `path` names a file whose directory can be watched.
+  static bool CanWatchName(const std::string& path);
+  // Whether changes to `path` are reliably reported by events on its
+  // directory. This accesses the file system and may block.
+  static bool CanUseEvents(const std::string& path);
+  int StartNotifying(const std::string& path, uint32_t interval);
+  static void ScheduleCheck(NotifyContext* ctx);
+  static void OnCheck(NotifyContext* ctx, bool usable);
+  static void OnFsEvent(uv_fs_event_t* handle,
+                        const char* filename,
+                        int events,
+                        int status);
+  static void OnStat(uv_fs_t* req);
+  static void OnTimer(uv_timer_t* timer);
+  static void OnTimerClose(uv_handle_t* handle);
+  static void ScheduleStat(NotifyContext* ctx);
+  static void WatchDirectory(NotifyContext* ctx);
+  static void MaybeFreeContext(NotifyContext* ctx);
 
-  uv_fs_poll_t watcher_;
+  union {
+    uv_fs_poll_t poll;
+    uv_fs_event_t event;
+  } watcher_;
+  NotifyContext* notify_ = nullptr;
   const bool use_bigint_;
+  const bool use_events_;
   BaseObjectPtr<fs::BindingData> binding_data_;
 };
 
@@ -24,6 +24,7 @@ using v8::Context;
 using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Isolate;
@@ -38,6 +39,7 @@ using v8::ResourceConstraints;
 using v8::SealHandleScope;
 using v8::String;
 using v8::TryCatch;
+using v8::Uint32;
 using v8::Value;
 
 namespace node {
@@ -45,6 +47,17 @@ namespace worker {
 
 constexpr double kMB = 1024 * 1024;
 
+// Workers are started from the same snapshot as their parent, which may be a
+// snapshot passed with --snapshot-blob. Otherwise, e.g. in embedders that
+// create their own isolates, they fall back to the embedded snapshot.
+static const SnapshotData* GetWorkerSnapshotData(Environment* env) {
+  const SnapshotData* snapshot_data = env->isolate_data()->snapshot_data();
+  if (snapshot_data == nullptr && per_process::cli_options->node_snapshot) {
+    snapshot_data = SnapshotBuilder::GetEmbeddedSnapshotData();
+  }
+  return snapshot_data;
+}
+
 Worker::Worker(Environment* env,
                Local<Object> wrap,
                const std::string& url,
@@ -177,11 +190,20 @@ class WorkerThreadData {
       isolate->SetStackLimit(w->stack_base_);
 
       HandleScope handle_scope(isolate);
-      isolate_data_.reset(CreateIsolateData(isolate,
-                                            &loop_,
-                                            w_->platform_,
-                                            allocator.get()));
+      // The per-isolate strings and templates are deserialized along with
+      // the isolate instead of being created again.
+      const SnapshotData* snapshot_data = w_->snapshot_data();
+      isolate_data_.reset(new IsolateData(
+          isolate,
+          &loop_,
+          w_->platform_,
+          allocator.get(),
+          snapshot_data == nullptr ? nullptr
+                                   : &(snapshot_data->isolate_data_info)));
       CHECK(isolate_data_);
+      if (snapshot_data != nullptr) {
+        isolate_data_->set_snapshot_data(snapshot_data);
+      }
       if (w_->per_isolate_opts_)
         isolate_data_->set_options(std::move(w_->per_isolate_opts_));
       isolate_data_->set_worker_context(w_);
@@ -241,6 +263,411 @@ class WorkerThreadData {
   friend class Worker;
 };
 
+// A thread of a WorkerIsolatePool. It creates an isolate and waits for a
+// Worker to run on it. When the Worker has stopped, the isolate is reused if
+// possible, and replaced with a new one otherwise.
+class PooledWorkerThread {
+ public:
+  explicit PooledWorkerThread(WorkerIsolatePool* pool) : pool_(pool) {}
+
+  int Start();
+  // Tells the thread to exit once it is not running a Worker anymore.
+  void Stop();
+  // These may only be called from the thread that owns the pool.
+  void Join();
+  bool joined() const { return joined_; }
+  bool is_running_worker();
+
+  // Hands `w` to the thread, which must have been taken from the idle
+  // threads of the pool.
+  void RunWorker(Worker* w);
+  // Blocks until the thread is done with `w`.
+  void WaitForWorker(Worker* w);
+
+ private:
+  void ThreadMain();
+  bool CreateIsolate();
+  void PrepareContext();
+  // Returns whether the isolate can be reused.
+  bool RunAssignedWorker(Worker* w);
+  void DisposeIsolate();
+
+  WorkerIsolatePool* const pool_;
+  uv_thread_t tid_;
+  bool joined_ = true;
+  uintptr_t stack_base_ = 0;
+
+  uv_loop_t loop_;
+  Isolate* isolate_ = nullptr;
+  DeleteFnPtr<IsolateData, FreeIsolateData> isolate_data_;
+  // A context that is created while the thread is idle.
+  Global<Context> context_;
+
+  // This mutex protects access to all variables listed below it.
+  Mutex mutex_;
+  ConditionVariable cond_;
+  Worker* worker_ = nullptr;
+  bool stopping_ = false;
+};
+
+int PooledWorkerThread::Start() {
+  uv_thread_options_t thread_options;
+  thread_options.flags = UV_THREAD_HAS_STACK_SIZE;
+  thread_options.stack_size = Worker::kDefaultStackSize;
+
+  int ret = uv_thread_create_ex(&tid_, &thread_options, [](void* arg) {
+    PooledWorkerThread* thread = static_cast<PooledWorkerThread*>(arg);
+    const uintptr_t stack_top = reinterpret_cast<uintptr_t>(&arg);
+    thread->stack_base_ =
+        stack_top - (Worker::kDefaultStackSize - Worker::kStackBufferSize);
+    thread->ThreadMain();
+  }, static_cast<void*>(this));
+  joined_ = ret != 0;
+  return ret;
+}
+
+void PooledWorkerThread::Stop() {
+  Mutex::ScopedLock lock(mutex_);
+  stopping_ = true;
+  cond_.Broadcast(lock);
+}
+
+void PooledWorkerThread::Join() {
+  if (joined_) return;
+  CHECK_EQ(uv_thread_join(&tid_), 0);
+  joined_ = true;
+}
+
+bool PooledWorkerThread::is_running_worker() {
+  Mutex::ScopedLock lock(mutex_);
+  return worker_ != nullptr;
+}
+
+void PooledWorkerThread::RunWorker(Worker* w) {
+  Mutex::ScopedLock lock(mutex_);
+  CHECK_NULL(worker_);
+  worker_ = w;
+  cond_.Broadcast(lock);
+}
+
+void PooledWorkerThread::WaitForWorker(Worker* w) {
+  Mutex::ScopedLock lock(mutex_);
+  while (worker_ == w)
+    cond_.Wait(lock);
+}
+
+void PooledWorkerThread::ThreadMain() {
+  while (CreateIsolate()) {
+    {
+      Mutex::ScopedLock lock(pool_->mutex_);
+      pool_->isolates_created_++;
+    }
+    bool reusable = true;
+    bool used = false;
+    while (reusable) {
+      pool_->AddIdleThread(this);
+      Worker* w;
+      {
+        Mutex::ScopedLock lock(mutex_);
+        while (worker_ == nullptr && !stopping_)
+          cond_.Wait(lock);
+        w = worker_;
+      }
+      if (w == nullptr) break;
+      {
+        Mutex::ScopedLock lock(pool_->mutex_);
+        pool_->workers_run_++;
+        if (used) pool_->isolates_reused_++;
+      }
+      used = true;
+      reusable = RunAssignedWorker(w);
+    }
+    DisposeIsolate();
+
+    Mutex::ScopedLock lock(mutex_);
+    if (stopping_) return;
+  }
+}
+
+bool PooledWorkerThread::CreateIsolate() {
+  if (uv_loop_init(&loop_) != 0) return false;
+  uv_loop_configure(&loop_, UV_METRICS_IDLE_TIME);
+
+  std::shared_ptr<ArrayBufferAllocator> allocator =
+      ArrayBufferAllocator::Create();
+  Isolate::CreateParams params;
+  SetIsolateCreateParamsForNode(&params);
+  params.array_buffer_allocator_shared = allocator;
+  params.constraints.set_stack_limit(reinterpret_cast<uint32_t*>(stack_base_));
+
+  const SnapshotData* snapshot_data = pool_->snapshot_data();
+  if (snapshot_data != nullptr) {
+    SnapshotBuilder::InitializeIsolateParams(snapshot_data, &params);
+  }
+
+  isolate_ = Isolate::Allocate();
+  if (isolate_ == nullptr) {
+    CheckedUvLoopClose(&loop_);
+    return false;
+  }
+
+  pool_->platform()->RegisterIsolate(isolate_, &loop_);
+  Isolate::Initialize(isolate_, params);
+  SetIsolateUpForNode(isolate_);
+
+  Locker locker(isolate_);
+  Isolate::Scope isolate_scope(isolate_);
+  isolate_->SetStackLimit(stack_base_);
+
+  HandleScope handle_scope(isolate_);
+  isolate_data_.reset(new IsolateData(
+      isolate_,
+      &loop_,
+      pool_->platform(),
+      allocator.get(),
+      snapshot_data == nullptr ? nullptr
+                               : &(snapshot_data->isolate_data_info)));
+  if (snapshot_data != nullptr) {
+    isolate_data_->set_snapshot_data(snapshot_data);
+  }
+  isolate_data_->max_young_gen_size =
+      params.constraints.max_young_generation_size_in_bytes();
+
+  PrepareContext();
+  return true;
+}
+
+void PooledWorkerThread::PrepareContext() {
+  TryCatch try_catch(isolate_);
+  Local<Context> context;
+  if (pool_->snapshot_data() != nullptr) {
+    if (!Context::FromSnapshot(isolate_, SnapshotData::kNodeBaseContextIndex)
+             .ToLocal(&context) ||
+        !InitializeContextRuntime(context).IsJust()) {
+      return;
+    }
+  } else {
+    context = NewContext(isolate_);
+    if (context.IsEmpty()) return;
+  }
+  context_.Reset(isolate_, context);
+}
+
+bool PooledWorkerThread::RunAssignedWorker(Worker* w) {
+  {
+    Locker locker(isolate_);
+    isolate_->AddNearHeapLimitCallback(Worker::NearHeapLimit, w);
+    isolate_data_->set_worker_context(w);
+    if (w->per_isolate_opts_)
+      isolate_data_->set_options(std::move(w->per_isolate_opts_));
+  }
+  {
+    Mutex::ScopedLock lock(w->mutex_);
+    w->stack_base_ = stack_base_;
+    w->isolate_ = isolate_;
+  }
+
+  w->RunEnvironment(isolate_data_.get(), &context_);
+
+  bool reusable;
+  {
+    Mutex::ScopedLock lock(w->mutex_);
+    w->isolate_ = nullptr;
+    // Only a Worker that exited cleanly leaves the isolate in a known state.
+    // After an uncaught exception, a non-zero process.exit() or running out
+    // of memory, a new isolate is created for the next Worker.
+    reusable = w->custom_error_ == nullptr &&
+               (w->exit_code_ == 0 || w->stop_requested_);
+  }
+  {
+    Locker locker(isolate_);
+    Isolate::Scope isolate_scope(isolate_);
+    isolate_->RemoveNearHeapLimitCallback(Worker::NearHeapLimit, 0);
+    isolate_->CancelTerminateExecution();
+    isolate_data_->set_worker_context(nullptr);
+    isolate_data_->set_options(std::make_shared<PerIsolateOptions>(
+        *per_process::cli_options->per_isolate));
+  }
+  // Handles that the Environment did not close, e.g. those of addons, would
+  // leak into the next Worker.
+  reusable = reusable && !uv_loop_alive(&loop_);
+
+  w->ScheduleJoinThread();
+  {
+    Mutex::ScopedLock lock(mutex_);
+    worker_ = nullptr;
+    cond_.Broadcast(lock);
+    if (stopping_) return false;
+  }
+  if (!reusable) return false;
+
+  // Collect what the Worker left behind, so that the next one starts with a
+  // small heap.
+  Locker locker(isolate_);
+  Isolate::Scope isolate_scope(isolate_);
+  HandleScope handle_scope(isolate_);
+  isolate_->LowMemoryNotification();
+  // The Worker may have stopped before it took the context.
+  if (context_.IsEmpty()) PrepareContext();
+  return true;
+}
+
+void PooledWorkerThread::DisposeIsolate() {
+  {
+    Locker locker(isolate_);
+    context_.Reset();
+  }
+  isolate_data_.reset();
+
+  bool platform_finished = false;
+  pool_->platform()->AddIsolateFinishedCallback(isolate_, [](void* data) {
+    *static_cast<bool*>(data) = true;
+  }, &platform_finished);
+  // See ~WorkerThreadData() for the order of these calls.
+  pool_->platform()->UnregisterIsolate(isolate_);
+  isolate_->Dispose();
+  isolate_ = nullptr;
+
+  // Wait until the platform has cleaned up all relevant resources.
+  while (!platform_finished) {
+    uv_run(&loop_, UV_RUN_ONCE);
+  }
+  CheckedUvLoopClose(&loop_);
+}
+
+WorkerIsolatePool::WorkerIsolatePool(Environment* env,
+                                     Local<Object> wrap,
+                                     const SnapshotData* snapshot_data)
+    : BaseObject(env, wrap),
+      platform_(env->isolate_data()->platform()),
+      snapshot_data_(snapshot_data) {
+  // The pool stays strong until it has been closed and all of its threads
+  // have been joined, so that the garbage collector never has to wait for
+  // threads to exit. See ReleaseIfDone().
+
+  Isolate::CreateParams params;
+  SetIsolateCreateParamsForNode(&params);
+  const ResourceConstraints& constraints = params.constraints;
+  resource_limits_[kMaxYoungGenerationSizeMb] =
+      constraints.max_young_generation_size_in_bytes() / kMB;
+  resource_limits_[kMaxOldGenerationSizeMb] =
+      constraints.max_old_generation_size_in_bytes() / kMB;
+  resource_limits_[kCodeRangeSizeMb] =
+      constraints.code_range_size_in_bytes() / kMB;
+  resource_limits_[kStackSizeMb] = Worker::kDefaultStackSize / kMB;
+
+  env->add_worker_isolate_pool(this);
+}
+
+WorkerIsolatePool::~WorkerIsolatePool() {
+  // This only has to wait for threads when the Environment is cleaned up.
+  // Otherwise, ReleaseIfDone() has joined all of them already.
+  Close();
+  for (const auto& thread : threads_) thread->Join();
+  env()->remove_worker_isolate_pool(this);
+}
+
+int WorkerIsolatePool::StartThreads(size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    auto thread = std::make_unique<PooledWorkerThread>(this);
+    int ret = thread->Start();
+    if (ret != 0) return ret;
+    threads_.emplace_back(std::move(thread));
+  }
+  return 0;
+}
+
+PooledWorkerThread* WorkerIsolatePool::TakeIdleThread() {
+  Mutex::ScopedLock lock(mutex_);
+  if (idle_threads_.empty()) return nullptr;
+  PooledWorkerThread* thread = idle_threads_.back();
+  idle_threads_.pop_back();
+  return thread;
+}
+
+void WorkerIsolatePool::AddIdleThread(PooledWorkerThread* thread) {
+  Mutex::ScopedLock lock(mutex_);
+  if (!closed_) idle_threads_.push_back(thread);
+}
+
+void WorkerIsolatePool::Close() {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    closed_ = true;
+    idle_threads_.clear();
+  }
+  for (const auto& thread : threads_) thread->Stop();
+  // Threads that are running a Worker are joined in OnWorkerDone(), so that
+  // this does not block until the Worker stops.
+  for (const auto& thread : threads_) {
+    if (!thread->is_running_worker()) thread->Join();
+  }
+}
+
+void WorkerIsolatePool::OnWorkerDone(PooledWorkerThread* thread) {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    if (!closed_) return;
+  }
+  // The thread has been told to stop and only disposes of its isolate now.
+  thread->Join();
+  ReleaseIfDone();
+}
+
+void WorkerIsolatePool::ReleaseIfDone() {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    if (!closed_) return;
+  }
+  for (const auto& thread : threads_) {
+    if (!thread->joined()) return;
+  }
+  MakeWeak();
+}
+
+void WorkerIsolatePool::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsUint32());
+
+  if (env->isolate_data()->platform() == nullptr) {
+    THROW_ERR_MISSING_PLATFORM_FOR_WORKER(env);
+    return;
+  }
+
+  WorkerIsolatePool* pool =
+      new WorkerIsolatePool(env, args.This(), GetWorkerSnapshotData(env));
+  int ret = pool->StartThreads(args[0].As<Uint32>()->Value());
+  if (ret != 0) {
+    pool->Close();
+    pool->ReleaseIfDone();
+    char err_buf[128];
+    uv_err_name_r(ret, err_buf, sizeof(err_buf));
+    THROW_ERR_WORKER_INIT_FAILED(env->isolate(), err_buf);
+  }
+}
+
+void WorkerIsolatePool::Close(const FunctionCallbackInfo<Value>& args) {
+  WorkerIsolatePool* pool;
+  ASSIGN_OR_RETURN_UNWRAP(&pool, args.This());
+  pool->Close();
+  pool->ReleaseIfDone();
+}
+
+void WorkerIsolatePool::GetStats(const FunctionCallbackInfo<Value>& args) {
+  WorkerIsolatePool* pool;
+  ASSIGN_OR_RETURN_UNWRAP(&pool, args.This());
+  Isolate* isolate = args.GetIsolate();
+  Mutex::ScopedLock lock(pool->mutex_);
+  Local<Value> stats[] = {
+      Number::New(isolate, static_cast<double>(pool->idle_threads_.size())),
+      Number::New(isolate, static_cast<double>(pool->isolates_created_)),
+      Number::New(isolate, static_cast<double>(pool->workers_run_)),
+      Number::New(isolate, static_cast<double>(pool->isolates_reused_)),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, stats, arraysize(stats)));
+}
+
 size_t Worker::NearHeapLimit(void* data, size_t current_heap_limit,
                              size_t initial_heap_limit) {
   Worker* worker = static_cast<Worker*>(data);
@@ -262,11 +689,6 @@ size_t Worker::NearHeapLimit(void* data, size_t current_heap_limit,
 }
 
 void Worker::Run() {
-  std::string name = "WorkerThread ";
-  name += std::to_string(thread_id_.id);
-  TRACE_EVENT_METADATA1(
-      "__metadata", "thread_name", "name",
-      TRACE_STR_COPY(name.c_str()));
   CHECK_NOT_NULL(platform_);
 
   Debug(this, "Creating isolate for worker with id %llu", thread_id_.id);
@@ -275,6 +697,19 @@ void Worker::Run() {
   if (isolate_ == nullptr) return;
   CHECK(data.loop_is_usable());
 
+  RunEnvironment(data.isolate_data_.get(), nullptr);
+
+  Debug(this, "Worker %llu thread stops", thread_id_.id);
+}
+
+void Worker::RunEnvironment(IsolateData* isolate_data,
+                            Global<Context>* prepared_context) {
+  std::string name = "WorkerThread ";
+  name += std::to_string(thread_id_.id);
+  TRACE_EVENT_METADATA1(
+      "__metadata", "thread_name", "name",
+      TRACE_STR_COPY(name.c_str()));
+
   Debug(this, "Starting worker with id %llu", thread_id_.id);
   {
     Locker locker(isolate_);
@@ -310,7 +745,10 @@ void Worker::Run() {
         // resource constraints, we need something in place to handle it,
         // though.
         TryCatch try_catch(isolate_);
-        if (snapshot_data_ != nullptr) {
+        if (prepared_context != nullptr && !prepared_context->IsEmpty()) {
+          context = prepared_context->Get(isolate_);
+          prepared_context->Reset();
+        } else if (snapshot_data_ != nullptr) {
           context = Context::FromSnapshot(isolate_,
                                           SnapshotData::kNodeBaseContextIndex)
                         .ToLocalChecked();
@@ -332,7 +770,7 @@ void Worker::Run() {
       Context::Scope context_scope(context);
       {
         env_.reset(CreateEnvironment(
-            data.isolate_data_.get(),
+            isolate_data,
             context,
             std::move(argv_),
             std::move(exec_argv_),
@@ -377,8 +815,6 @@ void Worker::Run() {
             thread_id_.id, exit_code_);
     }
   }
-
-  Debug(this, "Worker %llu thread stops", thread_id_.id);
 }
 
 bool Worker::CreateEnvMessagePort(Environment* env) {
@@ -402,10 +838,18 @@ bool Worker::CreateEnvMessagePort(Environment* env) {
 }
 
 void Worker::JoinThread() {
-  if (!tid_.has_value())
+  if (!has_thread())
     return;
-  CHECK_EQ(uv_thread_join(&tid_.value()), 0);
-  tid_.reset();
+  if (pooled_thread_ != nullptr) {
+    // The thread does not exit, but goes back to the pool.
+    pooled_thread_->WaitForWorker(this);
+    pool_->OnWorkerDone(pooled_thread_);
+    pooled_thread_ = nullptr;
+    pool_.reset();
+  } else {
+    CHECK_EQ(uv_thread_join(&tid_.value()), 0);
+    tid_.reset();
+  }
 
   env()->remove_sub_worker_context(this);
 
@@ -432,7 +876,7 @@ void Worker::JoinThread() {
     MakeCallback(env()->onexit_string(), arraysize(args), args);
   }
 
-  // If we get here, the tid_.has_value() condition at the top of the function
+  // If we get here, the has_thread() condition at the top of the function
   // implies that the thread was running. In that case, its final action will
   // be to schedule a callback on the parent thread which will delete this
   // object, so there's nothing more to do here.
@@ -443,7 +887,7 @@ Worker::~Worker() {
 
   CHECK(stopped_);
   CHECK_NULL(env_);
-  CHECK(!tid_.has_value());
+  CHECK(!has_thread());
 
   Debug(this, "Worker %llu destroyed", thread_id_.id);
 }
@@ -578,17 +1022,13 @@ void Worker::New(const FunctionCallbackInfo<Value>& args) {
     exec_argv_out = env->exec_argv();
   }
 
-  bool use_node_snapshot = per_process::cli_options->node_snapshot;
-  const SnapshotData* snapshot_data =
-      use_node_snapshot ? SnapshotBuilder::GetEmbeddedSnapshotData() : nullptr;
-
   Worker* worker = new Worker(env,
                               args.This(),
                               url,
                               per_isolate_opts,
                               std::move(exec_argv_out),
                               env_vars,
-                              snapshot_data);
+                              GetWorkerSnapshotData(env));
 
   CHECK(args[3]->IsFloat64Array());
   Local<Float64Array> limit_info = args[3].As<Float64Array>();
@@ -612,49 +1052,64 @@ void Worker::New(const FunctionCallbackInfo<Value>& args) {
 void Worker::StartThread(const FunctionCallbackInfo<Value>& args) {
   Worker* w;
   ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
+  WorkerIsolatePool* pool = nullptr;
+  if (args[0]->IsObject()) {
+    ASSIGN_OR_RETURN_UNWRAP(&pool, args[0].As<Object>());
+  }
   Mutex::ScopedLock lock(w->mutex_);
 
   w->stopped_ = false;
 
-  if (w->resource_limits_[kStackSizeMb] > 0) {
-    if (w->resource_limits_[kStackSizeMb] * kMB < kStackBufferSize) {
-      w->resource_limits_[kStackSizeMb] = kStackBufferSize / kMB;
-      w->stack_size_ = kStackBufferSize;
+  // Workers with custom resource limits need an isolate of their own.
+  bool use_pool = pool != nullptr && pool->env() == w->env() &&
+                  pool->snapshot_data() == w->snapshot_data_;
+  for (double limit : w->resource_limits_) {
+    if (limit > 0) use_pool = false;
+  }
+  PooledWorkerThread* pooled_thread =
+      use_pool ? pool->TakeIdleThread() : nullptr;
+
+  int ret = 0;
+  if (pooled_thread != nullptr) {
+    memcpy(w->resource_limits_,
+           pool->resource_limits(),
+           sizeof(w->resource_limits_));
+    w->pool_.reset(pool);
+    w->pooled_thread_ = pooled_thread;
+    pooled_thread->RunWorker(w);
+  } else {
+    if (w->resource_limits_[kStackSizeMb] > 0) {
+      if (w->resource_limits_[kStackSizeMb] * kMB < kStackBufferSize) {
+        w->resource_limits_[kStackSizeMb] = kStackBufferSize / kMB;
+        w->stack_size_ = kStackBufferSize;
+      } else {
+        w->stack_size_ =
+            static_cast<size_t>(w->resource_limits_[kStackSizeMb] * kMB);
+      }
     } else {
-      w->stack_size_ =
-          static_cast<size_t>(w->resource_limits_[kStackSizeMb] * kMB);
+      w->resource_limits_[kStackSizeMb] = w->stack_size_ / kMB;
     }
-  } else {
-    w->resource_limits_[kStackSizeMb] = w->stack_size_ / kMB;
-  }
-
-  uv_thread_options_t thread_options;
-  thread_options.flags = UV_THREAD_HAS_STACK_SIZE;
-  thread_options.stack_size = w->stack_size_;
-
-  uv_thread_t* tid = &w->tid_.emplace();  // Create uv_thread_t instance
-  int ret = uv_thread_create_ex(tid, &thread_options, [](void* arg) {
-    // XXX: This could become a std::unique_ptr, but that makes at least
-    // gcc 6.3 detect undefined behaviour when there shouldn't be any.
-    // gcc 7+ handles this well.
-    Worker* w = static_cast<Worker*>(arg);
-    const uintptr_t stack_top = reinterpret_cast<uintptr_t>(&arg);
-
-    // Leave a few kilobytes just to make sure we're within limits and have
-    // some space to do work in C++ land.
-    w->stack_base_ = stack_top - (w->stack_size_ - kStackBufferSize);
-
-    w->Run();
 
-    Mutex::ScopedLock lock(w->mutex_);
-    w->env()->SetImmediateThreadsafe(
-        [w = std::unique_ptr<Worker>(w)](Environment* env) {
-          if (w->has_ref_)
-            env->add_refs(-1);
-          w->JoinThread();
-          // implicitly delete w
-        });
-  }, static_cast<void*>(w));
+    uv_thread_options_t thread_options;
+    thread_options.flags = UV_THREAD_HAS_STACK_SIZE;
+    thread_options.stack_size = w->stack_size_;
+
+    uv_thread_t* tid = &w->tid_.emplace();  // Create uv_thread_t instance
+    ret = uv_thread_create_ex(tid, &thread_options, [](void* arg) {
+      // XXX: This could become a std::unique_ptr, but that makes at least
+      // gcc 6.3 detect undefined behaviour when there shouldn't be any.
+      // gcc 7+ handles this well.
+      Worker* w = static_cast<Worker*>(arg);
+      const uintptr_t stack_top = reinterpret_cast<uintptr_t>(&arg);
+
+      // Leave a few kilobytes just to make sure we're within limits and have
+      // some space to do work in C++ land.
+      w->stack_base_ = stack_top - (w->stack_size_ - kStackBufferSize);
+
+      w->Run();
+      w->ScheduleJoinThread();
+    }, static_cast<void*>(w));
+  }
 
   if (ret == 0) {
     // The object now owns the created thread and should not be garbage
@@ -679,18 +1134,33 @@ void Worker::StartThread(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+void Worker::ScheduleJoinThread() {
+  Mutex::ScopedLock lock(mutex_);
+  env()->SetImmediateThreadsafe(
+      [w = std::unique_ptr<Worker>(this)](Environment* env) {
+        if (w->has_ref_)
+          env->add_refs(-1);
+        w->JoinThread();
+        // implicitly delete w
+      });
+}
+
 void Worker::StopThread(const FunctionCallbackInfo<Value>& args) {
   Worker* w;
   ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
 
   Debug(w, "Worker %llu is getting stopped by parent", w->thread_id_.id);
+  {
+    Mutex::ScopedLock lock(w->mutex_);
+    w->stop_requested_ = true;
+  }
   w->Exit(1);
 }
 
 void Worker::Ref(const FunctionCallbackInfo<Value>& args) {
   Worker* w;
   ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
-  if (!w->has_ref_ && w->tid_.has_value()) {
+  if (!w->has_ref_ && w->has_thread()) {
     w->has_ref_ = true;
     w->env()->add_refs(1);
   }
@@ -705,7 +1175,7 @@ void Worker::HasRef(const FunctionCallbackInfo<Value>& args) {
 void Worker::Unref(const FunctionCallbackInfo<Value>& args) {
   Worker* w;
   ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
-  if (w->has_ref_ && w->tid_.has_value()) {
+  if (w->has_ref_ && w->has_thread()) {
     w->has_ref_ = false;
     w->env()->add_refs(-1);
   }
@@ -869,6 +1339,19 @@ void InitWorker(Local<Object> target,
     SetConstructorFunction(context, target, "Worker", w);
   }
 
+  {
+    Local<FunctionTemplate> p =
+        NewFunctionTemplate(isolate, WorkerIsolatePool::New);
+
+    p->InstanceTemplate()->SetInternalFieldCount(
+        WorkerIsolatePool::kInternalFieldCount);
+
+    SetProtoMethod(isolate, p, "close", WorkerIsolatePool::Close);
+    SetProtoMethod(isolate, p, "getStats", WorkerIsolatePool::GetStats);
+
+    SetConstructorFunction(context, target, "WorkerIsolatePool", p);
+  }
+
   {
     Local<FunctionTemplate> wst = NewFunctionTemplate(isolate, nullptr);
 
@@ -929,6 +1412,9 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(Worker::TakeHeapSnapshot);
   registry->Register(Worker::LoopIdleTime);
   registry->Register(Worker::LoopStartTime);
+  registry->Register(WorkerIsolatePool::New);
+  registry->Register(WorkerIsolatePool::Close);
+  registry->Register(WorkerIsolatePool::GetStats);
 }
 
 }  // anonymous namespace
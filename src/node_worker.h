@@ -14,6 +14,8 @@ struct SnapshotData;
 namespace worker {
 
 class WorkerThreadData;
+class PooledWorkerThread;
+class WorkerIsolatePool;
 
 enum ResourceLimits {
   kMaxYoungGenerationSizeMb,
@@ -76,7 +78,17 @@ class Worker : public AsyncWrap {
   static void LoopStartTime(const v8::FunctionCallbackInfo<v8::Value>& args);
 
  private:
+  // Create the Environment and run it until it stops. This is only called
+  // from the worker thread. `context` is used if it is not empty.
+  void RunEnvironment(IsolateData* isolate_data,
+                      v8::Global<v8::Context>* context);
   bool CreateEnvMessagePort(Environment* env);
+  // Called from the worker thread when it is done with this object. The
+  // parent thread then joins the thread and deletes this object.
+  void ScheduleJoinThread();
+  bool has_thread() const {
+    return tid_.has_value() || pooled_thread_ != nullptr;
+  }
   static size_t NearHeapLimit(void* data, size_t current_heap_limit,
                               size_t initial_heap_limit);
 
@@ -96,6 +108,8 @@ class Worker : public AsyncWrap {
   const char* custom_error_ = nullptr;
   std::string custom_error_str_;
   int exit_code_ = 0;
+  // Set when the parent thread stops the worker through terminate().
+  bool stop_requested_ = false;
   ThreadId thread_id_;
   uintptr_t stack_base_ = 0;
 
@@ -104,7 +118,8 @@ class Worker : public AsyncWrap {
   void UpdateResourceConstraints(v8::ResourceConstraints* constraints);
 
   // Full size of the thread's stack.
-  size_t stack_size_ = 4 * 1024 * 1024;
+  static constexpr size_t kDefaultStackSize = 4 * 1024 * 1024;
+  size_t stack_size_ = kDefaultStackSize;
   // Stack buffer size that is not available to the JS engine.
   static constexpr size_t kStackBufferSize = 192 * 1024;
 
@@ -127,7 +142,72 @@ class Worker : public AsyncWrap {
   Environment* env_ = nullptr;
 
   const SnapshotData* snapshot_data_ = nullptr;
+
+  // Set while the worker runs on a thread of a WorkerIsolatePool.
+  BaseObjectPtr<WorkerIsolatePool> pool_;
+  PooledWorkerThread* pooled_thread_ = nullptr;
+
   friend class WorkerThreadData;
+  friend class PooledWorkerThread;
+  friend class WorkerIsolatePool;
+};
+
+// Keeps a number of threads, each with an isolate that has been created from
+// the snapshot ahead of time, so that Workers started with the pool do not
+// have to create a thread and an isolate first. After a Worker has exited
+// with code 0 or has been terminated, its isolate is reused for the next one,
+// unless the Worker left something behind in its event loop.
+class WorkerIsolatePool : public BaseObject {
+ public:
+  WorkerIsolatePool(Environment* env,
+                    v8::Local<v8::Object> wrap,
+                    const SnapshotData* snapshot_data);
+  ~WorkerIsolatePool() override;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Close(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetStats(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Returns an idle thread, or nullptr if there is none.
+  PooledWorkerThread* TakeIdleThread();
+  // Stops the threads. Threads that are running a Worker stop once it is
+  // done.
+  void Close();
+  // Called on the thread that owns the pool once `thread` is done with the
+  // Worker that ran on it.
+  void OnWorkerDone(PooledWorkerThread* thread);
+  // Makes the pool weak once it has been closed and all of its threads have
+  // been joined.
+  void ReleaseIfDone();
+
+  const SnapshotData* snapshot_data() const { return snapshot_data_; }
+  MultiIsolatePlatform* platform() const { return platform_; }
+  const double* resource_limits() const { return resource_limits_; }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(WorkerIsolatePool)
+  SET_SELF_SIZE(WorkerIsolatePool)
+
+ private:
+  int StartThreads(size_t count);
+  void AddIdleThread(PooledWorkerThread* thread);
+
+  MultiIsolatePlatform* const platform_;
+  const SnapshotData* const snapshot_data_;
+  // The resource limits of the isolates, as reported by Workers.
+  double resource_limits_[kTotalResourceLimitCount];
+  std::vector<std::unique_ptr<PooledWorkerThread>> threads_;
+
+  // This mutex protects access to all variables listed below it.
+  Mutex mutex_;
+  std::vector<PooledWorkerThread*> idle_threads_;
+  bool closed_ = false;
+  // Reported by GetStats(), mostly for tests.
+  uint64_t isolates_created_ = 0;
+  uint64_t workers_run_ = 0;
+  uint64_t isolates_reused_ = 0;
+
+  friend class PooledWorkerThread;
 };
 
 template <typename Fn>
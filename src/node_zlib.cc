@@ -25,6 +25,7 @@
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "histogram-inl.h"
 #include "node_external_reference.h"
 #include "threadpoolwork-inl.h"
 #include "util-inl.h"
@@ -41,10 +42,14 @@
 #include <cstdlib>
 #include <cstring>
 #include <atomic>
+#include <type_traits>
 
 namespace node {
 
+using v8::Array;
 using v8::ArrayBuffer;
+using v8::ArrayBufferView;
+using v8::BackingStore;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -54,8 +59,11 @@ using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
+using v8::Number;
 using v8::Object;
+using v8::Uint32;
 using v8::Uint32Array;
+using v8::Undefined;
 using v8::Value;
 
 namespace {
@@ -127,6 +135,117 @@ struct CompressionError {
   inline bool IsError() const { return code != nullptr; }
 };
 
+// Deflate states of closed streams are kept around per Environment, so that
+// new streams with identical parameters can skip deflateInit2() and the
+// roughly 256 KiB of allocations that come with it. States are reset before
+// they are parked, so a state taken from the pool behaves like a fresh one.
+class ZlibContextPool final : public MemoryRetainer {
+ public:
+  struct Key {
+    node_zlib_mode mode;
+    int level;
+    int window_bits;
+    int mem_level;
+    int strategy;
+
+    bool operator==(const Key& other) const {
+      return mode == other.mode &&
+             level == other.level &&
+             window_bits == other.window_bits &&
+             mem_level == other.mem_level &&
+             strategy == other.strategy;
+    }
+  };
+
+  static constexpr size_t kMaxEntries = 16;
+
+  explicit ZlibContextPool(Isolate* isolate) : isolate_(isolate) {}
+  ~ZlibContextPool() override;
+
+  // Returns a parked state and the amount of memory it holds, or nullptr.
+  std::unique_ptr<z_stream> Acquire(const Key& key, size_t* memory);
+  // Takes ownership of a reset state and |memory|, the amount of memory
+  // allocated for it that has already been reported to V8.
+  void Release(const Key& key, std::unique_ptr<z_stream> strm, size_t memory);
+
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+  size_t evictions() const { return evictions_; }
+  size_t size() const { return entries_.size(); }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("parked_states", memory_);
+  }
+
+  SET_MEMORY_INFO_NAME(ZlibContextPool)
+  SET_SELF_SIZE(ZlibContextPool)
+
+  ZlibContextPool(const ZlibContextPool&) = delete;
+  ZlibContextPool& operator=(const ZlibContextPool&) = delete;
+
+ private:
+  struct Entry {
+    Key key;
+    std::unique_ptr<z_stream> strm;
+    size_t memory;
+  };
+
+  void Evict(Entry* entry);
+  static void FreeParked(void* data, void* pointer);
+
+  Isolate* isolate_;
+  std::vector<Entry> entries_;  // Least recently parked first.
+  size_t memory_ = 0;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+  size_t evictions_ = 0;
+};
+
+// Dictionary contents that can be shared between zlib streams without
+// copying. Dictionaries created through zlib.createDictionary() also keep
+// deflate states that have already been primed with them, so that new
+// streams only need to copy such a state instead of hashing the whole
+// dictionary again.
+class ZlibDictionary final : public MemoryRetainer {
+ public:
+  ZlibDictionary(std::vector<unsigned char>&& data, bool cache_primed_states)
+      : data_(std::move(data)), cache_primed_states_(cache_primed_states) {}
+  ~ZlibDictionary() override;
+
+  const unsigned char* data() const { return data_.data(); }
+  size_t size() const { return data_.size(); }
+  bool empty() const { return data_.empty(); }
+  bool caches_primed_states() const { return cache_primed_states_; }
+
+  // Initializes |dest| as a copy of a deflate state with the parameters in
+  // |key| that has been primed with this dictionary. May be called from any
+  // thread. Returns false if the caller needs to set up |dest| itself.
+  bool CopyPrimedState(const ZlibContextPool::Key& key, z_stream* dest);
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("data", data_);
+  }
+
+  SET_MEMORY_INFO_NAME(ZlibDictionary)
+  SET_SELF_SIZE(ZlibDictionary)
+
+  ZlibDictionary(const ZlibDictionary&) = delete;
+  ZlibDictionary& operator=(const ZlibDictionary&) = delete;
+
+ private:
+  struct PrimedState {
+    ZlibContextPool::Key key;
+    std::unique_ptr<z_stream> strm;
+  };
+
+  static constexpr size_t kMaxPrimedStates = 4;
+
+  const std::vector<unsigned char> data_;
+  const bool cache_primed_states_;
+  Mutex mutex_;  // Protects primed_states_.
+  std::vector<PrimedState> primed_states_;
+};
+
 class ZlibContext final : public MemoryRetainer {
  public:
   ZlibContext() = default;
@@ -143,10 +262,15 @@ class ZlibContext final : public MemoryRetainer {
 
   // Zlib-specific:
   void Init(int level, int window_bits, int mem_level, int strategy,
-            std::vector<unsigned char>&& dictionary);
+            std::shared_ptr<ZlibDictionary> dictionary);
   void SetAllocationFunctions(alloc_func alloc, free_func free, void* opaque);
   CompressionError SetParams(int level, int strategy);
 
+  // Pooling of deflate states, main thread only:
+  bool AcquireFromPool(ZlibContextPool* pool, size_t* memory);
+  bool PrepareForPool();
+  void ReleaseToPool(ZlibContextPool* pool, size_t memory);
+
   SET_MEMORY_INFO_NAME(ZlibContext)
   SET_SELF_SIZE(ZlibContext)
 
@@ -161,6 +285,10 @@ class ZlibContext final : public MemoryRetainer {
   CompressionError ErrorForMessage(const char* message) const;
   CompressionError SetDictionary();
   bool InitZlib();
+  bool IsPoolable() const;
+  ZlibContextPool::Key pool_key() const {
+    return { mode_, level_, window_bits_, mem_level_, strategy_ };
+  }
 
   Mutex mutex_;  // Protects zlib_init_done_.
   bool zlib_init_done_ = false;
@@ -172,9 +300,9 @@ class ZlibContext final : public MemoryRetainer {
   int strategy_ = 0;
   int window_bits_ = 0;
   unsigned int gzip_id_bytes_read_ = 0;
-  std::vector<unsigned char> dictionary_;
+  std::shared_ptr<ZlibDictionary> dictionary_;
 
-  z_stream strm_;
+  std::unique_ptr<z_stream> strm_ = std::make_unique<z_stream>();
 };
 
 // Brotli has different data types for compression and decompression streams,
@@ -248,6 +376,71 @@ class BrotliDecoderContext final : public BrotliContext {
   DeleteFnPtr<BrotliDecoderState, BrotliDecoderDestroyInstance> state_;
 };
 
+// The JS handle for a ZlibDictionary, see zlib.createDictionary().
+class ZlibDictionaryWrap final : public BaseObject {
+ public:
+  ZlibDictionaryWrap(Environment* env,
+                     Local<Object> wrap,
+                     std::shared_ptr<ZlibDictionary> dictionary)
+      : BaseObject(env, wrap), dictionary_(std::move(dictionary)) {
+    MakeWeak();
+  }
+
+  // new ZlibDictionary(data)
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args.IsConstructCall());
+    CHECK(args[0]->IsArrayBufferView());
+    ArrayBufferViewContents<unsigned char> data(args[0]);
+    new ZlibDictionaryWrap(
+        env,
+        args.This(),
+        std::make_shared<ZlibDictionary>(
+            std::vector<unsigned char>(data.data(),
+                                       data.data() + data.length()),
+            true));
+  }
+
+  const std::shared_ptr<ZlibDictionary>& dictionary() const {
+    return dictionary_;
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("dictionary", dictionary_);
+  }
+
+  SET_MEMORY_INFO_NAME(ZlibDictionaryWrap)
+  SET_SELF_SIZE(ZlibDictionaryWrap)
+
+ private:
+  std::shared_ptr<ZlibDictionary> dictionary_;
+};
+
+class BindingData : public BaseObject {
+ public:
+  BindingData(Environment* env, Local<Object> obj)
+      : BaseObject(env, obj),
+        context_pool(env->isolate()),
+        inline_work(std::make_shared<Histogram>(Histogram::Options {})),
+        offloaded_work(std::make_shared<Histogram>(Histogram::Options {})) {}
+
+  static constexpr FastStringKey type_name { "zlib" };
+
+  ZlibContextPool context_pool;
+  // Time spent on asynchronous writes, in nanoseconds, depending on whether
+  // they were processed on the main thread or on the thread pool.
+  std::shared_ptr<Histogram> inline_work;
+  std::shared_ptr<Histogram> offloaded_work;
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("context_pool", context_pool);
+    tracker->TrackField("inline_work", inline_work);
+    tracker->TrackField("offloaded_work", offloaded_work);
+  }
+  SET_SELF_SIZE(BindingData)
+  SET_MEMORY_INFO_NAME(BindingData)
+};
+
 template <typename CompressionContext>
 class CompressionStream : public AsyncWrap, public ThreadPoolWork {
  public:
@@ -257,10 +450,11 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     kInternalFieldCount
   };
 
-  CompressionStream(Environment* env, Local<Object> wrap)
-      : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
-        ThreadPoolWork(env),
-        write_result_(nullptr) {
+  CompressionStream(BindingData* binding_data, Local<Object> wrap)
+      : AsyncWrap(binding_data->env(), wrap, AsyncWrap::PROVIDER_ZLIB),
+        ThreadPoolWork(binding_data->env()),
+        write_result_(nullptr),
+        binding_data_(binding_data) {
     MakeWeak();
   }
 
@@ -374,6 +568,21 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     }
 
     // async version
+    work_length_ = in_len;
+    work_time_ = 0;
+    work_is_sample_ = IsInlineCandidate(flush);
+    if (work_is_sample_ && ShouldRunInline(in_len)) {
+      // Small writes are processed right away, which is cheaper than the
+      // round trip through the thread pool. The callback is still deferred,
+      // so that write() behaves the same either way.
+      DoThreadPoolWork();
+      RecordWork(binding_data_->inline_work.get());
+      AsyncWrap::env()->SetImmediate(
+          [self = BaseObjectPtr<CompressionStream>(this)](Environment* env) {
+            self->AfterThreadPoolWork(kCompletedInline);
+          });
+      return;
+    }
     ScheduleWork();
   }
 
@@ -386,7 +595,9 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
   // for a single write() call, until all of the input bytes have
   // been consumed.
   void DoThreadPoolWork() override {
+    uint64_t start = uv_hrtime();
     ctx_.DoThreadPoolWork();
+    work_time_ += uv_hrtime() - start;
   }
 
 
@@ -411,6 +622,11 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
       return;
     }
 
+    if (status == kCompletedInline)
+      status = 0;
+    else if (status == 0)
+      RecordWork(binding_data_->offloaded_work.get());
+
     CHECK_EQ(status, 0);
 
     Environment* env = AsyncWrap::env();
@@ -468,6 +684,22 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
 
  protected:
   CompressionContext* context() { return &ctx_; }
+  BindingData* binding_data() const { return binding_data_.get(); }
+  bool write_in_progress() const { return write_in_progress_; }
+
+  // Hands over all memory allocated by the compression library so far, e.g.
+  // when its state is moved into a pool. The memory stays reported to V8.
+  size_t TakeZlibMemory() {
+    AdjustAmountOfExternalAllocatedMemory();
+    size_t memory = zlib_memory_;
+    zlib_memory_ = 0;
+    return memory;
+  }
+
+  // Counterpart to TakeZlibMemory().
+  void AdoptZlibMemory(size_t memory) {
+    zlib_memory_ += memory;
+  }
 
   void InitStream(uint32_t* write_result, Local<Function> write_js_callback) {
     write_result_ = write_result;
@@ -527,6 +759,44 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
   };
 
  private:
+  // Asynchronous writes with at most this much input may be processed on the
+  // main thread, as long as that is expected to take less than
+  // kMaxInlineWorkTime nanoseconds, judging by earlier writes to the stream.
+  static constexpr uint32_t kMaxInlineWriteLength = 16 * 1024;
+  static constexpr uint64_t kMaxInlineWorkTime = 50 * 1000;
+  // Very small writes are assumed to cost at least this much.
+  static constexpr uint32_t kMinWorkLength = 1024;
+  // Passed to AfterThreadPoolWork() for writes that did not use the pool.
+  static constexpr int kCompletedInline = 1;
+
+  // How long a write takes is only predictable from its input length for
+  // zlib writes without a flush. Flushing or finishing a stream compresses
+  // whatever earlier writes left buffered, and Brotli may do so whenever it
+  // likes, so those writes always go to the thread pool and are not used
+  // for the estimate either.
+  static bool IsInlineCandidate(uint32_t flush) {
+    return std::is_same_v<CompressionContext, ZlibContext> &&
+           flush == Z_NO_FLUSH;
+  }
+
+  bool ShouldRunInline(uint32_t in_len) const {
+    if (in_len > kMaxInlineWriteLength) return false;
+    // Without an estimate yet, try the first small write inline; how long it
+    // takes decides about the next one.
+    if (work_cost_ < 0) return true;
+    return work_cost_ * std::max(in_len, kMinWorkLength) <= kMaxInlineWorkTime;
+  }
+
+  // Records the time spent on the last write and updates the moving average
+  // of the time per input byte that ShouldRunInline() uses.
+  void RecordWork(Histogram* histogram) {
+    histogram->Record(std::max<int64_t>(work_time_, 1));
+    if (!work_is_sample_) return;
+    double cost = static_cast<double>(work_time_) /
+                  std::max(work_length_, kMinWorkLength);
+    work_cost_ = work_cost_ < 0 ? cost : 0.75 * work_cost_ + 0.25 * cost;
+  }
+
   void Ref() {
     if (++refs_ == 1) {
       ClearWeak();
@@ -548,23 +818,45 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
   uint32_t* write_result_ = nullptr;
   std::atomic<ssize_t> unreported_allocations_{0};
   size_t zlib_memory_ = 0;
+  BaseObjectPtr<BindingData> binding_data_;
+  uint32_t work_length_ = 0;
+  uint64_t work_time_ = 0;
+  bool work_is_sample_ = false;
+  double work_cost_ = -1;
 
   CompressionContext ctx_;
 };
 
 class ZlibStream final : public CompressionStream<ZlibContext> {
  public:
-  ZlibStream(Environment* env, Local<Object> wrap, node_zlib_mode mode)
-    : CompressionStream(env, wrap) {
+  ZlibStream(BindingData* binding_data,
+             Local<Object> wrap,
+             node_zlib_mode mode)
+    : CompressionStream(binding_data, wrap) {
     context()->SetMode(mode);
   }
 
   static void New(const FunctionCallbackInfo<Value>& args) {
-    Environment* env = Environment::GetCurrent(args);
+    BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
     CHECK(args[0]->IsInt32());
     node_zlib_mode mode =
         static_cast<node_zlib_mode>(args[0].As<Int32>()->Value());
-    new ZlibStream(env, args.This(), mode);
+    new ZlibStream(binding_data, args.This(), mode);
+  }
+
+  // Parks the deflate state in the per-Environment pool before closing, if
+  // it can be reused. Closing while a write is in progress is deferred by
+  // CompressionStream::Close(), so the state is released normally then.
+  static void Close(const FunctionCallbackInfo<Value>& args) {
+    ZlibStream* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+    if (!wrap->write_in_progress() && wrap->context()->PrepareForPool()) {
+      AllocScope alloc_scope(wrap);
+      wrap->context()->ReleaseToPool(&wrap->binding_data()->context_pool,
+                                     wrap->TakeZlibMemory());
+    }
+    wrap->CompressionStream::Close();
   }
 
   // just pull the ints out of the args and call the other Init
@@ -611,13 +903,17 @@ class ZlibStream final : public CompressionStream<ZlibContext> {
     CHECK(args[5]->IsFunction());
     Local<Function> write_js_callback = args[5].As<Function>();
 
-    std::vector<unsigned char> dictionary;
+    std::shared_ptr<ZlibDictionary> dictionary;
     if (Buffer::HasInstance(args[6])) {
       unsigned char* data =
           reinterpret_cast<unsigned char*>(Buffer::Data(args[6]));
-      dictionary = std::vector<unsigned char>(
-          data,
-          data + Buffer::Length(args[6]));
+      dictionary = std::make_shared<ZlibDictionary>(
+          std::vector<unsigned char>(data, data + Buffer::Length(args[6])),
+          false);
+    } else if (args[6]->IsObject()) {
+      ZlibDictionaryWrap* dictionary_wrap;
+      ASSIGN_OR_RETURN_UNWRAP(&dictionary_wrap, args[6]);
+      dictionary = dictionary_wrap->dictionary();
     }
 
     wrap->InitStream(write_result, write_js_callback);
@@ -627,6 +923,13 @@ class ZlibStream final : public CompressionStream<ZlibContext> {
         AllocForZlib, FreeForZlib, static_cast<CompressionStream*>(wrap));
     wrap->context()->Init(level, window_bits, mem_level, strategy,
                           std::move(dictionary));
+
+    // Streams with a registered dictionary copy a primed state instead.
+    size_t pooled_memory;
+    if (wrap->context()->AcquireFromPool(&wrap->binding_data()->context_pool,
+                                         &pooled_memory)) {
+      wrap->AdoptZlibMemory(pooled_memory);
+    }
   }
 
   static void Params(const FunctionCallbackInfo<Value>& args) {
@@ -653,10 +956,10 @@ template <typename CompressionContext>
 class BrotliCompressionStream final :
   public CompressionStream<CompressionContext> {
  public:
-  BrotliCompressionStream(Environment* env,
+  BrotliCompressionStream(BindingData* binding_data,
                           Local<Object> wrap,
                           node_zlib_mode mode)
-    : CompressionStream<CompressionContext>(env, wrap) {
+    : CompressionStream<CompressionContext>(binding_data, wrap) {
     context()->SetMode(mode);
   }
 
@@ -666,11 +969,11 @@ class BrotliCompressionStream final :
   typedef typename CompressionStream<CompressionContext>::AllocScope AllocScope;
 
   static void New(const FunctionCallbackInfo<Value>& args) {
-    Environment* env = Environment::GetCurrent(args);
+    BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
     CHECK(args[0]->IsInt32());
     node_zlib_mode mode =
         static_cast<node_zlib_mode>(args[0].As<Int32>()->Value());
-    new BrotliCompressionStream(env, args.This(), mode);
+    new BrotliCompressionStream(binding_data, args.This(), mode);
   }
 
   static void Init(const FunctionCallbackInfo<Value>& args) {
@@ -729,11 +1032,191 @@ class BrotliCompressionStream final :
 using BrotliEncoderStream = BrotliCompressionStream<BrotliEncoderContext>;
 using BrotliDecoderStream = BrotliCompressionStream<BrotliDecoderContext>;
 
+// Compresses a single block of a parallel gzip stream on the thread pool.
+// Every block is deflated independently, primed with the tail of the
+// preceding block as its dictionary, and ended with a sync flush (or, for
+// the last block, a final block). Concatenating the outputs in order yields
+// one valid raw deflate stream; the gzip header and trailer are written
+// from JS, which also combines the per-block CRCs.
+class DeflateBlockJob final : public AsyncWrap, public ThreadPoolWork {
+ public:
+  DeflateBlockJob(Environment* env,
+                  Local<Object> wrap,
+                  int level,
+                  int window_bits,
+                  int mem_level,
+                  int strategy)
+      : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
+        ThreadPoolWork(env),
+        level_(level),
+        window_bits_(window_bits),
+        mem_level_(mem_level),
+        strategy_(strategy) {}
+
+  // new DeflateBlockJob(level, windowBits, memLevel, strategy)
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args.IsConstructCall());
+    CHECK(args[0]->IsInt32());
+    CHECK(args[1]->IsInt32());
+    CHECK(args[2]->IsInt32());
+    CHECK(args[3]->IsInt32());
+
+    int level = args[0].As<Int32>()->Value();
+    int window_bits = args[1].As<Int32>()->Value();
+    int mem_level = args[2].As<Int32>()->Value();
+    int strategy = args[3].As<Int32>()->Value();
+    CHECK(level >= Z_MIN_LEVEL && level <= Z_MAX_LEVEL);
+    CHECK(window_bits >= Z_MIN_WINDOWBITS && window_bits <= Z_MAX_WINDOWBITS);
+    CHECK(mem_level >= Z_MIN_MEMLEVEL && mem_level <= Z_MAX_MEMLEVEL);
+
+    new DeflateBlockJob(env, args.This(), level, window_bits, mem_level,
+                        strategy);
+  }
+
+  // run(input, dictionary, last)
+  static void Run(const FunctionCallbackInfo<Value>& args) {
+    DeflateBlockJob* job;
+    ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+    CHECK(args[0]->IsArrayBufferView());
+    CHECK(args[1]->IsArrayBufferView() || args[1]->IsNull());
+    CHECK(args[2]->IsBoolean());
+
+    job->input_ = BlockData(args[0].As<ArrayBufferView>());
+    if (args[1]->IsArrayBufferView())
+      job->dictionary_ = BlockData(args[1].As<ArrayBufferView>());
+    job->last_ = args[2]->IsTrue();
+    job->ScheduleWork();
+  }
+
+  void DoThreadPoolWork() override {
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    err_ = deflateInit2(&strm, level_, Z_DEFLATED, -window_bits_, mem_level_,
+                        strategy_);
+    if (err_ != Z_OK) return;
+
+    if (dictionary_.length > 0) {
+      err_ = deflateSetDictionary(&strm, dictionary_.data(),
+                                  dictionary_.length);
+    }
+
+    if (err_ == Z_OK) {
+      // deflateBound() depends on the parameters of the stream, e.g. small
+      // memLevels can expand incompressible data by more than compressBound()
+      // allows for. It does not include the sync flush marker, which the
+      // extra bytes leave room for.
+      output_capacity_ = deflateBound(&strm, input_.length) + 16;
+      output_.reset(new Bytef[output_capacity_]);
+      strm.next_in = const_cast<Bytef*>(input_.data());
+      strm.avail_in = input_.length;
+      strm.next_out = output_.get();
+      strm.avail_out = output_capacity_;
+      err_ = deflate(&strm, last_ ? Z_FINISH : Z_SYNC_FLUSH);
+      // The output buffer is sized up front, so all input has to have been
+      // consumed in a single call.
+      if (strm.avail_in != 0 || (last_ && err_ != Z_STREAM_END))
+        err_ = Z_BUF_ERROR;
+      else if (err_ == Z_STREAM_END)
+        err_ = Z_OK;
+      output_length_ = output_capacity_ - strm.avail_out;
+      crc_ = crc32(0, input_.data(), input_.length);
+    }
+
+    deflateEnd(&strm);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    Environment* env = AsyncWrap::env();
+    CHECK(status == 0 || status == UV_ECANCELED);
+    std::unique_ptr<DeflateBlockJob> ptr(this);
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+
+    if (status == UV_ECANCELED) return;
+
+    Local<Value> args[3];
+    if (err_ != Z_OK) {
+      args[0] = OneByteString(env->isolate(), ZlibStrerror(err_));
+      args[1] = Undefined(env->isolate());
+      args[2] = Undefined(env->isolate());
+    } else {
+      std::unique_ptr<BackingStore> store = ArrayBuffer::NewBackingStore(
+          output_.release(),
+          output_length_,
+          [](void* data, size_t length, void* deleter_data) {
+            delete[] static_cast<Bytef*>(data);
+          },
+          nullptr);
+      Local<ArrayBuffer> ab = ArrayBuffer::New(env->isolate(),
+                                               std::move(store));
+      args[0] = Undefined(env->isolate());
+      if (!Buffer::New(env, ab, 0, output_length_).ToLocal(&args[1]))
+        return;
+      args[2] = Integer::NewFromUnsigned(env->isolate(), crc_);
+    }
+
+    ptr->MakeCallback(env->ondone_string(), arraysize(args), args);
+  }
+
+  static void Crc32Combine(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args[0]->IsUint32());
+    CHECK(args[1]->IsUint32());
+    CHECK(args[2]->IsUint32());
+    uLong crc = crc32_combine(args[0].As<Uint32>()->Value(),
+                              args[1].As<Uint32>()->Value(),
+                              args[2].As<Uint32>()->Value());
+    args.GetReturnValue().Set(static_cast<uint32_t>(crc));
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("input", input_.length);
+    tracker->TrackFieldWithSize("dictionary", dictionary_.length);
+    tracker->TrackFieldWithSize("output", output_ ? output_capacity_ : 0);
+  }
+
+  SET_MEMORY_INFO_NAME(DeflateBlockJob)
+  SET_SELF_SIZE(DeflateBlockJob)
+
+ private:
+  // Keeps the memory of a JS-provided view alive while the thread pool
+  // reads from it.
+  struct BlockData {
+    BlockData() = default;
+    explicit BlockData(Local<ArrayBufferView> view)
+        : store(view->Buffer()->GetBackingStore()),
+          offset(view->ByteOffset()),
+          length(view->ByteLength()) {}
+
+    const Bytef* data() const {
+      return static_cast<const Bytef*>(store->Data()) + offset;
+    }
+
+    std::shared_ptr<BackingStore> store;
+    size_t offset = 0;
+    size_t length = 0;
+  };
+
+  const int level_;
+  const int window_bits_;
+  const int mem_level_;
+  const int strategy_;
+  bool last_ = false;
+  int err_ = Z_OK;
+  uint32_t crc_ = 0;
+  size_t output_length_ = 0;
+  BlockData input_;
+  BlockData dictionary_;
+  // Allocated on the thread pool, once the bound for the stream is known.
+  std::unique_ptr<Bytef[]> output_;
+  size_t output_capacity_ = 0;
+};
+
 void ZlibContext::Close() {
   {
     Mutex::ScopedLock lock(mutex_);
     if (!zlib_init_done_) {
-      dictionary_.clear();
+      dictionary_.reset();
       mode_ = NONE;
       return;
     }
@@ -743,16 +1226,16 @@ void ZlibContext::Close() {
 
   int status = Z_OK;
   if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-    status = deflateEnd(&strm_);
+    status = deflateEnd(strm_.get());
   } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
              mode_ == UNZIP) {
-    status = inflateEnd(&strm_);
+    status = inflateEnd(strm_.get());
   }
 
   CHECK(status == Z_OK || status == Z_DATA_ERROR);
   mode_ = NONE;
 
-  dictionary_.clear();
+  dictionary_.reset();
 }
 
 
@@ -771,11 +1254,11 @@ void ZlibContext::DoThreadPoolWork() {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflate(&strm_, flush_);
+      err_ = deflate(strm_.get(), flush_);
       break;
     case UNZIP:
-      if (strm_.avail_in > 0) {
-        next_expected_header_byte = strm_.next_in;
+      if (strm_->avail_in > 0) {
+        next_expected_header_byte = strm_->next_in;
       }
 
       switch (gzip_id_bytes_read_) {
@@ -788,7 +1271,7 @@ void ZlibContext::DoThreadPoolWork() {
             gzip_id_bytes_read_ = 1;
             next_expected_header_byte++;
 
-            if (strm_.avail_in == 1) {
+            if (strm_->avail_in == 1) {
               // The only available byte was already read.
               break;
             }
@@ -821,20 +1304,20 @@ void ZlibContext::DoThreadPoolWork() {
     case INFLATE:
     case GUNZIP:
     case INFLATERAW:
-      err_ = inflate(&strm_, flush_);
+      err_ = inflate(strm_.get(), flush_);
 
       // If data was encoded with dictionary (INFLATERAW will have it set in
       // SetDictionary, don't repeat that here)
       if (mode_ != INFLATERAW &&
           err_ == Z_NEED_DICT &&
-          !dictionary_.empty()) {
+          dictionary_ && !dictionary_->empty()) {
         // Load it
-        err_ = inflateSetDictionary(&strm_,
-                                    dictionary_.data(),
-                                    dictionary_.size());
+        err_ = inflateSetDictionary(strm_.get(),
+                                    dictionary_->data(),
+                                    dictionary_->size());
         if (err_ == Z_OK) {
           // And try to decode again
-          err_ = inflate(&strm_, flush_);
+          err_ = inflate(strm_.get(), flush_);
         } else if (err_ == Z_DATA_ERROR) {
           // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
           // Make it possible for After() to tell a bad dictionary from bad
@@ -843,17 +1326,17 @@ void ZlibContext::DoThreadPoolWork() {
         }
       }
 
-      while (strm_.avail_in > 0 &&
+      while (strm_->avail_in > 0 &&
              mode_ == GUNZIP &&
              err_ == Z_STREAM_END &&
-             strm_.next_in[0] != 0x00) {
+             strm_->next_in[0] != 0x00) {
         // Bytes remain in input buffer. Perhaps this is another compressed
         // member in the same archive, or just trailing garbage.
         // Trailing zero bytes are okay, though, since they are frequently
         // used for padding.
 
         ResetStream();
-        err_ = inflate(&strm_, flush_);
+        err_ = inflate(strm_.get(), flush_);
       }
       break;
     default:
@@ -864,10 +1347,10 @@ void ZlibContext::DoThreadPoolWork() {
 
 void ZlibContext::SetBuffers(const char* in, uint32_t in_len,
                              char* out, uint32_t out_len) {
-  strm_.avail_in = in_len;
-  strm_.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(in));
-  strm_.avail_out = out_len;
-  strm_.next_out = reinterpret_cast<Bytef*>(out);
+  strm_->avail_in = in_len;
+  strm_->next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(in));
+  strm_->avail_out = out_len;
+  strm_->next_out = reinterpret_cast<Bytef*>(out);
 }
 
 
@@ -878,14 +1361,14 @@ void ZlibContext::SetFlush(int flush) {
 
 void ZlibContext::GetAfterWriteOffsets(uint32_t* avail_in,
                                        uint32_t* avail_out) const {
-  *avail_in = strm_.avail_in;
-  *avail_out = strm_.avail_out;
+  *avail_in = strm_->avail_in;
+  *avail_out = strm_->avail_out;
 }
 
 
 CompressionError ZlibContext::ErrorForMessage(const char* message) const {
-  if (strm_.msg != nullptr)
-    message = strm_.msg;
+  if (strm_->msg != nullptr)
+    message = strm_->msg;
 
   return CompressionError { message, ZlibStrerror(err_), err_ };
 }
@@ -896,14 +1379,14 @@ CompressionError ZlibContext::GetErrorInfo() const {
   switch (err_) {
   case Z_OK:
   case Z_BUF_ERROR:
-    if (strm_.avail_out != 0 && flush_ == Z_FINISH) {
+    if (strm_->avail_out != 0 && flush_ == Z_FINISH) {
       return ErrorForMessage("unexpected end of file");
     }
   case Z_STREAM_END:
     // normal statuses, not fatal
     break;
   case Z_NEED_DICT:
-    if (dictionary_.empty())
+    if (!dictionary_ || dictionary_->empty())
       return ErrorForMessage("Missing dictionary");
     else
       return ErrorForMessage("Bad dictionary");
@@ -928,12 +1411,12 @@ CompressionError ZlibContext::ResetStream() {
     case DEFLATE:
     case DEFLATERAW:
     case GZIP:
-      err_ = deflateReset(&strm_);
+      err_ = deflateReset(strm_.get());
       break;
     case INFLATE:
     case INFLATERAW:
     case GUNZIP:
-      err_ = inflateReset(&strm_);
+      err_ = inflateReset(strm_.get());
       break;
     default:
       break;
@@ -949,15 +1432,15 @@ CompressionError ZlibContext::ResetStream() {
 void ZlibContext::SetAllocationFunctions(alloc_func alloc,
                                          free_func free,
                                          void* opaque) {
-  strm_.zalloc = alloc;
-  strm_.zfree = free;
-  strm_.opaque = opaque;
+  strm_->zalloc = alloc;
+  strm_->zfree = free;
+  strm_->opaque = opaque;
 }
 
 
 void ZlibContext::Init(
     int level, int window_bits, int mem_level, int strategy,
-    std::vector<unsigned char>&& dictionary) {
+    std::shared_ptr<ZlibDictionary> dictionary) {
   if (!((window_bits == 0) &&
         (mode_ == INFLATE ||
          mode_ == GUNZIP ||
@@ -1008,11 +1491,19 @@ bool ZlibContext::InitZlib() {
     return false;
   }
 
+  if (dictionary_ &&
+      dictionary_->caches_primed_states() &&
+      dictionary_->CopyPrimedState(pool_key(), strm_.get())) {
+    err_ = Z_OK;
+    zlib_init_done_ = true;
+    return true;
+  }
+
   switch (mode_) {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflateInit2(&strm_,
+      err_ = deflateInit2(strm_.get(),
                           level_,
                           Z_DEFLATED,
                           window_bits_,
@@ -1023,14 +1514,14 @@ bool ZlibContext::InitZlib() {
     case GUNZIP:
     case INFLATERAW:
     case UNZIP:
-      err_ = inflateInit2(&strm_, window_bits_);
+      err_ = inflateInit2(strm_.get(), window_bits_);
       break;
     default:
       UNREACHABLE();
   }
 
   if (err_ != Z_OK) {
-    dictionary_.clear();
+    dictionary_.reset();
     mode_ = NONE;
     return true;
   }
@@ -1042,7 +1533,7 @@ bool ZlibContext::InitZlib() {
 
 
 CompressionError ZlibContext::SetDictionary() {
-  if (dictionary_.empty())
+  if (!dictionary_ || dictionary_->empty())
     return CompressionError {};
 
   err_ = Z_OK;
@@ -1050,16 +1541,16 @@ CompressionError ZlibContext::SetDictionary() {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateSetDictionary(&strm_,
-                                  dictionary_.data(),
-                                  dictionary_.size());
+      err_ = deflateSetDictionary(strm_.get(),
+                                  dictionary_->data(),
+                                  dictionary_->size());
       break;
     case INFLATERAW:
       // The other inflate cases will have the dictionary set when inflate()
       // returns Z_NEED_DICT in Process()
-      err_ = inflateSetDictionary(&strm_,
-                                  dictionary_.data(),
-                                  dictionary_.size());
+      err_ = inflateSetDictionary(strm_.get(),
+                                  dictionary_->data(),
+                                  dictionary_->size());
       break;
     default:
       break;
@@ -1084,7 +1575,7 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateParams(&strm_, level, strategy);
+      err_ = deflateParams(strm_.get(), level, strategy);
       break;
     default:
       break;
@@ -1094,10 +1585,189 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
     return ErrorForMessage("Failed to set parameters");
   }
 
+  // The pool hands states out by these parameters, so only record the ones
+  // that deflateParams() actually applied. GZIP streams never apply them.
+  if (err_ == Z_OK && (mode_ == DEFLATE || mode_ == DEFLATERAW)) {
+    level_ = level;
+    strategy_ = strategy;
+  }
   return CompressionError {};
 }
 
 
+bool ZlibContext::IsPoolable() const {
+  return mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW;
+}
+
+
+bool ZlibContext::AcquireFromPool(ZlibContextPool* pool, size_t* memory) {
+  if (!IsPoolable())
+    return false;
+
+  // Copying a primed state is cheaper than re-hashing the dictionary.
+  if (dictionary_ && dictionary_->caches_primed_states())
+    return false;
+
+  Mutex::ScopedLock lock(mutex_);
+  CHECK(!zlib_init_done_);
+  std::unique_ptr<z_stream> strm = pool->Acquire(pool_key(), memory);
+  if (!strm)
+    return false;
+
+  strm->zalloc = strm_->zalloc;
+  strm->zfree = strm_->zfree;
+  strm->opaque = strm_->opaque;
+  strm_ = std::move(strm);
+  err_ = Z_OK;
+  SetDictionary();
+  zlib_init_done_ = true;
+  return true;
+}
+
+
+bool ZlibContext::PrepareForPool() {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    if (!zlib_init_done_)
+      return false;
+  }
+
+  return IsPoolable() && deflateReset(strm_.get()) == Z_OK;
+}
+
+
+void ZlibContext::ReleaseToPool(ZlibContextPool* pool, size_t memory) {
+  Mutex::ScopedLock lock(mutex_);
+  CHECK(zlib_init_done_);
+  pool->Release(pool_key(), std::move(strm_), memory);
+  strm_ = std::make_unique<z_stream>();
+  zlib_init_done_ = false;
+}
+
+
+ZlibDictionary::~ZlibDictionary() {
+  for (PrimedState& state : primed_states_)
+    deflateEnd(state.strm.get());
+}
+
+
+bool ZlibDictionary::CopyPrimedState(const ZlibContextPool::Key& key,
+                                     z_stream* dest) {
+  // gzip streams do not support dictionaries.
+  if (key.mode != DEFLATE && key.mode != DEFLATERAW)
+    return false;
+
+  Mutex::ScopedLock lock(mutex_);
+  z_stream* primed = nullptr;
+  for (PrimedState& state : primed_states_) {
+    if (state.key == key) {
+      primed = state.strm.get();
+      break;
+    }
+  }
+
+  if (primed == nullptr) {
+    if (primed_states_.size() >= kMaxPrimedStates)
+      return false;
+    auto strm = std::make_unique<z_stream>();
+    if (deflateInit2(strm.get(), key.level, Z_DEFLATED, key.window_bits,
+                     key.mem_level, key.strategy) != Z_OK) {
+      return false;
+    }
+    if (deflateSetDictionary(strm.get(), data(), size()) != Z_OK) {
+      deflateEnd(strm.get());
+      return false;
+    }
+    primed = strm.get();
+    primed_states_.push_back(PrimedState { key, std::move(strm) });
+  }
+
+  // deflateCopy() copies the whole z_stream, including the buffers and the
+  // allocation functions, and allocates the copy through the latter. Make
+  // sure that the copy is accounted to |dest| and keeps its buffers.
+  alloc_func primed_zalloc = primed->zalloc;
+  free_func primed_zfree = primed->zfree;
+  voidpf primed_opaque = primed->opaque;
+  primed->zalloc = dest->zalloc;
+  primed->zfree = dest->zfree;
+  primed->opaque = dest->opaque;
+
+  z_const Bytef* next_in = dest->next_in;
+  uInt avail_in = dest->avail_in;
+  Bytef* next_out = dest->next_out;
+  uInt avail_out = dest->avail_out;
+
+  int err = deflateCopy(dest, primed);
+
+  primed->zalloc = primed_zalloc;
+  primed->zfree = primed_zfree;
+  primed->opaque = primed_opaque;
+  dest->next_in = next_in;
+  dest->avail_in = avail_in;
+  dest->next_out = next_out;
+  dest->avail_out = avail_out;
+  return err == Z_OK;
+}
+
+
+ZlibContextPool::~ZlibContextPool() {
+  for (Entry& entry : entries_)
+    Evict(&entry);
+}
+
+
+std::unique_ptr<z_stream> ZlibContextPool::Acquire(const Key& key,
+                                                   size_t* memory) {
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+    if (it->key == key) {
+      std::unique_ptr<z_stream> strm = std::move(it->strm);
+      *memory = it->memory;
+      memory_ -= it->memory;
+      entries_.erase(std::next(it).base());
+      hits_++;
+      return strm;
+    }
+  }
+
+  misses_++;
+  return nullptr;
+}
+
+
+void ZlibContextPool::Release(const Key& key,
+                              std::unique_ptr<z_stream> strm,
+                              size_t memory) {
+  if (entries_.size() >= kMaxEntries) {
+    Evict(&entries_.front());
+    entries_.erase(entries_.begin());
+    evictions_++;
+  }
+
+  // The owning stream may be gone by the time this state is freed.
+  strm->zalloc = nullptr;
+  strm->zfree = FreeParked;
+  strm->opaque = nullptr;
+  memory_ += memory;
+  entries_.push_back(Entry { key, std::move(strm), memory });
+}
+
+
+void ZlibContextPool::Evict(Entry* entry) {
+  CHECK_EQ(deflateEnd(entry->strm.get()), Z_OK);
+  entry->strm.reset();
+  memory_ -= entry->memory;
+  isolate_->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(entry->memory));
+}
+
+
+// Matches the allocation layout used by CompressionStream::AllocForZlib().
+void ZlibContextPool::FreeParked(void* data, void* pointer) {
+  if (UNLIKELY(pointer == nullptr)) return;
+  free(static_cast<char*>(pointer) - sizeof(size_t));
+}
+
+
 void BrotliContext::SetBuffers(const char* in, uint32_t in_len,
                                char* out, uint32_t out_len) {
   next_in_ = reinterpret_cast<const uint8_t*>(in);
@@ -1285,16 +1955,69 @@ struct MakeClass {
   }
 };
 
+// Returns [hits, misses, evictions, parked states] for the current
+// Environment's deflate state pool. Used in tests.
+void GetContextPoolInfo(const FunctionCallbackInfo<Value>& args) {
+  BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+  const ZlibContextPool& pool = binding_data->context_pool;
+  Isolate* isolate = args.GetIsolate();
+  Local<Value> values[] = {
+    Number::New(isolate, static_cast<double>(pool.hits())),
+    Number::New(isolate, static_cast<double>(pool.misses())),
+    Number::New(isolate, static_cast<double>(pool.evictions())),
+    Number::New(isolate, static_cast<double>(pool.size())),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, values, arraysize(values)));
+}
+
+// Returns the histograms of the time spent on asynchronous writes that were
+// processed inline and on the thread pool, respectively. Used in tests.
+void GetWorkHistograms(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+  BaseObjectPtr<HistogramBase> inline_work =
+      HistogramBase::Create(env, binding_data->inline_work);
+  BaseObjectPtr<HistogramBase> offloaded_work =
+      HistogramBase::Create(env, binding_data->offloaded_work);
+  if (!inline_work || !offloaded_work) return;
+  Local<Value> values[] = { inline_work->object(), offloaded_work->object() };
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), values, arraysize(values)));
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
                 void* priv) {
   Environment* env = Environment::GetCurrent(context);
 
+  BindingData* const binding_data =
+      env->AddBindingData<BindingData>(context, target);
+  if (binding_data == nullptr) return;
+
   MakeClass<ZlibStream>::Make(env, target, "Zlib");
   MakeClass<BrotliEncoderStream>::Make(env, target, "BrotliEncoder");
   MakeClass<BrotliDecoderStream>::Make(env, target, "BrotliDecoder");
 
+  Isolate* isolate = env->isolate();
+  Local<FunctionTemplate> job =
+      NewFunctionTemplate(isolate, DeflateBlockJob::New);
+  job->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  job->InstanceTemplate()->SetInternalFieldCount(
+      AsyncWrap::kInternalFieldCount);
+  SetProtoMethod(isolate, job, "run", DeflateBlockJob::Run);
+  SetConstructorFunction(context, target, "DeflateBlockJob", job);
+  SetMethod(context, target, "crc32Combine", DeflateBlockJob::Crc32Combine);
+
+  Local<FunctionTemplate> dictionary =
+      NewFunctionTemplate(isolate, ZlibDictionaryWrap::New);
+  dictionary->InstanceTemplate()->SetInternalFieldCount(
+      BaseObject::kInternalFieldCount);
+  dictionary->Inherit(BaseObject::GetConstructorTemplate(env));
+  SetConstructorFunction(context, target, "ZlibDictionary", dictionary);
+  SetMethod(context, target, "getContextPoolInfo", GetContextPoolInfo);
+  SetMethod(context, target, "getWorkHistograms", GetWorkHistograms);
+
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
               FIXED_ONE_BYTE_STRING(env->isolate(), ZLIB_VERSION)).Check();
@@ -1304,6 +2027,12 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   MakeClass<ZlibStream>::Make(registry);
   MakeClass<BrotliEncoderStream>::Make(registry);
   MakeClass<BrotliDecoderStream>::Make(registry);
+  registry->Register(DeflateBlockJob::New);
+  registry->Register(DeflateBlockJob::Run);
+  registry->Register(DeflateBlockJob::Crc32Combine);
+  registry->Register(ZlibDictionaryWrap::New);
+  registry->Register(GetContextPoolInfo);
+  registry->Register(GetWorkHistograms);
 }
 
 }  // anonymous namespace
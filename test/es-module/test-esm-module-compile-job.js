@@ -0,0 +1,64 @@
+'use strict';
+// Flags: --expose-internals
+
+// This test checks that modules parsed on the thread pool are compiled to
+// the same modules as when they are compiled from their source.
+
+const common = require('../common');
+
+const assert = require('assert');
+const tmpdir = require('../common/tmpdir');
+const path = require('path');
+const fs = require('fs');
+const { pathToFileURL } = require('url');
+const { internalBinding } = require('internal/test/binding');
+const { ModuleWrap, ModuleCompileJob } = internalBinding('module_wrap');
+
+async function compile(url, source) {
+  const job = new ModuleCompileJob(url, source, false);
+  await job.run();
+  return new ModuleWrap(url, undefined, source, 0, 0, undefined, false, job);
+}
+
+(async () => {
+  // One-byte and two-byte sources.
+  for (const source of [
+    'export const a = "é"; import "x";',
+    'export const a = "☃😀"; import "x";',
+    '',
+  ]) {
+    const wrap = await compile('file:///a.mjs', source);
+    assert.deepStrictEqual(
+      wrap.getStaticDependencySpecifiers(),
+      source ? ['x'] : []);
+  }
+
+  const wrap = await compile('file:///b.mjs', 'export default "☃";');
+  wrap.link(() => {});
+  wrap.instantiate();
+  await wrap.evaluate(-1, false);
+  assert.strictEqual(wrap.getNamespace().default, '☃');
+
+  // Syntax errors are thrown by the constructor, as usual.
+  await assert.rejects(compile('file:///c.mjs', 'export {'), {
+    name: 'SyntaxError',
+  });
+})().then(common.mustCall());
+
+// A graph that is wide enough to be parsed in parallel.
+tmpdir.refresh();
+const deps = [];
+for (let i = 0; i < 16; i++) {
+  const name = `dep${i}.mjs`;
+  fs.writeFileSync(path.join(tmpdir.path, name),
+                   `export default ${i} + ${'1 + '.repeat(1000)}0;`);
+  deps.push(name);
+}
+const entry = path.join(tmpdir.path, 'entry.mjs');
+fs.writeFileSync(entry, `
+${deps.map((name, i) => `import d${i} from './${name}';`).join('\n')}
+export default [${deps.map((name, i) => `d${i}`).join(', ')}];
+`);
+import(pathToFileURL(entry)).then(common.mustCall(({ default: values }) => {
+  assert.deepStrictEqual(values, deps.map((name, i) => i + 1000));
+}));
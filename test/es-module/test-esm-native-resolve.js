@@ -0,0 +1,63 @@
+'use strict';
+// Flags: --expose-internals
+
+// This test checks that the native ESM resolver agrees with the JS
+// implementation, and that it leaves errors and deprecated cases to it.
+
+const common = require('../common');
+
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const { pathToFileURL } = require('url');
+const { internalBinding } = require('internal/test/binding');
+const { resolve: nativeResolve } = internalBinding('module_wrap');
+const {
+  defaultResolve,
+  jsModuleResolve,
+} = require('internal/modules/esm/resolve');
+
+const conditions = ['node', 'import'];
+const parent = fixtures.path('es-modules', 'pkgimports', 'importer.js');
+
+const resolved = [
+  './test.js',
+  '#test',
+  '#branch',
+  '#subpath/x.js',
+  'pkgexports/valid-cjs',
+  'pkgexports/subpath/sub-dir1',
+  'pkgexports-sugar',
+  fixtures.path('es-modules', 'loop.mjs'),
+];
+const parentURL = pathToFileURL(parent).href;
+for (const specifier of resolved) {
+  const path = nativeResolve(specifier, parent, conditions, false);
+  assert.strictEqual(typeof path, 'string', specifier);
+  const expected = jsModuleResolve(specifier, parentURL, new Set(conditions),
+                                   false).href;
+  assert.strictEqual(pathToFileURL(path).href, expected, specifier);
+  // The default resolver, which tries the native one first, agrees too.
+  defaultResolve(specifier, { parentURL }).then(common.mustCall((result) => {
+    assert.strictEqual(result.url, expected, specifier);
+  }));
+}
+
+// These throw or warn, which is done by the JS implementation.
+const notResolved = [
+  './missing.js',
+  '../pkgimports',
+  '#missing',
+  '#subpath/null',
+  '#external',
+  'pkgexports/missing',
+  'pkgexports/trailing-pattern-slash/',
+  'pkgexports/space',
+  'no_exports',
+  'missing-package',
+  './test.js?query',
+  'file:///test.js',
+];
+for (const specifier of notResolved) {
+  assert.strictEqual(nativeResolve(specifier, parent, conditions, false),
+                     undefined, specifier);
+}
@@ -0,0 +1,19 @@
+'use strict';
+
+const {
+  setDeserializeMainFunction
+} = require('v8').startupSnapshot;
+const assert = require('assert');
+const a = require('./cjs-graph/a');
+
+setDeserializeMainFunction(() => {
+  // The modules are found in the module cache restored from the snapshot.
+  const b = require('./cjs-graph/b');
+  assert.strictEqual(b, a.b);
+  assert.strictEqual(b.loadCount, 1);
+  assert.strictEqual(a.value, 'a');
+  // Functions compiled while building the snapshot can still use import().
+  a.load().then(({ default: c }) => {
+    console.log(`${a.value}${b.value}${c}`);
+  });
+});
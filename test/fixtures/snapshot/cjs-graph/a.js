@@ -0,0 +1,5 @@
+'use strict';
+
+exports.b = require('./b');
+exports.value = 'a';
+exports.load = () => import('./c.mjs');
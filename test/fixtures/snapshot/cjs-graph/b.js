@@ -0,0 +1,5 @@
+'use strict';
+
+globalThis.bLoadCount = (globalThis.bLoadCount || 0) + 1;
+exports.loadCount = globalThis.bLoadCount;
+exports.value = 'b';
@@ -0,0 +1,4 @@
+'use strict';
+
+// ES modules cannot be included in the snapshot yet.
+require('./cjs-graph/a').load();
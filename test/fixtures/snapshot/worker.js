@@ -0,0 +1,22 @@
+'use strict';
+
+const { Worker } = require('worker_threads');
+const { setDeserializeMainFunction } = require('v8').startupSnapshot;
+
+globalThis.fromSnapshot = 'main';
+
+setDeserializeMainFunction(() => {
+  const worker = new Worker(`
+    const { parentPort, Worker } = require('worker_threads');
+    // Nested workers are started from the same snapshot.
+    const nested = new Worker(
+      'require("worker_threads").parentPort.postMessage(typeof fromSnapshot)',
+      { eval: true });
+    nested.once('message', (type) => {
+      parentPort.postMessage(typeof fromSnapshot + ',' + type);
+    });
+  `, { eval: true });
+  worker.once('message', (message) => {
+    console.log(`${globalThis.fromSnapshot},${message}`);
+  });
+});
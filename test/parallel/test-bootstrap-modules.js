@@ -63,7 +63,6 @@ const expectedModules = new Set([
   'NativeModule internal/event_target',
   'NativeModule internal/fixed_queue',
   'NativeModule internal/fs/dir',
-  'NativeModule internal/fs/promises',
   'NativeModule internal/fs/read_file_context',
   'NativeModule internal/fs/rimraf',
   'NativeModule internal/fs/utils',
@@ -92,7 +91,6 @@ const expectedModules = new Set([
   'NativeModule internal/modules/run_main',
   'NativeModule internal/net',
   'NativeModule internal/options',
-  'NativeModule internal/perf/event_loop_delay',
   'NativeModule internal/perf/event_loop_utilization',
   'NativeModule internal/perf/nodetiming',
   'NativeModule internal/perf/observe',
@@ -144,16 +142,9 @@ const expectedModules = new Set([
   'NativeModule internal/util/parse_args/parse_args',
   'NativeModule internal/util/types',
   'NativeModule internal/validators',
+  'NativeModule internal/vm',
   'NativeModule internal/vm/module',
   'NativeModule internal/wasm_web_api',
-  'NativeModule internal/webstreams/adapters',
-  'NativeModule internal/webstreams/compression',
-  'NativeModule internal/webstreams/encoding',
-  'NativeModule internal/webstreams/queuingstrategies',
-  'NativeModule internal/webstreams/readablestream',
-  'NativeModule internal/webstreams/transformstream',
-  'NativeModule internal/webstreams/util',
-  'NativeModule internal/webstreams/writablestream',
   'NativeModule internal/worker/io',
   'NativeModule internal/worker/js_transferable',
   'Internal Binding blob',
@@ -161,7 +152,6 @@ const expectedModules = new Set([
   'NativeModule async_hooks',
   'NativeModule net',
   'NativeModule path',
-  'NativeModule perf_hooks',
   'NativeModule querystring',
   'NativeModule stream',
   'NativeModule stream/promises',
@@ -0,0 +1,77 @@
+'use strict';
+// Test that NODE_COMPILE_CACHE stores the code cache of CommonJS and ES
+// modules on disk, that later processes use it, and that entries are replaced
+// when the source changes.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const cacheDir = path.join(tmpdir.path, 'cache');
+const cjs = path.join(tmpdir.path, 'dep.js');
+const esm = path.join(tmpdir.path, 'dep.mjs');
+const main = path.join(tmpdir.path, 'main.js');
+fs.writeFileSync(cjs, 'module.exports = 1;');
+fs.writeFileSync(esm, 'export default 2;');
+fs.writeFileSync(main, `
+  const { getCompileCacheStats } = require('module');
+  require('./dep.js');
+  import('./dep.mjs').then(() => {
+    // Wait for the entries to be written.
+    setTimeout(() => console.log(JSON.stringify(getCompileCacheStats())), 100);
+  });
+`);
+
+function run(env) {
+  const child = spawnSync(process.execPath, [main], {
+    env: { ...process.env, ...env },
+    encoding: 'utf8',
+  });
+  assert.strictEqual(child.status, 0, child.stderr);
+  return JSON.parse(child.stdout);
+}
+
+// Without the environment variable, the cache is disabled.
+assert.strictEqual(require('module').getCompileCacheStats(), undefined);
+
+{
+  const stats = run({ NODE_COMPILE_CACHE: cacheDir });
+  assert(stats.directory.startsWith(cacheDir));
+  assert.strictEqual(stats.hits, 0);
+  assert.strictEqual(stats.misses, 3);
+  assert.strictEqual(stats.rejected, 0);
+  assert.strictEqual(stats.written, 3);
+}
+
+{
+  const stats = run({ NODE_COMPILE_CACHE: cacheDir });
+  assert.strictEqual(stats.hits, 3);
+  assert.strictEqual(stats.misses, 0);
+  assert.strictEqual(stats.written, 0);
+}
+
+{
+  // Changed modules miss and get their entry replaced.
+  fs.writeFileSync(cjs, 'module.exports = 3;');
+  const stats = run({ NODE_COMPILE_CACHE: cacheDir });
+  assert.strictEqual(stats.hits, 2);
+  assert.strictEqual(stats.misses, 1);
+  assert.strictEqual(stats.written, 1);
+}
+
+{
+  // A cache directory that cannot be created only produces a warning.
+  const file = path.join(tmpdir.path, 'file');
+  fs.writeFileSync(file, '');
+  const child = spawnSync(process.execPath, ['-e', '0'], {
+    env: { ...process.env, NODE_COMPILE_CACHE: path.join(file, 'cache') },
+    encoding: 'utf8',
+  });
+  assert.strictEqual(child.status, 0);
+  assert.match(child.stderr, /Cannot enable the compile cache/);
+}
@@ -802,6 +802,102 @@ if (!isWindows) {
   );
 }
 
+// It copies several entries of each directory at once with concurrency.
+{
+  const src = './test/fixtures/copy/kitchen-sink';
+  const dest = nextdir();
+  await fs.promises.cp(src, dest, mustNotMutateObjectDeep({
+    concurrency: 8,
+    preserveTimestamps: true,
+    recursive: true,
+  }));
+  assertDirEquivalent(src, dest);
+  const srcStat = lstatSync(join(src, 'index.js'));
+  const destStat = lstatSync(join(dest, 'index.js'));
+  assert.strictEqual(srcStat.mode, destStat.mode);
+  assert.strictEqual(srcStat.mtime.getTime(), destStat.mtime.getTime());
+}
+
+// It copies at most concurrency entries at a time across the whole tree,
+// including nested directories deeper than the concurrency.
+{
+  const src = nextdir();
+  let dir = src;
+  for (let depth = 0; depth < 4; depth++) {
+    mkdirSync(dir, mustNotMutateObjectDeep({ recursive: true }));
+    for (let i = 0; i < 3; i++)
+      writeFileSync(join(dir, `file-${i}`), `${depth}-${i}`);
+    dir = join(dir, 'nested');
+  }
+  const dest = nextdir();
+  let active = 0;
+  let maxActive = 0;
+  await fs.promises.cp(src, dest, {
+    concurrency: 2,
+    recursive: true,
+    async filter() {
+      maxActive = Math.max(maxActive, ++active);
+      await setTimeout(5);
+      active--;
+      return true;
+    },
+  });
+  assertDirEquivalent(src, dest);
+  assert.strictEqual(maxActive, 2);
+}
+
+// It reports the first error, after the other copies have settled, when
+// copying with concurrency.
+{
+  const src = nextdir();
+  mkdirSync(src, mustNotMutateObjectDeep({ recursive: true }));
+  for (let i = 0; i < 20; i++)
+    writeFileSync(join(src, `file-${i}`), `${i}`);
+  const dest = nextdir();
+  mkdirSync(dest, mustNotMutateObjectDeep({ recursive: true }));
+  writeFileSync(join(dest, 'file-5'), 'exists');
+  await assert.rejects(
+    fs.promises.cp(src, dest, {
+      concurrency: 4,
+      errorOnExist: true,
+      force: false,
+      recursive: true,
+    }),
+    { code: 'ERR_FS_CP_EEXIST' }
+  );
+}
+
+// It preserves the mode and timestamps of read-only files.
+{
+  const src = nextdir();
+  mkdirSync(src, mustNotMutateObjectDeep({ recursive: true }));
+  const file = join(src, 'read-only.txt');
+  writeFileSync(file, 'read only');
+  fs.utimesSync(file, new Date(2000, 0, 1), new Date(2001, 0, 1));
+  fs.chmodSync(file, 0o444);
+  for (const copy of [
+    (dest) => fs.promises.cp(src, dest, { preserveTimestamps: true, recursive: true }),
+    (dest) => cpSync(src, dest, { preserveTimestamps: true, recursive: true }),
+  ]) {
+    const dest = nextdir();
+    await copy(dest);
+    const srcStat = statSync(file);
+    const destStat = statSync(join(dest, 'read-only.txt'));
+    assert.strictEqual(destStat.mode, srcStat.mode);
+    assert.strictEqual(destStat.mtime.getTime(), srcStat.mtime.getTime());
+    assert.strictEqual(readFileSync(join(dest, 'read-only.txt'), 'utf8'),
+                       'read only');
+  }
+}
+
+// It rejects invalid concurrency.
+for (const concurrency of [0, 1.5, '4']) {
+  await assert.rejects(
+    fs.promises.cp('a', 'b', { concurrency }),
+    { code: /ERR_OUT_OF_RANGE|ERR_INVALID_ARG_TYPE/ }
+  );
+}
+
 function assertDirEquivalent(dir1, dir2) {
   const dir1Entries = [];
   collectEntries(dir1, dir1Entries);
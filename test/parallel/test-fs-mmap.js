@@ -0,0 +1,102 @@
+'use strict';
+// Test that fs.mmap() maps ranges of a file into Buffers, including ranges
+// that do not start on a page boundary, and that fs.mmapAsBlob() and
+// filehandle.mmap() expose the same data.
+
+const common = require('../common');
+const assert = require('assert');
+const { Blob } = require('buffer');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'mmap.bin');
+const data = Buffer.alloc(100000);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 251;
+fs.writeFileSync(file, data);
+
+{
+  const fd = fs.openSync(file, 'r');
+  assert.deepStrictEqual(fs.mmap(fd), data);
+  assert.deepStrictEqual(fs.mmap(fd, 70001), data.subarray(70001));
+  assert.deepStrictEqual(fs.mmap(fd, 4097, 10, { advice: 'random' }),
+                         data.subarray(4097, 4107));
+  assert.deepStrictEqual(fs.mmap(fd, { advice: 'sequential' }), data);
+  assert.strictEqual(fs.mmap(fd, data.length).length, 0);
+
+  // The mapping outlives the file descriptor.
+  const mapped = fs.mmap(fd, 1, 3, { advice: 'willneed' });
+  fs.closeSync(fd);
+  assert.deepStrictEqual(mapped, data.subarray(1, 4));
+}
+
+{
+  const fd = fs.openSync(file, 'r');
+  const blob = fs.mmapAsBlob(fd, 10, 20, { type: 'application/octet-stream' });
+  fs.closeSync(fd);
+  assert(blob instanceof Blob);
+  assert.strictEqual(blob.size, 20);
+  assert.strictEqual(blob.type, 'application/octet-stream');
+  blob.arrayBuffer().then(common.mustCall((ab) => {
+    assert.deepStrictEqual(Buffer.from(ab), data.subarray(10, 30));
+  }));
+}
+
+{
+  // Shared writable mappings write through to the file, private ones do not.
+  const copy = path.join(tmpdir.path, 'mmap-rw.bin');
+  fs.writeFileSync(copy, 'hello world');
+  const fd = fs.openSync(copy, 'r+');
+  const priv = fs.mmap(fd, { prot: 'rw', shared: false });
+  priv.write('HELLO');
+  const shared = fs.mmap(fd, 6, 5, { prot: 'rw' });
+  shared.write('WORLD');
+  fs.closeSync(fd);
+  assert.strictEqual(priv.toString(), 'HELLO world');
+  assert.strictEqual(fs.readFileSync(copy, 'utf8'), 'hello WORLD');
+}
+
+{
+  // Writing to a read-only mapping does not crash and never reaches the file.
+  const copy = path.join(tmpdir.path, 'mmap-ro.bin');
+  fs.writeFileSync(copy, 'read only');
+  const fd = fs.openSync(copy, 'r');
+  const mapped = fs.mmap(fd);
+  fs.closeSync(fd);
+  mapped.fill(0x41);
+  assert.strictEqual(mapped.toString(), 'AAAAAAAAA');
+  assert.strictEqual(fs.readFileSync(copy, 'utf8'), 'read only');
+}
+
+fs.promises.open(file).then(common.mustCall(async (handle) => {
+  assert.deepStrictEqual(await handle.mmap(5, 5), data.subarray(5, 10));
+  await handle.close();
+  await assert.rejects(handle.mmap(), { code: 'EBADF' });
+}));
+
+{
+  const fd = fs.openSync(file, 'r');
+  assert.throws(() => fs.mmap(fd, data.length + 1), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => fs.mmap(fd, 1, data.length), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => fs.mmap(fd, -1), { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => fs.mmap(fd, { prot: 'w' }), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+  assert.throws(() => fs.mmap(fd, { advice: 'soon' }), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+  // The descriptor was not opened for writing.
+  assert.throws(() => fs.mmap(fd, { prot: 'rw' }), {
+    code: common.isWindows ? 'EPERM' : 'EACCES',
+    syscall: 'mmap',
+  });
+  fs.closeSync(fd);
+  assert.throws(() => fs.mmap('fd'), { code: 'ERR_INVALID_ARG_TYPE' });
+}
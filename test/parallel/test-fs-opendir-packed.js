@@ -0,0 +1,115 @@
+'use strict';
+// Test that Dir reads entries in packed form through readPacked() and
+// readPackedSync(), and that the async iterator, which reads the next batch
+// ahead of time, still returns every entry once.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const dirPath = path.join(tmpdir.path, 'packed');
+fs.mkdirSync(dirPath);
+const expected = [];
+for (let i = 0; i < 100; i++) {
+  const name = i % 10 === 0 ? `dir-${i}` : `file-ü-${i}`;
+  if (i % 10 === 0)
+    fs.mkdirSync(path.join(dirPath, name));
+  else
+    fs.writeFileSync(path.join(dirPath, name), '');
+  expected.push(name);
+}
+expected.sort();
+
+const { UV_DIRENT_DIR, UV_DIRENT_FILE } = fs.constants;
+
+function unpack({ names, offsets, types }, into) {
+  assert(Buffer.isBuffer(names));
+  assert(offsets instanceof Uint32Array);
+  assert(types instanceof Uint8Array);
+  assert.strictEqual(offsets.length, types.length + 1);
+  for (let i = 0; i < types.length; i++) {
+    const name = names.toString('utf8', offsets[i], offsets[i + 1]);
+    assert.strictEqual(types[i],
+                       name.startsWith('dir') ? UV_DIRENT_DIR : UV_DIRENT_FILE);
+    into.push(name);
+  }
+}
+
+{
+  const dir = fs.opendirSync(dirPath, { bufferSize: 7 });
+  const names = [];
+  // Entries buffered by readSync() are returned by readPackedSync() as well.
+  names.push(dir.readSync().name);
+  let entries;
+  while ((entries = dir.readPackedSync()) !== null) {
+    assert(entries.types.length <= 7);
+    unpack(entries, names);
+  }
+  dir.closeSync();
+  assert.deepStrictEqual(names.sort(), expected);
+}
+
+(async () => {
+  const dir = await fs.promises.opendir(dirPath, { bufferSize: 16 });
+  const names = [];
+  let entries;
+  while ((entries = await dir.readPacked()) !== null)
+    unpack(entries, names);
+  await dir.close();
+  assert.deepStrictEqual(names.sort(), expected);
+})().then(common.mustCall());
+
+fs.opendir(dirPath, common.mustSucceed((dir) => {
+  const names = [];
+  dir.readPacked(common.mustSucceed(function next(entries) {
+    if (entries === null) {
+      assert.deepStrictEqual(names.sort(), expected);
+      dir.close(common.mustSucceed());
+      return;
+    }
+    unpack(entries, names);
+    dir.readPacked(common.mustSucceed(next));
+  }));
+}));
+
+(async () => {
+  for (const bufferSize of [1, 3, 32, 1000]) {
+    const dir = await fs.promises.opendir(dirPath, { bufferSize });
+    const names = [];
+    for await (const dirent of dir) {
+      assert.strictEqual(dirent.isDirectory(), dirent.name.startsWith('dir'));
+      names.push(dirent.name);
+    }
+    assert.deepStrictEqual(names.sort(), expected);
+  }
+
+  {
+    // Leaving the loop early closes the directory once the batch that is
+    // being read ahead is done.
+    const dir = await fs.promises.opendir(dirPath, { bufferSize: 4 });
+    // eslint-disable-next-line no-unused-vars
+    for await (const dirent of dir)
+      break;
+    assert.throws(() => dir.readSync(), { code: 'ERR_DIR_CLOSED' });
+  }
+
+  {
+    // Entries buffered by read() are iterated first.
+    const dir = await fs.promises.opendir(dirPath, { bufferSize: 10 });
+    const names = [(await dir.read()).name];
+    for await (const dirent of dir)
+      names.push(dirent.name);
+    assert.deepStrictEqual(names.sort(), expected);
+  }
+})().then(common.mustCall());
+
+{
+  const dir = fs.opendirSync(dirPath);
+  dir.closeSync();
+  assert.throws(() => dir.readPackedSync(), { code: 'ERR_DIR_CLOSED' });
+  assert.throws(() => dir.readPacked(), { code: 'ERR_DIR_CLOSED' });
+}
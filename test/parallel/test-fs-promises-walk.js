@@ -0,0 +1,105 @@
+'use strict';
+// Test that fsPromises.walk() yields every entry of a directory tree once,
+// with its type and its path relative to the root.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'tree');
+const expected = new Map();
+function add(relative, type) {
+  const full = path.join(root, relative);
+  if (type === 'dir') {
+    fs.mkdirSync(full);
+  } else {
+    fs.writeFileSync(full, relative);
+  }
+  expected.set(relative, type);
+}
+
+fs.mkdirSync(root);
+// Enough entries for several batches and work items.
+for (let i = 0; i < 20; i++) {
+  const dir = `dir-${i}`;
+  add(dir, 'dir');
+  add(path.join(dir, 'nested'), 'dir');
+  for (let j = 0; j < 300; j++)
+    add(path.join(dir, `file-${j}.${j % 2 ? 'js' : 'txt'}`), 'file');
+  add(path.join(dir, 'nested', 'deep.js'), 'file');
+}
+add('node_modules', 'dir');
+add(path.join('node_modules', 'dep.js'), 'file');
+if (!common.isWindows) {
+  fs.symlinkSync('dir-0', path.join(root, 'link'));
+  expected.set('link', 'link');
+}
+
+function typeOf(dirent) {
+  if (dirent.isDirectory()) return 'dir';
+  if (dirent.isFile()) return 'file';
+  if (dirent.isSymbolicLink()) return 'link';
+  return 'unknown';
+}
+
+async function collect(root, options) {
+  const seen = new Map();
+  for await (const dirents of fs.promises.walk(root, options)) {
+    assert(Array.isArray(dirents));
+    assert(dirents.length > 0);
+    for (const dirent of dirents) {
+      assert(dirent instanceof fs.Dirent);
+      assert(!seen.has(dirent.name), `${dirent.name} was yielded twice`);
+      seen.set(dirent.name, typeOf(dirent));
+    }
+  }
+  return seen;
+}
+
+(async () => {
+  assert.deepStrictEqual(await collect(root), expected);
+
+  const filtered = await collect(root, {
+    exclude: ['node_modules', 'nested'],
+    suffixes: ['.js'],
+  });
+  assert.deepStrictEqual(filtered, new Map([...expected].filter(([name]) => {
+    return name.endsWith('.js') &&
+           !name.includes('node_modules') &&
+           !name.includes('nested');
+  })));
+
+  for await (const dirents of fs.promises.walk(root, 'buffer')) {
+    assert(Buffer.isBuffer(dirents[0].name));
+  }
+
+  // Ending the iteration early stops the walk.
+  for await (const dirents of fs.promises.walk(root)) {
+    assert(dirents.length > 0);
+    break;
+  }
+
+  const empty = path.join(tmpdir.path, 'empty');
+  fs.mkdirSync(empty);
+  assert.strictEqual((await collect(empty)).size, 0);
+
+  const missing = path.join(tmpdir.path, 'missing');
+  await assert.rejects(collect(missing), {
+    code: 'ENOENT',
+    syscall: 'scandir',
+    path: missing,
+  });
+  await assert.rejects(collect(path.join(root, 'node_modules', 'dep.js')), {
+    code: 'ENOTDIR',
+  });
+  await assert.rejects(collect(root, { exclude: 'node_modules' }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  await assert.rejects(collect(root, { suffixes: [1] }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+})().then(common.mustCall());
@@ -0,0 +1,103 @@
+'use strict';
+// Test that fs.ReadStream with the readAhead option returns the same data as
+// without it, for whole files, ranges, FileHandles and files that grow while
+// they are read.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'read-ahead.bin');
+const data = Buffer.alloc(1000 * 1024 + 123);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 251;
+fs.writeFileSync(file, data);
+
+function readAll(stream) {
+  return new Promise((resolve, reject) => {
+    const chunks = [];
+    stream.on('data', (chunk) => chunks.push(chunk));
+    stream.on('error', reject);
+    stream.on('end', () => resolve(Buffer.concat(chunks)));
+  });
+}
+
+(async () => {
+  for (const readAhead of [1, 2, 8]) {
+    const stream = fs.createReadStream(file, {
+      highWaterMark: 64 * 1024,
+      readAhead,
+    });
+    assert.deepStrictEqual(await readAll(stream), data);
+    assert.strictEqual(stream.bytesRead, data.length);
+  }
+
+  {
+    const stream = fs.createReadStream(file, {
+      start: 1000,
+      end: 300000,
+      highWaterMark: 4096,
+      readAhead: 4,
+    });
+    assert.deepStrictEqual(await readAll(stream),
+                           data.subarray(1000, 300001));
+  }
+
+  {
+    const stream = fs.createReadStream(file, {
+      encoding: 'latin1',
+      highWaterMark: 1000,
+      readAhead: 4,
+    });
+    assert.strictEqual(await readAll(stream).then(String),
+                       data.toString('latin1'));
+  }
+
+  {
+    const handle = await fs.promises.open(file);
+    const stream = fs.createReadStream(null, {
+      fd: handle,
+      highWaterMark: 100000,
+      readAhead: 3,
+    });
+    assert.deepStrictEqual(await readAll(stream), data);
+  }
+
+  {
+    // Data appended after a short read is still returned.
+    const growing = path.join(tmpdir.path, 'growing.txt');
+    fs.writeFileSync(growing, 'abc');
+    const stream = fs.createReadStream(growing, {
+      highWaterMark: 2,
+      readAhead: 4,
+    });
+    const chunks = [];
+    stream.on('data', (chunk) => {
+      chunks.push(chunk);
+      if (chunks.length === 1)
+        fs.appendFileSync(growing, 'defgh');
+    });
+    await new Promise((resolve) => stream.on('end', resolve));
+    assert.strictEqual(Buffer.concat(chunks).toString(), 'abcdefgh');
+  }
+
+  {
+    // Destroying the stream while a read is in flight closes the fd.
+    const stream = fs.createReadStream(file, { readAhead: 4 });
+    stream.once('data', () => stream.destroy());
+    await new Promise((resolve) => stream.on('close', resolve));
+    assert.strictEqual(stream.fd, null);
+  }
+})().then(common.mustCall());
+
+assert.throws(() => fs.createReadStream(file, { readAhead: -1 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => fs.createReadStream(file, {
+  readAhead: 2,
+  fs: { open() {}, read() {}, close() {} },
+}), { code: 'ERR_INCOMPATIBLE_OPTION_PAIR' });
@@ -0,0 +1,62 @@
+'use strict';
+// Test that fs.readFile() and fsPromises.readFile() return the same data as
+// fs.readFileSync() when the whole file is read by a single request.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'readfile.txt');
+const text = 'abcé€\n'.repeat(30000);
+fs.writeFileSync(file, text);
+const expected = fs.readFileSync(file);
+
+for (const encoding of [undefined, null, 'utf8', 'UTF-8', 'latin1', 'hex']) {
+  const want = encoding ? expected.toString(encoding) : expected;
+  fs.readFile(file, { encoding }, common.mustSucceed((data) => {
+    assert.deepStrictEqual(data, want);
+  }));
+  fs.promises.readFile(file, { encoding }).then(common.mustCall((data) => {
+    assert.deepStrictEqual(data, want);
+  }));
+}
+
+{
+  // File descriptors are read from their current position and left open.
+  const fd = fs.openSync(file, 'r');
+  fs.readSync(fd, Buffer.alloc(3), 0, 3, null);
+  fs.readFile(fd, 'utf8', common.mustSucceed((data) => {
+    assert.strictEqual(data, expected.subarray(3).toString());
+    fs.fstatSync(fd);
+    fs.closeSync(fd);
+  }));
+}
+
+if (!common.isWindows) {
+  // Files without a known size are read until EOF.
+  fs.readFile('/dev/null', common.mustSucceed((data) => {
+    assert.strictEqual(data.length, 0);
+  }));
+}
+
+{
+  const missing = path.join(tmpdir.path, 'missing.txt');
+  const check = (err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.syscall, 'open');
+    assert.strictEqual(err.path, missing);
+    return true;
+  };
+  fs.readFile(missing, common.mustCall((err) => check(err)));
+  assert.rejects(fs.promises.readFile(missing), check).then(common.mustCall());
+}
+
+{
+  fs.readFile(tmpdir.path, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'EISDIR');
+  }));
+}
@@ -0,0 +1,76 @@
+'use strict';
+// Test that fs.statMany() and fsPromises.statMany() return the same stats as
+// fs.statSync() for each path, across several thread pool batches.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const paths = [];
+for (let i = 0; i < 150; i++) {
+  const file = path.join(tmpdir.path, `file-${i}`);
+  fs.writeFileSync(file, 'x'.repeat(i));
+  paths.push(file);
+}
+paths.push(tmpdir.path, Buffer.from(paths[0]), pathToFileURL(paths[1]));
+const missing = path.join(tmpdir.path, 'missing');
+
+function check(stats, bigint) {
+  assert.strictEqual(stats.length, paths.length);
+  for (let i = 0; i < paths.length; i++) {
+    const expected = fs.statSync(paths[i], { bigint });
+    assert.strictEqual(stats[i].ino, expected.ino);
+    assert.strictEqual(stats[i].size, expected.size);
+    assert.strictEqual(stats[i].mode, expected.mode);
+    assert.strictEqual(stats[i].isDirectory(), expected.isDirectory());
+  }
+}
+
+for (const bigint of [false, true]) {
+  fs.statMany(paths, { bigint }, common.mustSucceed((stats) => {
+    check(stats, bigint);
+  }));
+  fs.promises.statMany(paths, { bigint }).then(common.mustCall((stats) => {
+    check(stats, bigint);
+  }));
+}
+
+fs.statMany([], common.mustSucceed((stats) => {
+  assert.deepStrictEqual(stats, []);
+}));
+
+{
+  const check = (err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.syscall, 'stat');
+    assert.strictEqual(err.path, missing);
+    return true;
+  };
+  fs.statMany([paths[0], missing], common.mustCall(check));
+  assert.rejects(fs.promises.statMany([missing]), check)
+    .then(common.mustCall());
+
+  const options = { throwIfNoEntry: false };
+  fs.statMany([missing, paths[2]], options, common.mustSucceed((stats) => {
+    assert.strictEqual(stats[0], undefined);
+    assert.strictEqual(stats[1].size, 2);
+  }));
+  fs.promises.statMany([paths[3], missing], options)
+    .then(common.mustCall((stats) => {
+      assert.strictEqual(stats[0].size, 3);
+      assert.strictEqual(stats[1], undefined);
+    }));
+}
+
+assert.throws(() => fs.statMany('file', common.mustNotCall()), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => fs.statMany([1], common.mustNotCall()), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /paths\[0\]/
+});
@@ -0,0 +1,78 @@
+'use strict';
+// Test that recursive fs.watch() on Linux picks up directories created after
+// the watcher started, stops reporting directories moved out of the tree and
+// delivers every event of a burst through fs.promises.watch().
+
+const common = require('../common');
+
+if (!common.isLinux)
+  common.skip('the inotify tree watcher is only used on Linux');
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+{
+  const root = path.join(tmpdir.path, 'callback');
+  fs.mkdirSync(path.join(root, 'existing', 'deep'), { recursive: true });
+  const outside = path.join(tmpdir.path, 'outside');
+
+  const watcher = fs.watch(root, { recursive: true });
+  const seen = new Set();
+  let moved = false;
+  watcher.on('change', common.mustCallAtLeast((eventType, filename) => {
+    assert.ok(eventType === 'change' || eventType === 'rename');
+    assert.strictEqual(typeof filename, 'string');
+    seen.add(filename);
+
+    if (filename === path.join('existing', 'deep', 'a.txt')) {
+      // Directories created while watching are watched too, including any
+      // entries created in them before their watch was added.
+      fs.mkdirSync(path.join(root, 'new', 'nested'), { recursive: true });
+      fs.writeFileSync(path.join(root, 'new', 'nested', 'b.txt'), 'b');
+    } else if (filename === path.join('new', 'nested', 'b.txt') &&
+               !moved) {
+      moved = true;
+      fs.renameSync(path.join(root, 'new'), outside);
+      fs.writeFileSync(path.join(outside, 'nested', 'c.txt'), 'c');
+      fs.writeFileSync(path.join(root, 'last.txt'), 'd');
+    } else if (filename === 'last.txt') {
+      watcher.close();
+    }
+  }));
+  watcher.on('close', common.mustCall(() => {
+    assert(seen.has('new'));
+    assert(!seen.has(path.join('new', 'nested', 'c.txt')));
+  }));
+
+  fs.writeFileSync(path.join(root, 'existing', 'deep', 'a.txt'), 'a');
+}
+
+(async () => {
+  const root = path.join(tmpdir.path, 'promises');
+  fs.mkdirSync(root);
+  const ac = new AbortController();
+  const watcher = fs.promises.watch(root, {
+    recursive: true,
+    signal: ac.signal,
+  });
+  const names = new Set();
+  const expected = 20;
+  setImmediate(() => {
+    // Written in one go, so that the events arrive as a single batch.
+    for (let i = 0; i < expected; i++)
+      fs.writeFileSync(path.join(root, `file-${i}`), 'x');
+  });
+  await assert.rejects(async () => {
+    for await (const { eventType, filename } of watcher) {
+      assert.ok(eventType === 'change' || eventType === 'rename');
+      names.add(filename);
+      if (names.size === expected)
+        ac.abort();
+    }
+  }, { name: 'AbortError' });
+  assert.strictEqual(names.size, expected);
+})().then(common.mustCall());
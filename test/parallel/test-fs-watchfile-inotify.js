@@ -0,0 +1,96 @@
+'use strict';
+// Test that on Linux fs.watchFile() reports changes through inotify without
+// waiting for the polling interval, including for files that are created,
+// deleted and recreated, and for several files in the same directory, and
+// that links are still polled.
+
+const common = require('../common');
+
+if (!common.isLinux)
+  common.skip('inotify is only used on Linux');
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+// Much longer than the test is allowed to run, so only events can trigger
+// the listeners.
+const interval = 10 * 60 * 1000;
+
+{
+  const file = path.join(tmpdir.path, 'existing.txt');
+  fs.writeFileSync(file, 'a');
+  const other = path.join(tmpdir.path, 'other.txt');
+  fs.writeFileSync(other, 'b');
+
+  let otherChanged = false;
+  fs.watchFile(other, { interval }, () => { otherChanged = true; });
+  fs.watchFile(file, { interval }, common.mustCall((curr, prev) => {
+    assert.strictEqual(prev.size, 1);
+    assert.strictEqual(curr.size, 3);
+    fs.unwatchFile(file);
+    // Events for other files in the same directory are not reported.
+    assert.strictEqual(otherChanged, false);
+    fs.unwatchFile(other);
+  }));
+  // Let the initial stat complete before changing the file.
+  setTimeout(() => fs.appendFileSync(file, 'bc'), common.platformTimeout(100));
+}
+
+{
+  // Writes can be reported in several steps, so only look at the stats that
+  // mark the end of each step.
+  const file = path.join(tmpdir.path, 'created.txt');
+  const steps = [];
+  fs.watchFile(file, { interval }, common.mustCallAtLeast((curr) => {
+    if (curr.ino === 0 && steps.length === 1) {
+      steps.push('deleted');
+      fs.writeFileSync(file, 'recreated');
+    } else if (curr.size === 'created'.length && steps.length === 0) {
+      steps.push('created');
+      fs.unlinkSync(file);
+    } else if (curr.size === 'recreated'.length && steps.length === 2) {
+      steps.push('recreated');
+      fs.unwatchFile(file);
+    }
+  }, 3));
+  setTimeout(() => fs.writeFileSync(file, 'created'),
+             common.platformTimeout(100));
+  process.on('exit', () => {
+    assert.deepStrictEqual(steps, ['created', 'deleted', 'recreated']);
+  });
+}
+
+{
+  // Symbolic links and hard links can change without their directory
+  // reporting it, so they are polled instead.
+  const targetDir = path.join(tmpdir.path, 'targets');
+  fs.mkdirSync(targetDir);
+  const target = path.join(targetDir, 'target.txt');
+  fs.writeFileSync(target, 'a');
+  const link = path.join(tmpdir.path, 'link.txt');
+  fs.symlinkSync(target, link);
+  const hardLink = path.join(targetDir, 'hardlink.txt');
+  fs.writeFileSync(hardLink, 'a');
+  const otherName = path.join(tmpdir.path, 'hardlink.txt');
+  fs.linkSync(hardLink, otherName);
+
+  const polled = common.platformTimeout(50);
+  fs.watchFile(link, { interval: polled }, common.mustCall((curr, prev) => {
+    assert.strictEqual(prev.size, 1);
+    assert.strictEqual(curr.size, 3);
+    fs.unwatchFile(link);
+  }));
+  fs.watchFile(otherName, { interval: polled }, common.mustCall((curr, prev) => {
+    assert.strictEqual(prev.size, 1);
+    assert.strictEqual(curr.size, 3);
+    fs.unwatchFile(otherName);
+  }));
+  setTimeout(() => {
+    fs.appendFileSync(target, 'bc');
+    fs.appendFileSync(hardLink, 'bc');
+  }, common.platformTimeout(100));
+}
@@ -0,0 +1,118 @@
+'use strict';
+// Test that fs.WriteStream with the bufferSize option batches small writes
+// into the file, honours `start`, handles chunks larger than the buffer and
+// that writeStream.flushSync() writes out buffered data synchronously.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+{
+  const file = path.join(tmpdir.path, 'many.txt');
+  const stream = fs.createWriteStream(file, { bufferSize: 1024 });
+  let expected = '';
+  for (let i = 0; i < 1000; i++) {
+    const line = `line ${i}\n`;
+    expected += line;
+    stream.write(line);
+  }
+  stream.end(common.mustCall(() => {
+    assert.strictEqual(stream.bytesWritten, expected.length);
+    assert.strictEqual(fs.readFileSync(file, 'utf8'), expected);
+  }));
+}
+
+{
+  // Chunks larger than the buffer are split over several flushes.
+  const file = path.join(tmpdir.path, 'large.bin');
+  const data = Buffer.alloc(10000);
+  for (let i = 0; i < data.length; i++)
+    data[i] = i % 251;
+  const stream = fs.createWriteStream(file, { bufferSize: 100 });
+  stream.write(data.subarray(0, 5));
+  stream.write(data.subarray(5));
+  stream.end(common.mustCall(() => {
+    assert.deepStrictEqual(fs.readFileSync(file), data);
+  }));
+}
+
+{
+  const file = path.join(tmpdir.path, 'start.txt');
+  fs.writeFileSync(file, 'xxxxxxxxxx');
+  const stream = fs.createWriteStream(file, {
+    flags: 'r+',
+    start: 3,
+    bufferSize: 4,
+  });
+  stream.write('ab');
+  stream.write('cde');
+  stream.end(common.mustCall(() => {
+    assert.strictEqual(fs.readFileSync(file, 'utf8'), 'xxxabcdexx');
+  }));
+}
+
+{
+  // The interval flushes data that never fills half of the buffer.
+  const file = path.join(tmpdir.path, 'interval.txt');
+  const stream = fs.createWriteStream(file, {
+    bufferSize: 1024,
+    flushInterval: 10,
+  });
+  stream.write('tick', common.mustCall(() => {
+    setTimeout(common.mustCall(() => {
+      assert.strictEqual(fs.readFileSync(file, 'utf8'), 'tick');
+      stream.end();
+    }), common.platformTimeout(200));
+  }));
+}
+
+{
+  const file = path.join(tmpdir.path, 'sync.txt');
+  const stream = fs.createWriteStream(file, { bufferSize: 1024 });
+  stream.write('before exit', common.mustCall(() => {
+    stream.flushSync();
+    assert.strictEqual(fs.readFileSync(file, 'utf8'), 'before exit');
+    assert.strictEqual(stream.bytesWritten, 'before exit'.length);
+    stream.destroy();
+  }));
+}
+
+{
+  // Data buffered while a flush is in progress still reaches the file when
+  // the stream is destroyed, and flushSync() is rejected afterwards.
+  const file = path.join(tmpdir.path, 'destroy.txt');
+  const stream = fs.createWriteStream(file, { bufferSize: 8 });
+  stream.write('abcd', common.mustCall(() => {
+    stream.write('efg');
+    stream.destroy();
+  }));
+  stream.on('close', common.mustCall(() => {
+    assert.strictEqual(fs.readFileSync(file, 'utf8'), 'abcdefg');
+    assert.throws(() => stream.flushSync(), {
+      code: 'ERR_STREAM_DESTROYED',
+    });
+  }));
+}
+
+{
+  // Unbuffered streams accept flushSync() as well.
+  const stream = fs.createWriteStream(path.join(tmpdir.path, 'plain.txt'));
+  stream.flushSync();
+  stream.destroy();
+}
+
+assert.throws(() => fs.createWriteStream(path.join(tmpdir.path, 'x'), {
+  bufferSize: -1,
+}), { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => fs.createWriteStream(path.join(tmpdir.path, 'x'), {
+  bufferSize: 16,
+  flushInterval: 'soon',
+}), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => fs.createWriteStream(path.join(tmpdir.path, 'x'), {
+  bufferSize: 16,
+  fs: { open() {}, write() {}, close() {} },
+}), { code: 'ERR_INCOMPATIBLE_OPTION_PAIR' });
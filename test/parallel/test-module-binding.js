@@ -3,35 +3,36 @@
 require('../common');
 const fixtures = require('../common/fixtures');
 const { internalBinding } = require('internal/test/binding');
-const { internalModuleReadJSON } = internalBinding('fs');
+const { internalModuleReadPackageJSON } = internalBinding('fs');
 const { readFileSync } = require('fs');
-const { strictEqual } = require('assert');
+const { strictEqual, deepStrictEqual } = require('assert');
+
+const kContainsKeys = 1 << 0;
+const kNeedsParse = 1 << 1;
+
 {
-  const [string, containsKeys] = internalModuleReadJSON('nosuchfile');
-  strictEqual(string, undefined);
-  strictEqual(containsKeys, undefined);
+  strictEqual(internalModuleReadPackageJSON('nosuchfile'), undefined);
 }
 {
-  const [string, containsKeys] =
-    internalModuleReadJSON(fixtures.path('empty.txt'));
-  strictEqual(string, '');
-  strictEqual(containsKeys, false);
+  const [flags, , , , , , source] =
+    internalModuleReadPackageJSON(fixtures.path('empty.txt'));
+  strictEqual(flags, kNeedsParse);
+  strictEqual(source, '');
 }
 {
-  const [string, containsKeys] =
-    internalModuleReadJSON(fixtures.path('empty.txt'));
-  strictEqual(string, '');
-  strictEqual(containsKeys, false);
-}
-{
-  const [string, containsKeys] =
-    internalModuleReadJSON(fixtures.path('empty-with-bom.txt'));
-  strictEqual(string, '');
-  strictEqual(containsKeys, false);
+  const [flags, , , , , , source] =
+    internalModuleReadPackageJSON(fixtures.path('empty-with-bom.txt'));
+  strictEqual(flags, kNeedsParse);
+  strictEqual(source, '');
 }
 {
   const filename = fixtures.path('require-bin/package.json');
-  const [string, containsKeys] = internalModuleReadJSON(filename);
-  strictEqual(string, readFileSync(filename, 'utf8'));
-  strictEqual(containsKeys, true);
+  deepStrictEqual(internalModuleReadPackageJSON(filename), [
+    kContainsKeys, 'req', './lib/req.js', undefined, undefined, undefined,
+    undefined,
+  ]);
+  const [flags, , , , , , source] =
+    internalModuleReadPackageJSON(filename, true);
+  strictEqual(flags, kContainsKeys);
+  strictEqual(source, readFileSync(filename, 'utf8'));
 }
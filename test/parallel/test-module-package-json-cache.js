@@ -0,0 +1,83 @@
+'use strict';
+// Test that package.json files parsed in C++ give the same results as
+// JSON.parse() for require() and import(), including for escaped keys and
+// values, invalid files, and in worker threads.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const { Worker } = require('worker_threads');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+function writePackage(name, json, files) {
+  const dir = path.join(tmpdir.path, 'node_modules', name);
+  fs.mkdirSync(dir, { recursive: true });
+  fs.writeFileSync(path.join(dir, 'package.json'), json);
+  for (const [file, contents] of Object.entries(files))
+    fs.writeFileSync(path.join(dir, file), contents);
+  return dir;
+}
+
+writePackage('escaped', '{"m\\u0061in": "./l\\u00edb.js", "name": 1}', {
+  'líb.js': 'module.exports = "escaped";',
+});
+writePackage('exports', `{
+  "name": "exports",
+  "exports": {
+    ".": { "import": "./main.mjs", "require": "./main.cjs" },
+    "./feature": "./feature.js"
+  },
+  "imports": { "#dep": "./dep.js" }
+}`, {
+  'main.mjs': 'export default "esm";',
+  'main.cjs': 'module.exports = require("#dep");',
+  'dep.js': 'module.exports = "cjs";',
+  'feature.js': 'module.exports = "feature";',
+});
+writePackage('invalid', '{"main": "./lib.js",}', {
+  'lib.js': '',
+});
+writePackage('unrelated', '{"description": ', {
+  'index.js': 'module.exports = "index";',
+});
+
+const requireFrom = require('module').createRequire(
+  path.join(tmpdir.path, 'noop.js'));
+
+assert.strictEqual(requireFrom('escaped'), 'escaped');
+assert.strictEqual(requireFrom('exports'), 'cjs');
+assert.strictEqual(requireFrom('exports/feature'), 'feature');
+assert.throws(() => requireFrom('invalid'), (err) => {
+  assert(err instanceof SyntaxError);
+  assert.match(err.message, /^Error parsing .*package\.json: /);
+  return true;
+});
+// Files that do not mention any of the fields are ignored by require().
+assert.strictEqual(requireFrom('unrelated'), 'index');
+
+const entry = path.join(tmpdir.path, 'entry.mjs');
+fs.writeFileSync(entry, 'export { default } from "exports";');
+import(pathToFileURL(entry)).then(common.mustCall(({ default: esm }) => {
+  assert.strictEqual(esm, 'esm');
+}));
+
+assert.rejects(
+  import(pathToFileURL(
+    path.join(tmpdir.path, 'node_modules', 'invalid', 'lib.js'))),
+  { code: 'ERR_INVALID_PACKAGE_CONFIG' }
+).then(common.mustCall());
+
+// Workers read the files cached by the main thread.
+const worker = new Worker(`
+  const { parentPort } = require('worker_threads');
+  const requireFrom = require('module').createRequire(${
+  JSON.stringify(path.join(tmpdir.path, 'noop.js'))});
+  parentPort.postMessage([requireFrom('escaped'), requireFrom('exports')]);
+`, { eval: true });
+worker.on('message', common.mustCall((message) => {
+  assert.deepStrictEqual(message, ['escaped', 'cjs']);
+}));
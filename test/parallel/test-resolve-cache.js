@@ -0,0 +1,90 @@
+'use strict';
+// Test that NODE_RESOLVE_CACHE persists the results of CommonJS resolution,
+// that later processes use them, and that entries are dropped when the
+// directories they depend on change.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+// Keep the cache out of the directories that the entries depend on, since
+// writing it would otherwise invalidate them.
+const cacheFile = path.join(tmpdir.path, 'cache', 'resolve-cache.json');
+const nodeModules = path.join(tmpdir.path, 'node_modules');
+const pkg = path.join(nodeModules, 'pkg');
+const main = path.join(tmpdir.path, 'main.js');
+fs.mkdirSync(pkg, { recursive: true });
+fs.mkdirSync(path.dirname(cacheFile));
+fs.writeFileSync(path.join(pkg, 'index.js'), 'module.exports = "index";');
+fs.writeFileSync(path.join(pkg, 'other.js'), 'module.exports = "other";');
+fs.writeFileSync(path.join(tmpdir.path, 'dep.js'), 'module.exports = "dep";');
+// Results taken from the cache are also stored in Module._pathCache.
+fs.writeFileSync(main, `
+  const result = [require('pkg'), require('./dep')];
+  const { _pathCache } = require('module');
+  const cached = Object.values(_pathCache).includes(module.children[0].filename);
+  console.log(JSON.stringify([...result, cached]));
+`);
+
+function run(args = []) {
+  const child = spawnSync(process.execPath, [...args, main], {
+    env: { ...process.env, NODE_RESOLVE_CACHE: cacheFile },
+    encoding: 'utf8',
+  });
+  assert.strictEqual(child.status, 0, child.stderr);
+  return JSON.parse(child.stdout);
+}
+
+function readCache() {
+  return JSON.parse(fs.readFileSync(cacheFile, 'utf8'));
+}
+
+function findEntry(cache, request) {
+  return cache.entries.find((entry) => entry[0] === request);
+}
+
+assert.deepStrictEqual(run(), ['index', 'dep', true]);
+{
+  const cache = readCache();
+  assert.strictEqual(findEntry(cache, 'pkg')[2],
+                     fs.realpathSync(path.join(pkg, 'index.js')));
+  assert(findEntry(cache, './dep'));
+
+  // Later processes take the file name from the cache instead of resolving
+  // the request again.
+  findEntry(cache, 'pkg')[2] = fs.realpathSync(path.join(pkg, 'other.js'));
+  fs.writeFileSync(cacheFile, JSON.stringify(cache));
+  assert.deepStrictEqual(run(), ['other', 'dep', true]);
+}
+
+{
+  // Entries are dropped once a directory they depend on has changed. Bump
+  // the time stamps explicitly so that this does not depend on the
+  // resolution of the file system clock.
+  fs.writeFileSync(path.join(nodeModules, 'pkg.js'), 'module.exports = "js";');
+  const future = new Date(Date.now() + 60 * 1000);
+  fs.utimesSync(nodeModules, future, future);
+  assert.deepStrictEqual(run(), ['js', 'dep', true]);
+  assert.strictEqual(findEntry(readCache(), 'pkg')[2],
+                     fs.realpathSync(path.join(nodeModules, 'pkg.js')));
+}
+
+{
+  // Caches written with different resolution options are ignored.
+  const cache = readCache();
+  findEntry(cache, 'pkg')[2] = fs.realpathSync(path.join(pkg, 'other.js'));
+  fs.writeFileSync(cacheFile, JSON.stringify(cache));
+  assert.deepStrictEqual(run(['--preserve-symlinks']), ['js', 'dep', true]);
+}
+
+{
+  // Corrupted caches are ignored and replaced.
+  fs.writeFileSync(cacheFile, '{');
+  assert.deepStrictEqual(run(), ['js', 'dep', true]);
+  assert(findEntry(readCache(), 'pkg'));
+}
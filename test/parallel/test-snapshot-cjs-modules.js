@@ -0,0 +1,62 @@
+'use strict';
+
+// This tests that user-land CommonJS modules that are loaded while building
+// the snapshot are included in it, and that ES modules are rejected.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../common/tmpdir');
+const fixtures = require('../common/fixtures');
+const path = require('path');
+const fs = require('fs');
+
+tmpdir.refresh();
+const blobPath = path.join(tmpdir.path, 'snapshot.blob');
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob',
+    blobPath,
+    '--build-snapshot',
+    fixtures.path('snapshot', 'cjs-graph.js'),
+  ], {
+    cwd: tmpdir.path
+  });
+  if (child.status !== 0) {
+    console.log(child.stderr.toString());
+    console.log(child.stdout.toString());
+    assert.strictEqual(child.status, 0);
+  }
+  const stats = fs.statSync(blobPath);
+  assert(stats.isFile());
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob',
+    blobPath,
+  ], {
+    cwd: tmpdir.path
+  });
+  if (child.status !== 0) {
+    console.log(child.stderr.toString());
+    console.log(child.stdout.toString());
+    assert.strictEqual(child.status, 0);
+  }
+  assert.strictEqual(child.stdout.toString().trim(), 'abc');
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob',
+    path.join(tmpdir.path, 'esm.blob'),
+    '--build-snapshot',
+    fixtures.path('snapshot', 'esm-graph.js'),
+  ], {
+    cwd: tmpdir.path
+  });
+  assert.notStrictEqual(child.status, 0);
+  assert.match(child.stderr.toString(),
+               /ES modules are not yet supported in the snapshot/);
+}
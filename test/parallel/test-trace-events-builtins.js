@@ -0,0 +1,52 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// This tests that the node.builtins category records the compilation of
+// built-in modules, including the ones that are only loaded lazily. The
+// children do not load test/common, which touches the web stream globals.
+
+tmpdir.refresh();
+
+function getCompiledIds(name, script) {
+  const cwd = path.join(tmpdir.path, name);
+  fs.mkdirSync(cwd);
+  const { status, pid, stderr } = cp.spawnSync(process.execPath, [
+    '--trace-event-categories', 'node.builtins', '-e', script,
+  ], { cwd, encoding: 'utf8' });
+  assert.strictEqual(status, 0, stderr);
+
+  const file = path.join(cwd, 'node_trace.1.log');
+  const traces = JSON.parse(fs.readFileSync(file, 'utf8')).traceEvents
+    .filter((trace) => trace.cat !== '__metadata');
+  const begins = traces.filter((trace) => trace.ph === 'B');
+  const ends = traces.filter((trace) => trace.ph === 'E');
+  assert.strictEqual(begins.length, ends.length);
+  traces.forEach((trace) => {
+    assert.strictEqual(trace.pid, pid);
+    assert.strictEqual(trace.cat, 'node,node.builtins');
+    assert.strictEqual(trace.name, 'BuiltinLoader::Compile');
+  });
+  ends.forEach((trace) => {
+    assert(['none', 'accepted', 'rejected'].includes(trace.args.code_cache));
+  });
+  return begins.map((trace) => trace.args.id);
+}
+
+{
+  // The web stream globals are only loaded on first access.
+  const ids = getCompiledIds('lazy', 'globalThis.CompressionStream');
+  assert(ids.includes('internal/webstreams/compression'), ids);
+  assert(!ids.includes('stream/web'), ids);
+}
+
+{
+  const ids = getCompiledIds('untouched', '0');
+  assert(ids.length > 0);
+  const webstreams = ids.filter((id) => id.startsWith('internal/webstreams/'));
+  assert.deepStrictEqual(webstreams, []);
+}
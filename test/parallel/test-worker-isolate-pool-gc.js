@@ -0,0 +1,31 @@
+// Flags: --expose-gc
+'use strict';
+const common = require('../common');
+const { Worker, WorkerIsolatePool } = require('worker_threads');
+
+// This tests that pools that are not referenced anymore, whether they were
+// closed or not, and while a Worker still runs on them, can be garbage
+// collected or are cleaned up when the process exits.
+
+function createPool() {
+  new WorkerIsolatePool(2);
+}
+
+function runClosedPool() {
+  const pool = new WorkerIsolatePool(2);
+  const worker = new Worker(`
+    require('worker_threads').parentPort.once('message', () => {});
+  `, { eval: true, pool });
+  pool.close();
+  worker.once('online', common.mustCall(() => {
+    global.gc();
+    worker.postMessage('exit');
+  }));
+  worker.once('exit', common.mustCall(() => {
+    setImmediate(() => global.gc());
+  }));
+}
+
+createPool();
+global.gc();
+runClosedPool();
@@ -0,0 +1,69 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker, WorkerIsolatePool } = require('worker_threads');
+const { getWorkerIsolatePoolStats } = require('internal/worker');
+
+// This tests that Workers actually run on the thread of a WorkerIsolatePool,
+// and that its isolate is only reused after a Worker exited cleanly.
+
+const pool = new WorkerIsolatePool(1);
+
+// Each step runs a Worker once the pool thread is idle, and lists the stats
+// of the pool after that Worker has exited.
+const steps = [
+  // Runs on the isolate that was created ahead of time.
+  { source: 'process.exit(0)', exitCode: 0,
+    stats: { isolatesCreated: 1, workersRun: 1, isolatesReused: 0 } },
+  // Reuses the isolate, because the previous Worker exited with code 0.
+  { source: 'setInterval(() => {}, 1000)', terminate: true, exitCode: 1,
+    stats: { isolatesCreated: 1, workersRun: 2, isolatesReused: 1 } },
+  // Reuses the isolate, because the previous Worker was terminated. A new
+  // isolate is created for the next one.
+  { source: 'process.exit(1)', exitCode: 1,
+    stats: { isolatesCreated: 2, workersRun: 3, isolatesReused: 2 } },
+  // Runs on a new isolate. Another one is created for the next Worker.
+  { source: 'throw new Error("foo")', exitCode: 1, error: true,
+    stats: { isolatesCreated: 3, workersRun: 4, isolatesReused: 2 } },
+  // Runs on a new isolate.
+  { source: '', exitCode: 0,
+    stats: { isolatesCreated: 3, workersRun: 5, isolatesReused: 2 } },
+];
+
+function whenIdle(callback) {
+  if (getWorkerIsolatePoolStats(pool).idleThreads === 1) {
+    callback();
+  } else {
+    setTimeout(whenIdle, 10, callback);
+  }
+}
+
+function runStep(i) {
+  if (i === steps.length) {
+    pool.close();
+    return;
+  }
+  const { source, terminate, exitCode, error, stats } = steps[i];
+  const worker = new Worker(source, { eval: true, pool });
+  if (terminate) worker.once('online', () => worker.terminate());
+  if (error) worker.once('error', common.mustCall());
+  worker.once('exit', common.mustCall((code) => {
+    assert.strictEqual(code, exitCode);
+    whenIdle(common.mustCall(() => {
+      assert.deepStrictEqual(getWorkerIsolatePoolStats(pool),
+                             { idleThreads: 1, ...stats });
+      runStep(i + 1);
+    }));
+  }));
+}
+
+whenIdle(common.mustCall(() => {
+  assert.deepStrictEqual(getWorkerIsolatePoolStats(pool), {
+    idleThreads: 1,
+    isolatesCreated: 1,
+    workersRun: 0,
+    isolatesReused: 0,
+  });
+  runStep(0);
+}));
@@ -0,0 +1,54 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker, WorkerIsolatePool } = require('worker_threads');
+
+// This tests that Workers can run on the threads of a WorkerIsolatePool, and
+// that the isolates that are reused do not leak state between Workers.
+
+assert.throws(() => new WorkerIsolatePool(0), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => new Worker('', { eval: true, pool: {} }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+const pool = new WorkerIsolatePool(2);
+
+const source = `
+  const { parentPort, resourceLimits } = require('worker_threads');
+  parentPort.postMessage({
+    leaked: typeof globalThis.leaked,
+    stackSizeMb: resourceLimits.stackSizeMb,
+  });
+  globalThis.leaked = true;
+  parentPort.once('message', () => process.exit(0));
+`;
+
+function runWorker(i, options = {}) {
+  if (i === 10) {
+    pool.close();
+    // Workers still start after the pool was closed.
+    return runWorker(-1);
+  }
+  const worker = new Worker(source, { eval: true, pool, ...options });
+  worker.once('message', common.mustCall((message) => {
+    assert.deepStrictEqual(message, {
+      leaked: 'undefined',
+      stackSizeMb: options.resourceLimits?.stackSizeMb ?? 4,
+    });
+    if (i % 2 === 0) {
+      worker.postMessage('exit');
+    } else {
+      worker.terminate();
+    }
+  }));
+  worker.once('exit', common.mustCall(() => {
+    if (i < 0) return;
+    // Workers with resource limits do not run on the pool.
+    const resourceLimits = i === 4 ? { stackSizeMb: 8 } : undefined;
+    runWorker(i + 1, { resourceLimits });
+  }));
+}
+
+runWorker(0);
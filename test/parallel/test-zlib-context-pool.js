@@ -0,0 +1,82 @@
+// Flags: --expose-internals
+'use strict';
+// Test that deflate states of closed streams are reused by later streams
+// with the same parameters, without affecting their output.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+const { internalBinding } = require('internal/test/binding');
+const { getContextPoolInfo } = internalBinding('zlib');
+
+const input = Buffer.from('hello world '.repeat(1000));
+const dictionary = Buffer.from('hello world ');
+
+{
+  const [hits, misses] = getContextPoolInfo();
+  const expected = zlib.gzipSync(input);
+  for (let i = 0; i < 10; i++)
+    assert.deepStrictEqual(zlib.gzipSync(input), expected);
+  const info = getContextPoolInfo();
+  assert.strictEqual(info[0] - hits, 10);
+  assert.strictEqual(info[1] - misses, 1);
+}
+
+{
+  // A reused state must apply the dictionary of the new stream.
+  const opts = { dictionary, level: 3 };
+  const expected = zlib.deflateRawSync(input, opts);
+  const [hits] = getContextPoolInfo();
+  assert.deepStrictEqual(zlib.deflateRawSync(input, opts), expected);
+  assert.strictEqual(getContextPoolInfo()[0] - hits, 1);
+  assert.deepStrictEqual(zlib.inflateRawSync(expected, opts), input);
+  assert.deepStrictEqual(
+    zlib.inflateRawSync(zlib.deflateRawSync(input, { level: 3 })), input);
+}
+
+{
+  // Decompression streams are not pooled.
+  const compressed = zlib.gzipSync(input);
+  const before = getContextPoolInfo();
+  zlib.gunzipSync(compressed);
+  zlib.unzipSync(compressed);
+  assert.deepStrictEqual(getContextPoolInfo(), before);
+}
+
+{
+  // The pool is bounded.
+  for (let level = 0; level <= 9; level++) {
+    for (const strategy of [zlib.constants.Z_DEFAULT_STRATEGY,
+                            zlib.constants.Z_FILTERED]) {
+      zlib.deflateSync(input, { level, strategy });
+    }
+  }
+  const [, , evictions, size] = getContextPoolInfo();
+  assert(evictions > 0);
+  assert.strictEqual(size, 16);
+}
+
+{
+  // A state that is in use by a write is not returned to the pool.
+  zlib.gzipSync(input);
+  const [, , , size] = getContextPoolInfo();
+  const gzip = zlib.createGzip();
+  gzip.write(input);
+  gzip.close();
+  assert.strictEqual(getContextPoolInfo()[3], size - 1);
+}
+
+{
+  // params() is not applied to gzip streams, so their state must not be
+  // handed out as one with the new parameters.
+  const expected = zlib.gzipSync(input, { level: 1 });
+  const gzip = zlib.createGzip();
+  gzip.params(1, zlib.constants.Z_DEFAULT_STRATEGY, common.mustCall(() => {
+    gzip.end(input);
+    gzip.resume();
+  }));
+  gzip.on('close', common.mustCall(() => {
+    for (let i = 0; i < 3; i++)
+      assert.deepStrictEqual(zlib.gzipSync(input, { level: 1 }), expected);
+  }));
+}
@@ -306,7 +306,7 @@ assert.throws(
     code: 'ERR_INVALID_ARG_TYPE',
     name: 'TypeError',
     message: 'The "options.dictionary" property must be an instance of Buffer' +
-             ', TypedArray, DataView, or ArrayBuffer. Received type string ' +
-             "('not a buffer')"
+             ', TypedArray, DataView, ArrayBuffer, or ZlibDictionary. ' +
+             "Received type string ('not a buffer')"
   }
 );
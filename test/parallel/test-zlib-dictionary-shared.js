@@ -0,0 +1,63 @@
+'use strict';
+// Test that dictionaries created through zlib.createDictionary() produce the
+// same results as passing the dictionary contents to every stream.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const dictionaryData = Buffer.from(JSON.stringify({
+  id: 0, name: '', email: '', created_at: '', tags: [], active: false,
+}));
+const dictionary = zlib.createDictionary(dictionaryData);
+assert.strictEqual(dictionary.byteLength, dictionaryData.length);
+
+const input = Buffer.from(JSON.stringify({
+  id: 42, name: 'someone', email: 'someone@example.com',
+  created_at: '2022-01-01T00:00:00Z', tags: ['a', 'b'], active: true,
+}));
+
+for (const [deflate, inflate] of [
+  [zlib.deflateSync, zlib.inflateSync],
+  [zlib.deflateRawSync, zlib.inflateRawSync],
+]) {
+  // More parameter sets than the number of primed states that are kept.
+  for (let level = 1; level <= 9; level++) {
+    const expected = deflate(input, { level, dictionary: dictionaryData });
+    for (let i = 0; i < 3; i++) {
+      const actual = deflate(input, { level, dictionary });
+      assert.deepStrictEqual(actual, expected);
+      assert.deepStrictEqual(inflate(actual, { dictionary }), input);
+      assert.deepStrictEqual(
+        inflate(actual, { dictionary: dictionaryData }), input);
+    }
+  }
+}
+
+// Streams that use the same dictionary concurrently on the threadpool.
+for (let i = 0; i < 20; i++) {
+  zlib.deflate(input, { dictionary }, common.mustSucceed((compressed) => {
+    assert.deepStrictEqual(
+      zlib.inflateSync(compressed, { dictionary: dictionaryData }), input);
+  }));
+}
+
+// Resetting a stream applies the dictionary again.
+{
+  const deflate = zlib.createDeflate({ dictionary });
+  deflate.reset();
+  deflate.end(input);
+  const chunks = [];
+  deflate.on('data', (chunk) => chunks.push(chunk));
+  deflate.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(
+      zlib.inflateSync(Buffer.concat(chunks), { dictionary }), input);
+  }));
+}
+
+assert.throws(() => zlib.createDictionary('not a buffer'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => zlib.inflateSync(zlib.deflateSync(input, { dictionary })), {
+  code: 'Z_NEED_DICT',
+});
@@ -0,0 +1,70 @@
+// Flags: --expose-internals
+'use strict';
+// Test that small asynchronous writes may be processed on the main thread,
+// while large ones are handed to the thread pool, without changing the
+// output or the asynchronous completion of write callbacks.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+const { internalBinding } = require('internal/test/binding');
+const { getWorkHistograms } = internalBinding('zlib');
+
+const [inlineWork, offloadedWork] = getWorkHistograms();
+const input = Buffer.from('abcdefghij'.repeat(10000));
+
+{
+  // The first small write of a stream is always processed inline.
+  const count = inlineWork.count();
+  const deflate = zlib.createDeflate();
+  let completed = false;
+  deflate.write(input.subarray(0, 100), common.mustCall(() => {
+    completed = true;
+    assert(inlineWork.count() > count);
+    deflate.end();
+  }));
+  assert.strictEqual(completed, false);
+  deflate.resume();
+}
+
+{
+  // Writes above the size limit always go to the thread pool.
+  const count = offloadedWork.count();
+  zlib.deflate(input, common.mustSucceed((compressed) => {
+    assert(offloadedWork.count() > count);
+    assert.deepStrictEqual(zlib.inflateSync(compressed), input);
+  }));
+}
+
+{
+  // Brotli writes, and zlib writes that flush the stream, compress an
+  // unknown amount of buffered data and always go to the thread pool.
+  // Inline writes are processed within write(), so this can be checked
+  // synchronously.
+  const count = inlineWork.count();
+  const brotli = zlib.createBrotliCompress();
+  brotli.write(input.subarray(0, 100), common.mustCall());
+  const deflate = zlib.createDeflate();
+  deflate.flush(common.mustCall());
+  assert.strictEqual(inlineWork.count(), count);
+  brotli.end();
+  brotli.resume();
+  deflate.end();
+  deflate.resume();
+}
+
+for (const [compress, decompress] of [
+  [zlib.createGzip, zlib.gunzipSync],
+  [zlib.createBrotliCompress, zlib.brotliDecompressSync],
+]) {
+  // Mixed chunk sizes round-trip regardless of where they were processed.
+  const stream = compress();
+  const out = [];
+  stream.on('data', (chunk) => out.push(chunk));
+  stream.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(decompress(Buffer.concat(out)), input);
+  }));
+  for (let i = 0, size = 1; i < input.length; i += size, size *= 2)
+    stream.write(input.subarray(i, i + size));
+  stream.end();
+}
@@ -0,0 +1,88 @@
+'use strict';
+// Test that zlib.createGzip({ parallel }) produces a single, valid gzip
+// member regardless of how the input is split into blocks.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+const { pipeline, Readable } = require('stream');
+
+function compress(input, opts, chunkSize, callback) {
+  const chunks = [];
+  for (let i = 0; i < input.length; i += chunkSize)
+    chunks.push(input.subarray(i, i + chunkSize));
+  const gzip = zlib.createGzip(opts);
+  const out = [];
+  gzip.on('data', (chunk) => out.push(chunk));
+  pipeline(Readable.from(chunks), gzip, common.mustSucceed(() => {
+    assert.strictEqual(gzip.bytesWritten, input.length);
+    callback(Buffer.concat(out));
+  }));
+}
+
+const lines = [];
+for (let i = 0; i < 50000; i++)
+  lines.push(`${i} ${i % 13} ${'x'.repeat(i % 31)}\n`);
+const text = Buffer.from(lines.join(''));
+// Poorly compressible input, generated with a xorshift PRNG.
+const random = Buffer.alloc(300 * 1024);
+for (let i = 0, x = 0x2545f491; i < random.length; i++) {
+  x ^= x << 13;
+  x ^= x >>> 17;
+  x ^= x << 5;
+  random[i] = x & 0xff;
+}
+
+for (const [input, opts, chunkSize] of [
+  [text, { parallel: 4 }, 64 * 1024],
+  [text, { parallel: 2, level: 1 }, 1000],
+  [text, { parallel: 3, level: 9, windowBits: 12 }, 200 * 1024],
+  [random, { parallel: 4 }, 16 * 1024],
+  [random, { parallel: 2, level: 0 }, 128 * 1024],
+  // Small memLevels expand incompressible blocks beyond compressBound().
+  [random, { parallel: 2, memLevel: 1 }, 128 * 1024],
+  [Buffer.alloc(0), { parallel: 4 }, 1],
+]) {
+  compress(input, opts, chunkSize, common.mustCall((compressed) => {
+    assert.strictEqual(compressed[0], 0x1f);
+    assert.strictEqual(compressed[1], 0x8b);
+    assert.deepStrictEqual(zlib.gunzipSync(compressed), input);
+  }));
+}
+
+{
+  // Flushing emits everything written so far in a decodable form.
+  const gzip = zlib.createGzip({ parallel: 2 });
+  const first = text.subarray(0, 200 * 1024);
+  gzip.write(first);
+  gzip.flush(common.mustCall(() => {
+    const out = [];
+    let chunk;
+    while ((chunk = gzip.read()) !== null)
+      out.push(chunk);
+    const partial = zlib.gunzipSync(Buffer.concat(out), {
+      finishFlush: zlib.constants.Z_SYNC_FLUSH
+    });
+    assert.deepStrictEqual(partial, first);
+    gzip.destroy();
+  }));
+}
+
+{
+  const gzip = zlib.createGzip({ parallel: 4 });
+  assert(gzip instanceof zlib.Gzip);
+  assert.throws(() => gzip.params(1, 0, () => {}), {
+    code: 'ERR_METHOD_NOT_IMPLEMENTED'
+  });
+  gzip.destroy();
+
+  const serial = zlib.createGzip({ parallel: 1 });
+  assert.notStrictEqual(serial._handle, null);
+  serial.close();
+
+  for (const parallel of [0, -1, 1.5, '4', NaN]) {
+    assert.throws(() => zlib.createGzip({ parallel }), {
+      code: /ERR_OUT_OF_RANGE|ERR_INVALID_ARG_TYPE/
+    });
+  }
+}
@@ -328,3 +328,11 @@ if (process.features.inspector && common.isMainThread) {
   const handle = dirBinding.opendir('./', 'utf8', undefined, {});
   testInitialized(handle, 'DirHandle');
 }
+
+// DIRWALKER
+{
+  const dirBinding = internalBinding('fs_dir');
+  const walker = new dirBinding.DirWalker('./', [], []);
+  testInitialized(walker, 'DirWalker');
+  walker.close();
+}
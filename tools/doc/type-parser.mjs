@@ -223,6 +223,7 @@ const customTypesMap = {
 
   'MessagePort': 'worker_threads.html#class-messageport',
   'Worker': 'worker_threads.html#class-worker',
+  'WorkerIsolatePool': 'worker_threads.html#class-workerisolatepool',
 
   'X509Certificate': 'crypto.html#class-x509certificate',
 
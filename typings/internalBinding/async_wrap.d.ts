@@ -13,62 +13,63 @@ declare namespace InternalAsyncWrapBinding {
   interface Providers {
     NONE: 0;
     DIRHANDLE: 1;
-    DNSCHANNEL: 2;
-    ELDHISTOGRAM: 3;
-    FILEHANDLE: 4;
-    FILEHANDLECLOSEREQ: 5;
-    FIXEDSIZEBLOBCOPY: 6;
-    FSEVENTWRAP: 7;
-    FSREQCALLBACK: 8;
-    FSREQPROMISE: 9;
-    GETADDRINFOREQWRAP: 10;
-    GETNAMEINFOREQWRAP: 11;
-    HEAPSNAPSHOT: 12;
-    HTTP2SESSION: 13;
-    HTTP2STREAM: 14;
-    HTTP2PING: 15;
-    HTTP2SETTINGS: 16;
-    HTTPINCOMINGMESSAGE: 17;
-    HTTPCLIENTREQUEST: 18;
-    JSSTREAM: 19;
-    JSUDPWRAP: 20;
-    MESSAGEPORT: 21;
-    PIPECONNECTWRAP: 22;
-    PIPESERVERWRAP: 23;
-    PIPEWRAP: 24;
-    PROCESSWRAP: 25;
-    PROMISE: 26;
-    QUERYWRAP: 27;
-    SHUTDOWNWRAP: 28;
-    SIGNALWRAP: 29;
-    STATWATCHER: 30;
-    STREAMPIPE: 31;
-    TCPCONNECTWRAP: 32;
-    TCPSERVERWRAP: 33;
-    TCPWRAP: 34;
-    TTYWRAP: 35;
-    UDPSENDWRAP: 36;
-    UDPWRAP: 37;
-    SIGINTWATCHDOG: 38;
-    WORKER: 39;
-    WORKERHEAPSNAPSHOT: 40;
-    WRITEWRAP: 41;
-    ZLIB: 42;
-    CHECKPRIMEREQUEST: 43;
-    PBKDF2REQUEST: 44;
-    KEYPAIRGENREQUEST: 45;
-    KEYGENREQUEST: 46;
-    KEYEXPORTREQUEST: 47;
-    CIPHERREQUEST: 48;
-    DERIVEBITSREQUEST: 49;
-    HASHREQUEST: 50;
-    RANDOMBYTESREQUEST: 51;
-    RANDOMPRIMEREQUEST: 52;
-    SCRYPTREQUEST: 53;
-    SIGNREQUEST: 54;
-    TLSWRAP: 55;
-    VERIFYREQUEST: 56;
-    INSPECTORJSBINDING: 57;
+    DIRWALKER: 2;
+    DNSCHANNEL: 3;
+    ELDHISTOGRAM: 4;
+    FILEHANDLE: 5;
+    FILEHANDLECLOSEREQ: 6;
+    FIXEDSIZEBLOBCOPY: 7;
+    FSEVENTWRAP: 8;
+    FSREQCALLBACK: 9;
+    FSREQPROMISE: 10;
+    GETADDRINFOREQWRAP: 11;
+    GETNAMEINFOREQWRAP: 12;
+    HEAPSNAPSHOT: 13;
+    HTTP2SESSION: 14;
+    HTTP2STREAM: 15;
+    HTTP2PING: 16;
+    HTTP2SETTINGS: 17;
+    HTTPINCOMINGMESSAGE: 18;
+    HTTPCLIENTREQUEST: 19;
+    JSSTREAM: 20;
+    JSUDPWRAP: 21;
+    MESSAGEPORT: 22;
+    PIPECONNECTWRAP: 23;
+    PIPESERVERWRAP: 24;
+    PIPEWRAP: 25;
+    PROCESSWRAP: 26;
+    PROMISE: 27;
+    QUERYWRAP: 28;
+    SHUTDOWNWRAP: 29;
+    SIGNALWRAP: 30;
+    STATWATCHER: 31;
+    STREAMPIPE: 32;
+    TCPCONNECTWRAP: 33;
+    TCPSERVERWRAP: 34;
+    TCPWRAP: 35;
+    TTYWRAP: 36;
+    UDPSENDWRAP: 37;
+    UDPWRAP: 38;
+    SIGINTWATCHDOG: 39;
+    WORKER: 40;
+    WORKERHEAPSNAPSHOT: 41;
+    WRITEWRAP: 42;
+    ZLIB: 43;
+    CHECKPRIMEREQUEST: 44;
+    PBKDF2REQUEST: 45;
+    KEYPAIRGENREQUEST: 46;
+    KEYGENREQUEST: 47;
+    KEYEXPORTREQUEST: 48;
+    CIPHERREQUEST: 49;
+    DERIVEBITSREQUEST: 50;
+    HASHREQUEST: 51;
+    RANDOMBYTESREQUEST: 52;
+    RANDOMPRIMEREQUEST: 53;
+    SCRYPTREQUEST: 54;
+    SIGNREQUEST: 55;
+    TLSWRAP: 56;
+    VERIFYREQUEST: 57;
+    INSPECTORJSBINDING: 58;
   }
 }
 
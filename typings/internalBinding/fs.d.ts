@@ -43,8 +43,16 @@ declare namespace InternalFSBinding {
     stream: Stream;
   }
 
+  class FileSink {
+    constructor(fd: number, capacity: number, position: number);
+    write(chunk: Buffer): number;
+    flush(req: FSReqCallback<number>): void;
+    flushSync(ctx: FSSyncContext): number;
+    buffered(): number;
+  }
+
   class StatWatcher {
-    constructor(useBigint: boolean);
+    constructor(useBigint: boolean, path?: string);
     initialized: boolean;
     start(path: string, interval: number): number;
     getAsyncId(): number;
@@ -107,7 +115,15 @@ declare namespace InternalFSBinding {
   function futimes(fd: number, atime: number, mtime: number, req: undefined, ctx: FSSyncContext): void;
   function futimes(fd: number, atime: number, mtime: number, usePromises: typeof kUsePromises): Promise<void>;
 
-  function internalModuleReadJSON(path: string): [] | [string, boolean];
+  function internalModuleReadPackageJSON(path: string, includeSource?: boolean): undefined | [
+    flags: number,
+    name: string | undefined,
+    main: string | undefined,
+    type: string | undefined,
+    exports: string | undefined,
+    imports: string | undefined,
+    source: string | undefined,
+  ];
   function internalModuleStat(path: string): number;
   
   function lchown(path: string, uid: number, gid: number, req: FSReqCallback): void;
@@ -136,6 +152,8 @@ declare namespace InternalFSBinding {
   function mkdtemp(prefix: string, encoding: unknown, req: undefined, ctx: FSSyncContext): string;
   function mkdtemp(prefix: string, encoding: unknown, usePromises: typeof kUsePromises): Promise<string>;
 
+  function mmap(fd: number, offset: number, length: number, writable: boolean, shared: boolean, advice: number, ctx: FSSyncContext): Buffer;
+
   function mkdir(path: string, mode: number, recursive: boolean, req: FSReqCallback<void | string>): void;
   function mkdir(path: string, mode: number, recursive: true, req: FSReqCallback<string>): void;
   function mkdir(path: string, mode: number, recursive: false, req: FSReqCallback<void>): void;
@@ -159,6 +177,14 @@ declare namespace InternalFSBinding {
   function readBuffers(fd: number, buffers: ArrayBufferView[], position: number, req: undefined, ctx: FSSyncContext): number;
   function readBuffers(fd: number, buffers: ArrayBufferView[], position: number, usePromises: typeof kUsePromises): Promise<number>;
 
+  function readFileBuffer(path: StringOrBuffer | number, flags: number, req: FSReqCallback<Buffer | number>): void;
+  function readFileBuffer(path: StringOrBuffer | number, flags: number, usePromises: typeof kUsePromises): Promise<Buffer | number>;
+
+  function readFileUtf8(path: StringOrBuffer | number, flags: number, req: FSReqCallback<string | number>): void;
+  function readFileUtf8(path: StringOrBuffer | number, flags: number, usePromises: typeof kUsePromises): Promise<string | number>;
+
+  function adviseSequential(fd: number, offset: number, length: number): void;
+
   function readdir(path: StringOrBuffer, encoding: unknown, withFileTypes: boolean, req: FSReqCallback<string[] | [string[], number[]]>): void;
   function readdir(path: StringOrBuffer, encoding: unknown, withFileTypes: true, req: FSReqCallback<[string[], number[]]>): void;
   function readdir(path: StringOrBuffer, encoding: unknown, withFileTypes: false, req: FSReqCallback<string[]>): void;
@@ -195,6 +221,9 @@ declare namespace InternalFSBinding {
   function stat(path: StringOrBuffer, useBigint: true, usePromises: typeof kUsePromises): Promise<BigUint64Array>;
   function stat(path: StringOrBuffer, useBigint: false, usePromises: typeof kUsePromises): Promise<Float64Array>;
 
+  function statMany(paths: StringOrBuffer[], useBigint: boolean, req: FSReqCallback<[Float64Array | BigUint64Array, Int32Array]>): void;
+  function statMany(paths: StringOrBuffer[], useBigint: boolean, usePromises: typeof kUsePromises): Promise<[Float64Array | BigUint64Array, Int32Array]>;
+
   function symlink(target: StringOrBuffer, path: StringOrBuffer, type: number, req: FSReqCallback): void;
   function symlink(target: StringOrBuffer, path: StringOrBuffer, type: number, req: undefined, ctx: FSSyncContext): void;
   function symlink(target: StringOrBuffer, path: StringOrBuffer, type: number, usePromises: typeof kUsePromises): Promise<void>;
@@ -224,6 +253,7 @@ declare function InternalBinding(binding: 'fs'): {
   FSReqCallback: typeof InternalFSBinding.FSReqCallback;
 
   FileHandle: typeof InternalFSBinding.FileHandle;
+  FileSink: typeof InternalFSBinding.FileSink;
 
   kUsePromises: typeof InternalFSBinding.kUsePromises;
 
@@ -245,7 +275,7 @@ declare function InternalBinding(binding: 'fs'): {
   fsync: typeof InternalFSBinding.fsync;
   ftruncate: typeof InternalFSBinding.ftruncate;
   futimes: typeof InternalFSBinding.futimes;
-  internalModuleReadJSON: typeof InternalFSBinding.internalModuleReadJSON;
+  internalModuleReadPackageJSON: typeof InternalFSBinding.internalModuleReadPackageJSON;
   internalModuleStat: typeof InternalFSBinding.internalModuleStat;
   lchown: typeof InternalFSBinding.lchown;
   link: typeof InternalFSBinding.link;
@@ -257,6 +287,7 @@ declare function InternalBinding(binding: 'fs'): {
   openFileHandle: typeof InternalFSBinding.openFileHandle;
   read: typeof InternalFSBinding.read;
   readBuffers: typeof InternalFSBinding.readBuffers;
+  adviseSequential: typeof InternalFSBinding.adviseSequential;
   readdir: typeof InternalFSBinding.readdir;
   readlink: typeof InternalFSBinding.readlink;
   realpath: typeof InternalFSBinding.realpath;